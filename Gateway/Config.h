@@ -5,12 +5,31 @@
 #include "String.h"
 
 namespace Exchange::Gateway {
+
+    /**
+     * @enum What the dispatcher does with an order when the sequencer queue is full
+     * SPIN: retry until the timeout, then reject. BLOCK: retry until published, the
+     * ingress queue and then TCP push back on clients; rejects at shutdown, or after
+     * the timeout if one is set. REJECT: reject at once.
+     * A rejected order is answered with a FIX ExecutionReport (OrdStatus=Rejected).
+    **/
+    enum class BackpressurePolicy : uint8_t {
+        SPIN,
+        BLOCK,
+        REJECT,
+    };
+
     class Config : public Core::XMLNode {
         Core::String mPort;
         Core::String mBlockingQueueSize;
         Core::String mMaxFixEventSize;
         Core::String mBacklogSize;
         Core::String mIpcQueueScheduler;
+        uint32_t mTraceSampleEvery{0};
+        BackpressurePolicy mBackpressure{BackpressurePolicy::REJECT};
+        uint64_t mBackpressureTimeoutUs{0};
+        uint32_t mInstanceId{0};
+        uint32_t mExpectedOrders{65536};
 
         Config(const tinyxml2::XMLElement* element):XMLNode(element){
             mPort = getChild("Port").get();
@@ -18,6 +37,32 @@ namespace Exchange::Gateway {
             mMaxFixEventSize = getChild("Fix").getChild("MaxEventSize").get();
             mBacklogSize = getChild("Fix").getChild("BacklogSize").get();
             mIpcQueueScheduler = getChild("Ipc").getChild("SchedulerQueue").get();
+            // Optional, REJECT without it
+            if (getChild("Ipc").mElement->FirstChildElement("Backpressure")) {
+                XMLNode bp = getChild("Ipc").getChild("Backpressure");
+                const std::string policy = bp.getChild("Policy").get().toString();
+                if (policy == "SPIN") mBackpressure = BackpressurePolicy::SPIN;
+                else if (policy == "BLOCK") mBackpressure = BackpressurePolicy::BLOCK;
+                else if (policy == "REJECT") mBackpressure = BackpressurePolicy::REJECT;
+                else ENG_THROW("Invalid <Backpressure> <Policy> '%s' (SPIN, BLOCK or REJECT)", policy.c_str());
+                if (mBackpressure == BackpressurePolicy::SPIN) {
+                    mBackpressureTimeoutUs = std::stoull(bp.getChild("TimeoutUs").get().toString());
+                }
+                else if (mBackpressure == BackpressurePolicy::BLOCK && bp.mElement->FirstChildElement("TimeoutUs")) {
+                    mBackpressureTimeoutUs = std::stoull(bp.getChild("TimeoutUs").get().toString());
+                }
+            }
+            // Optional, instance 0 and the default table size without it
+            if (mElement->FirstChildElement("Orders")) {
+                XMLNode orders = getChild("Orders");
+                mInstanceId = static_cast<uint32_t>(std::stoul(orders.getChild("InstanceId").get().toString()));
+                mExpectedOrders = static_cast<uint32_t>(std::stoul(orders.getChild("ExpectedOrders").get().toString()));
+            }
+            // Optional, tracing is off without it
+            if (mElement->FirstChildElement("LatencyTrace")) {
+                mTraceSampleEvery = static_cast<uint32_t>(
+                    std::stoul(getChild("LatencyTrace").getChild("SampleEvery").get().toString()));
+            }
         }
     public:
         // Delete copy and move constructor to enforce singleton
@@ -45,6 +90,11 @@ namespace Exchange::Gateway {
         size_t maxFixEventSize() const {return std::stoul(mMaxFixEventSize.toString());}
         size_t backlogSize() const {return std::stoul(mBacklogSize.toString());}
         Core::String ipcQueueScheduler() const { return mIpcQueueScheduler; }
+        uint32_t traceSampleEvery() const { return mTraceSampleEvery; }
+        BackpressurePolicy backpressure() const { return mBackpressure; }
+        uint64_t backpressureTimeoutUs() const { return mBackpressureTimeoutUs; }
+        uint32_t instanceId() const { return mInstanceId; }
+        uint32_t expectedOrders() const { return mExpectedOrders; }
 
     private:
         static Config*& getInstance() {
@@ -1,18 +1,38 @@
 #pragma once
 
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
 #include "FIX.h"
 #include "Config.h"
+#include "Orders/ClOrdIdMap.h"
+#include "Orders/OrderIdAllocator.h"
 #include "SharedMemory.h"
+#include "SymbolTable.h"
 #include "messaging.h"
+#include "Metrics/LatencyTracer.h"
+
+#include <sys/socket.h>
 
 namespace Exchange::Gateway {
 
     class FixMessageDispatcher {
     public:
 
-        /** @brief Constructor */
-        FixMessageDispatcher(auto q): 
-            mIngesssQueue(std::move(q)), mSchedulerInjector(Config::instance().ipcQueueScheduler(), 4096) {}
+        /**
+         * @brief Constructor
+         * @param symbols Traded symbols, must outlive the dispatcher
+         */
+        FixMessageDispatcher(auto q, const Ipc::SymbolTable& symbols):
+            mIngesssQueue(std::move(q)), mSymbols(symbols),
+            mSchedulerInjector(Config::instance().ipcQueueScheduler(), 4096),
+            mPolicy(Config::instance().backpressure()),
+            mSpinTimeoutNs(Config::instance().backpressureTimeoutUs() * 1000),
+            mOrderIds(Config::instance().instanceId(), 0),
+            mClOrdIds(Config::instance().expectedOrders()) {}
 
         /**
          * @brief Main consumer loop. Continuously consumes raw packets, 
@@ -21,35 +41,39 @@ namespace Exchange::Gateway {
         void run() {
             LOG_INFO("Fix message dispatcher started");
             while (true) {
+                // Parsed in place; its buffer returns to the listener's pool at the end of the iteration
                 Network::RawPacket packet;
                 // Blocks until data is available or queue is closed
                 if (!mIngesssQueue->pop(packet)) {
                     LOG_INFO("Ingress queue closed and empty, dispatcher exiting");
                     break;
                 }
-                dispatch(packet);
+                dispatch(packet, mTracer.enabled() ? Core::TscClock::now() : 0);
             }
         }
 
-    private:
-        // Queue carrying raw network packets received from client connections.
-        // This dispatcher class consumes packets from it.
-        std::shared_ptr<Core::IBlockingQueue<Network::RawPacket>> mIngesssQueue;
-
-        // IPC producer to events to downstream components scheduler via shared memory.
-        Ipc::Producer mSchedulerInjector;
-
-        void dispatch(const Network::RawPacket& packet) {
-            Network::Fix::FixMsg fix = Network::Fix::parseFix(packet.data.toString());
+        /**
+         * @brief Parses one client packet and forwards the request it carries to the
+         * sequencer. run() calls it for every packet of the ingress queue.
+         * @param poppedNs Time the packet left the ingress queue, 0 when tracing is off.
+         */
+        void dispatch(const Network::RawPacket& packet, uint64_t poppedNs) {
+            Network::Fix::FixMsg fix = Network::Fix::parseFix(packet.view(), &mSymbols);
+            const uint64_t parsedNs = poppedNs ? Core::TscClock::now() : 0;
 
             if (!fix.isValid) {
+                mInvalid.add();
                 LOG_WARN("Invalid or partial FIX message from client %d", packet.clientSocket);
                 return;
             }
 
             // New Order Single
             if (fix.msgType == "D") { 
-                handleNewOrder(packet, fix);
+                handleNewOrder(packet, fix, poppedNs, parsedNs);
+            }
+            // Order Cancel Request / Order Cancel/Replace Request
+            else if (fix.msgType == "F" || fix.msgType == "G") {
+                handleAmend(packet, fix);
             }
             // Logon: message that establishes a FIX session between two counterparties.
             else if (fix.msgType == "A") {
@@ -60,7 +84,155 @@ namespace Exchange::Gateway {
             }
         }
 
-        void handleNewOrder(const Network::RawPacket& packet, const Network::Fix::FixMsg& fix) {
+    private:
+        // Queue carrying raw network packets received from client connections.
+        // This dispatcher class consumes packets from it.
+        std::shared_ptr<Core::IBlockingQueue<Network::RawPacket>> mIngesssQueue;
+
+        // Symbol -> id, resolved once at parse time; only the id is sent downstream
+        const Ipc::SymbolTable& mSymbols;
+
+        // IPC producer to events to downstream components scheduler via shared memory.
+        Ipc::Producer mSchedulerInjector;
+
+        // Latency histograms of the sampled orders, gateway stages
+        Core::LatencyTracer& mTracer{Core::LatencyTracer::instance()};
+
+        // What to do when the sequencer queue is full
+        BackpressurePolicy mPolicy;
+        uint64_t mSpinTimeoutNs;
+        uint64_t mExecId{0};                                ///> ExecID (tag 17) of the reports sent
+
+        // Reused for every message: cleared, never shrunk, so the steady state does not allocate
+        Ipc::Msg::IpcMessage mMessage;
+        std::vector<uint8_t> mEncoded;
+
+        // Exchange order ids of this dispatcher, the only reactor for now (index 0)
+        Orders::OrderIdAllocator mOrderIds;
+        // (session, ClOrdID) -> exchange order id, for cancels and replaces
+        Orders::ClOrdIdMap mClOrdIds;
+        // (session, "") -> client id, dense from 1
+        Orders::ClOrdIdMap mClients{256};
+        uint64_t mNextClientId{1};
+
+        Core::Counter mOrders{"gateway.orders"};            ///> NEW_ORDERs published
+        Core::Counter mRejected{"gateway.rejects"};         ///> NEW_ORDERs rejected, sequencer queue full
+        Core::Counter mInvalid{"gateway.invalid_fix"};
+        Core::Counter mUnknownSymbol{"gateway.unknown_symbol"};    ///> NEW_ORDERs rejected, symbol not traded
+        Core::Counter mDuplicateClOrdId{"gateway.duplicate_clordid"};  ///> NEW_ORDERs / replaces rejected, ClOrdID in use
+        Core::Counter mUnknownOrder{"gateway.unknown_order"};      ///> Cancels / replaces of an unknown OrigClOrdID
+        Core::Gauge mIpcDepth{"gateway.ipc_depth"};         ///> Sequencer queue depth after the last write
+        Core::Gauge mIpcHighWater{"gateway.ipc_high_water"};
+        Core::Gauge mIpcFullEvents{"gateway.ipc_full_events"};
+        Core::Gauge mIpcStallNs{"gateway.ipc_stall_ns"};
+
+        /**
+         * @brief Writes an encoded message to the sequencer queue, applying the
+         * backpressure policy while it is full.
+         * @return false if the message was not published: the order must be rejected.
+         */
+        bool publish(const std::vector<uint8_t>& buf) {
+            const uint32_t size = static_cast<uint32_t>(buf.size());
+            if (mSchedulerInjector.write(buf.data(), size)) {
+                return true;
+            }
+            switch (mPolicy) {
+            case BackpressurePolicy::SPIN: {
+                const uint64_t deadline = Core::TscClock::now() + mSpinTimeoutNs;
+                do {
+#ifdef EXCHANGE_HAS_TSC
+                    _mm_pause();
+#endif
+                    if (mSchedulerInjector.write(buf.data(), size)) {
+                        return true;
+                    }
+                } while (Core::TscClock::now() < deadline);
+                return false;
+            }
+            case BackpressurePolicy::BLOCK: {
+                // Until the sequencer drains, the gateway shuts down (ingress queue closed) or the optional deadline
+                LOG_WARN("Sequencer queue full, dispatcher blocked until it drains");
+                const uint64_t deadline = mSpinTimeoutNs ? Core::TscClock::now() + mSpinTimeoutNs : UINT64_MAX;
+                while (!mSchedulerInjector.write(buf.data(), size)) {
+                    if (mIngesssQueue->isClosed() || Core::TscClock::now() >= deadline) {
+                        LOG_WARN("Sequencer queue still full, order rejected");
+                        return false;
+                    }
+                    std::this_thread::yield();
+                }
+                return true;
+            }
+            case BackpressurePolicy::REJECT:
+                break;
+            }
+            return false;
+        }
+
+        /** @brief Sends a FIX reject for `fix` to the client, never blocks. */
+        void reject(int clientSocket, const Network::Fix::FixMsg& fix, const char* reason) {
+            const std::string report = Network::Fix::buildReject(fix, ++mExecId, reason);
+            if (::send(clientSocket, report.data(), report.size(), MSG_NOSIGNAL | MSG_DONTWAIT) < 0) {
+                LOG_WARN("Cannot send reject to client %d: %s", clientSocket, std::strerror(errno));
+            }
+        }
+
+        /**
+         * @brief Session of the sender: its CompID (tag 49), or the connection for clients
+         * which do not send one. `buf` holds the connection form.
+         */
+        static std::string_view sessionOf(const Network::RawPacket& packet, const Network::Fix::FixMsg& fix,
+                                          char (&buf)[16]) noexcept {
+            if (!fix.senderCompId.empty()) {
+                return fix.senderCompId.view();
+            }
+            buf[0] = '#';
+            const auto [end, ec] = std::to_chars(buf + 1, buf + sizeof(buf), packet.clientSocket);
+            return std::string_view(buf, static_cast<size_t>(end - buf));
+        }
+
+        /** @brief Client id of `session`, assigned on its first order. */
+        uint64_t clientIdOf(std::string_view session) {
+            if (const uint64_t* id = mClients.find(session, {})) {
+                return *id;
+            }
+            mClients.insert(session, {}, mNextClientId);
+            return mNextClientId++;
+        }
+
+        /**
+         * @brief Encodes mMessage and publishes it to the sequencer, rejecting `fix` to
+         * the client if the queue stays full.
+         * @param traced Whether the message carries a FIELD_TRACE
+         * @return true if published.
+         */
+        bool forward(const Network::RawPacket& packet, const Network::Fix::FixMsg& fix, bool traced) {
+            Ipc::Msg::IpcMessage& msg = mMessage;
+            msg.finalize();
+
+            // Encode and publish over shared memory IPC
+            if (traced) {
+                msg.markStage(Ipc::Msg::TraceStage::IPC_PUBLISH);
+            }
+            msg.encode(mEncoded);
+
+            const bool success = publish(mEncoded);
+
+            const Ipc::RingStats ring = mSchedulerInjector.stats();
+            mIpcDepth.set(ring.depth);
+            mIpcHighWater.set(ring.highWater);
+            mIpcFullEvents.set(static_cast<int64_t>(ring.fullEvents));
+            mIpcStallNs.set(static_cast<int64_t>(ring.stallNs));
+            if (!success) {
+                mRejected.add();
+                LOG_WARN("Sequencer queue full (%u/%u), MsgType=%u from client %d rejected",
+                    ring.depth, ring.capacity, msg.header.MsgType, packet.clientSocket);
+                reject(packet.clientSocket, fix, "Exchange busy, order not accepted");
+            }
+            return success;
+        }
+
+        void handleNewOrder(const Network::RawPacket& packet, const Network::Fix::FixMsg& fix,
+                            uint64_t poppedNs, uint64_t parsedNs) {
             LOG_TRACE(
                 "ORDER RECEIVED Client=%d Side=%s Qty=%d Symbol=%s Price=%.2f",
                 packet.clientSocket,
@@ -70,14 +242,34 @@ namespace Exchange::Gateway {
                 fix.price
             );
 
+            if (fix.symbolId == Ipc::SymbolTable::NONE) {
+                mUnknownSymbol.add();
+                LOG_WARN("Unknown symbol '%s' from client %d", fix.symbol.get(), packet.clientSocket);
+                reject(packet.clientSocket, fix, "Unknown symbol");
+                return;
+            }
+
+            char sessionBuf[16];
+            const std::string_view session = sessionOf(packet, fix, sessionBuf);
+            if (!fix.clOrdId.empty() && mClOrdIds.find(session, fix.clOrdId.view())) {
+                mDuplicateClOrdId.add();
+                LOG_WARN("Duplicate ClOrdID '%s' from client %d", fix.clOrdId.get(), packet.clientSocket);
+                reject(packet.clientSocket, fix, "Duplicate ClOrdID");
+                return;
+            }
+            const uint64_t clientId = clientIdOf(session);
+            const uint64_t orderId = mOrderIds.next();
+
             // Build IPC New Order message
-            Ipc::Msg::IpcMessage newOrder;
+            Ipc::Msg::IpcMessage& newOrder = mMessage;
+            newOrder.clear();
             newOrder.setMsgType(Ipc::Msg::MsgType::NEW_ORDER);
+            newOrder.header.timestamp = packet.recvTime;   // Receive time
 
             // Populate fields from FIX message
-            newOrder.addString(
-                static_cast<uint16_t>(Exchange::Ipc::Msg::FieldId::FIELD_SYMBOL),
-                fix.symbol.get()
+            newOrder.addUint64(
+                static_cast<uint16_t>(Exchange::Ipc::Msg::FieldId::FIELD_SYMBOL_ID),
+                fix.symbolId
             );
 
             newOrder.addUint64(
@@ -88,8 +280,13 @@ namespace Exchange::Gateway {
                 )
             );
 
-            // Price converted to integer (e.g., 2 decimal fixed-point)
-            int64_t priceInt = static_cast<int64_t>(fix.price * 10000);
+            newOrder.addUint64(
+                static_cast<uint16_t>(Exchange::Ipc::Msg::FieldId::FIELD_ORD_TYPE),
+                static_cast<uint64_t>(fix.ordType)
+            );
+
+            // Price converted to 4 decimal fixed-point, rounded: 101.23 is 101.2299999... as a double
+            int64_t priceInt = std::llround(fix.price * 10000);
             newOrder.addInt64(
                 static_cast<uint16_t>(Exchange::Ipc::Msg::FieldId::FIELD_PRICE),
                 priceInt
@@ -100,41 +297,97 @@ namespace Exchange::Gateway {
                 fix.quantity
             );
 
-            // Use socket as client identifier (todo: replace with FIX CompID later)
             newOrder.addUint64(
                 static_cast<uint16_t>(Exchange::Ipc::Msg::FieldId::FIELD_CLIENT_ID),
-                static_cast<uint64_t>(packet.clientSocket)
+                clientId
             );
 
-            // todo: Assign a unique order id
-            uint64_t tempOrderId = 1;
             newOrder.addUint64(
                 static_cast<uint16_t>(Exchange::Ipc::Msg::FieldId::FIELD_ORDER_ID),
-                tempOrderId
+                orderId
             );
 
-            // Default Time-In-Force (adjust if FIX tag 59 exists)
+            // Time-In-Force from FIX tag 59 / 18 (DAY when absent)
             newOrder.addUint64(
                 static_cast<uint16_t>(Exchange::Ipc::Msg::FieldId::FIELD_TIF),
-                static_cast<uint64_t>(Exchange::Order::TIF::DAY)
+                static_cast<uint64_t>(fix.tif)
             );
 
-            newOrder.finalize();
+            const bool traced = poppedNs != 0 && mTracer.sample();
+            if (traced) {
+                newOrder.addTrace();
+                newOrder.markStage(Ipc::Msg::TraceStage::NIC_READ, packet.recvTime);
+                newOrder.markStage(Ipc::Msg::TraceStage::DISPATCH, poppedNs);
+                newOrder.markStage(Ipc::Msg::TraceStage::PARSE_DONE, parsedNs);
+            }
 
-            // Encode and publish over shared memory IPC
-            std::vector<uint8_t> buf;
-            newOrder.encode(buf);
+            if (forward(packet, fix, traced)) {
+                mOrders.add();
+                // Orders without a ClOrdID cannot be cancelled or replaced by the client
+                if (!fix.clOrdId.empty()) {
+                    mClOrdIds.insert(session, fix.clOrdId.view(), orderId);
+                }
+                LOG_DEBUG("NEW_ORDER forwarded to IPC (OrderID=%lu)", orderId);
+                if (traced) {
+                    mTracer.record(*newOrder.getTrace(), Ipc::Msg::TraceStage::NIC_READ, Ipc::Msg::TraceStage::IPC_PUBLISH);
+                }
+            }
+        }
 
-            bool success = mSchedulerInjector.write(
-                buf.data(),
-                static_cast<uint32_t>(buf.size())
-            );
+        /**
+         * @brief Order Cancel Request (F) and Order Cancel/Replace Request (G): the order
+         * is found by OrigClOrdID (tag 41) in the session's orders. Once forwarded, a cancel
+         * releases the OrigClOrdID and a replace moves the order to its own ClOrdID.
+         */
+        void handleAmend(const Network::RawPacket& packet, const Network::Fix::FixMsg& fix) {
+            const bool cancel = fix.msgType == "F";
+            if (!cancel && (fix.price <= 0 || fix.quantity <= 0)) {
+                mInvalid.add();
+                LOG_WARN("Replace without price or quantity from client %d", packet.clientSocket);
+                reject(packet.clientSocket, fix, "Missing price or quantity");
+                return;
+            }
+            char sessionBuf[16];
+            const std::string_view session = sessionOf(packet, fix, sessionBuf);
+            const uint64_t* found = mClOrdIds.find(session, fix.origClOrdId.view());
+            if (!found || fix.symbolId == Ipc::SymbolTable::NONE) {
+                mUnknownOrder.add();
+                LOG_WARN("%s of unknown order '%s' from client %d", cancel ? "Cancel" : "Replace",
+                    fix.origClOrdId.get(), packet.clientSocket);
+                reject(packet.clientSocket, fix, "Unknown order");
+                return;
+            }
+            const uint64_t orderId = *found;
+            if (!cancel && !fix.clOrdId.empty() && mClOrdIds.find(session, fix.clOrdId.view())) {
+                mDuplicateClOrdId.add();
+                LOG_WARN("Duplicate ClOrdID '%s' from client %d", fix.clOrdId.get(), packet.clientSocket);
+                reject(packet.clientSocket, fix, "Duplicate ClOrdID");
+                return;
+            }
 
-            if (success) {
-                LOG_DEBUG("NEW_ORDER forwarded to IPC (OrderID=%lu)", tempOrderId);
+            Ipc::Msg::IpcMessage& msg = mMessage;
+            msg.clear();
+            msg.setMsgType(cancel ? Ipc::Msg::MsgType::CANCEL : Ipc::Msg::MsgType::REPLACE);
+            msg.header.timestamp = packet.recvTime;
+            // The engine routes by symbol before it looks the order up
+            msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL_ID), fix.symbolId);
+            msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_CLIENT_ID), clientIdOf(session));
+            msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_ORDER_ID), orderId);
+            if (!cancel) {
+                msg.addInt64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_PRICE),
+                    std::llround(fix.price * 10000));
+                msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_QTY), fix.quantity);
             }
-            else {
-                LOG_ERROR("Failed to publish NEW_ORDER to IPC");
+
+            if (forward(packet, fix, false)) {
+                // The order is now known by its new ClOrdID, or gone: the old one may be reused
+                if (cancel) {
+                    mClOrdIds.erase(session, fix.origClOrdId.view());
+                } else if (!fix.clOrdId.empty()) {
+                    mClOrdIds.erase(session, fix.origClOrdId.view());
+                    mClOrdIds.insert(session, fix.clOrdId.view(), orderId);
+                }
+                LOG_DEBUG("%s forwarded to IPC (OrderID=%lu)", cancel ? "CANCEL" : "REPLACE", orderId);
             }
         }
 
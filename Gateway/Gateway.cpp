@@ -4,6 +4,10 @@
 #include <cstdlib>
 #include <unistd.h>
 
+#include "LoggingConfig.h"
+#include "SymbolsConfig.h"
+#include "ThreadsConfig.h"
+
 
 
 namespace Exchange::Gateway {
@@ -23,6 +27,7 @@ namespace Exchange::Gateway {
 
         sigaction(SIGINT,  &sa, nullptr);
         sigaction(SIGTERM, &sa, nullptr);
+        Core::LatencyTracer::installSignal();
 
         LOG_INFO("Signal handlers registered (Ctrl+C to shutdown)");
     }
@@ -37,22 +42,35 @@ namespace Exchange::Gateway {
     }
 
     void Gateway::start() {
+        Core::TscClock::calibrate();
         LOG_INFO("Launching Gateway...");
         setupSignalHandlers();
 
         // Load configuration
         Core::XMLReader reader("../config.xml");
         Config::init(reader.getNode(mName));
+        Core::LoggingConfig::apply(reader.getNode(mName));
+        Core::MetricsRegistry::init(mName);
+        Core::LatencyTracer::instance().setSampleEvery(Config::instance().traceSampleEvery());
+
+        mSymbols = Ipc::SymbolTable::publish(Ipc::SYMBOL_TABLE_SEGMENT,
+            Core::SymbolsConfig(reader.getNode("Symbols")).symbols());
+        LOG_INFO("Symbol table published, %u symbols", mSymbols.size());
 
-        mScheduler = std::make_unique<GatewayScheduler>(mName);
+        const Core::ThreadsConfig threads(reader.getNode(mName));
+        mScheduler = std::make_unique<GatewayScheduler>(mName,
+            threads.spec("Listener", "gw-listener"), threads.spec("Dispatcher", "gw-dispatcher"));
 
         mIngressQueue =
             std::make_shared<Core::MutexBlockingQueue<Network::RawPacket>>(
                 Config::instance().blockingQueueSize()
             );
+        // Every queued packet, plus the one being read and the one being parsed
+        mPackets = std::make_unique<Network::PacketPool>(
+            static_cast<uint32_t>(Config::instance().blockingQueueSize() + 2));
 
-        mListener   = std::make_unique<Network::TcpEpollListener>(mIngressQueue);
-        mDispatcher = std::make_unique<FixMessageDispatcher>(mIngressQueue);
+        mListener   = std::make_unique<Network::TcpEpollListener>(mIngressQueue, *mPackets);
+        mDispatcher = std::make_unique<FixMessageDispatcher>(mIngressQueue, mSymbols);
 
         LOG_INFO("Starting Gateway Scheduler...");
         mScheduler->start(*mListener, *mDispatcher);
@@ -62,7 +80,10 @@ namespace Exchange::Gateway {
         // Main wait loop
         while (!mShutdownRequested.load(std::memory_order_acquire)) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            Core::LatencyTracer::instance().pollDump();
         }
+        Core::LatencyTracer::instance().dump();
+        mIngressQueue->close();     // Ends the dispatcher, also when blocked on a full sequencer queue
 
         LOG_INFO("Shutdown initiated, exiting in 1 second...");
         std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -29,6 +29,10 @@ namespace Exchange::Gateway {
         std::atomic<bool> mShutdownRequested{false};
 
         std::unique_ptr<GatewayScheduler> mScheduler;
+        // Traded symbols, published read-only in shared memory for the other processes
+        Ipc::SymbolTable mSymbols;
+        // Receive buffers referenced by the queued packets, declared first to outlive the queue
+        std::unique_ptr<Network::PacketPool> mPackets;
         // Thread-safe blocking queue for passing packets between producer and consumer threads
         std::shared_ptr<Core::IBlockingQueue<Network::RawPacket>> mIngressQueue;
         // TCP listener using epoll to accept connections and enqueue raw packets
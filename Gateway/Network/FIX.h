@@ -1,7 +1,12 @@
 #pragma once
 
-#include <sstream>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
 #include "String.h"
+#include "SymbolTable.h"
+#include "enum.h"
 
 namespace Exchange::Gateway::Network {
 
@@ -17,54 +22,156 @@ namespace Exchange::Gateway::Network {
          */
         struct FixMsg {
             Core::String msgType; // Tag 35: Message type (e.g., "D" = New Order Single)
+            Core::String clOrdId; // Tag 11: Client order id, echoed in execution reports
+            Core::String origClOrdId; // Tag 41: ClOrdID of the order a cancel / replace targets
+            Core::String senderCompId; // Tag 49: Client's CompID, identifies the session
             Core::String symbol;  // Tag 55: Financial instrument symbol
+            uint32_t symbolId = Ipc::SymbolTable::NONE; // Tag 55 in the symbol table, NONE if not traded
             Core::String side;    // Tag 54: Order side ("1" = Buy, "2" = Sell)
-            double price;        // Tag 44: Order price
-            int quantity;        // Tag 38: Order quantity
+            double price = 0;    // Tag 44: Order price (absent for market orders)
+            int quantity = 0;    // Tag 38: Order quantity
+            Order::Type ordType = Order::Type::LIMIT; // Tag 40: 1=Market, 2=Limit
+            Order::TIF tif = Order::TIF::DAY; // Tag 59 (+ tag 18 "G" for all-or-none)
             bool isValid;        // Indicates whether the FIX message passed validation
         };
 
         /**
-         * @brief Parses a raw FIX message string into a FixMessage structure.
-         * 
-         * @details 
-         * The message is split using the SOH (0x01) field delimiter and each tag=value
-         * pair is extracted and mapped to known FIX tags. A zero-copy parser would avoid 
-         * string allocations and be faster, but this approach is easier to understand 
-         * and maintain.
-         * @param raw Raw string received from network
-         * @return 
+         * @brief Parses a raw FIX message into a FixMsg, in place.
+         *
+         * @details
+         * The message is walked field by field on the SOH (0x01) delimiter without copying
+         * it: tag and value are views into `raw`. Numbers are read with std::from_chars and
+         * the string fields fit the inline buffer of Core::String, so a typical order is
+         * parsed without any allocation. A malformed price or quantity invalidates the
+         * message.
+         * @param raw Raw message received from network
+         * @param symbols Table resolving tag 55 to FixMsg::symbolId, none leaves it NONE
+         * @return
          */
-        static FixMsg parseFix(const Core::String& raw) {
+        static FixMsg parseFix(std::string_view raw, const Ipc::SymbolTable* symbols = nullptr) {
             LOG_TRACE("Raw Fix: %ls", raw);
 
             FixMsg msg;
             msg.isValid = false;
-            std::stringstream ss(raw.toString());
-            std::string segment;
-            
-            // Split by SOH delimiter 
-            while (std::getline(ss, segment, gFixDelimiter)) {
-                size_t eq_pos = segment.find('=');
-                if (eq_pos == std::string::npos) continue;
+            Order::TIF timeInForce = Order::TIF::DAY;
+            bool allOrNone = false;  // ExecInst (tag 18) contains 'G'
+            bool tifOk = true;
+            bool ordTypeOk = true;
+            bool numbersOk = true;
 
-                std::string tag = segment.substr(0, eq_pos);
-                std::string value = segment.substr(eq_pos + 1);
+            while (!raw.empty()) {
+                const size_t end = raw.find(gFixDelimiter);
+                const std::string_view segment = raw.substr(0, end);
+                raw.remove_prefix(end == std::string_view::npos ? raw.size() : end + 1);
+
+                const size_t eqPos = segment.find('=');
+                if (eqPos == std::string_view::npos) continue;
+
+                const std::string_view tag = segment.substr(0, eqPos);
+                const std::string_view value = segment.substr(eqPos + 1);
 
                 if (tag == "35") msg.msgType = value;
-                else if (tag == "55") msg.symbol = value;
+                else if (tag == "11") msg.clOrdId = value;
+                else if (tag == "41") msg.origClOrdId = value;
+                else if (tag == "49") msg.senderCompId = value;
+                else if (tag == "55") {
+                    msg.symbol = value;
+                    msg.symbolId = symbols ? symbols->find(value) : Ipc::SymbolTable::NONE;
+                }
                 else if (tag == "54") msg.side = value; // 1=Buy, 2=Sell
-                else if (tag == "44") msg.price = std::stod(value);
-                else if (tag == "38") msg.quantity = std::stoi(value);
+                else if (tag == "44") numbersOk &= parseNumber(value, msg.price);
+                else if (tag == "38") numbersOk &= parseNumber(value, msg.quantity);
+                else if (tag == "40") ordTypeOk = parseOrdType(value, msg.ordType);
+                else if (tag == "59") tifOk = parseTimeInForce(value, timeInForce);
+                else if (tag == "18") allOrNone = value.find('G') != std::string_view::npos;
             }
-            
+
+            msg.tif = allOrNone ? (timeInForce | Order::TIF::ALL_OR_NONE) : timeInForce;
+
             // Basic validation
             // todo: Add more validation logic
-            if (!msg.msgType.empty()) {
+            if (!msg.msgType.empty() && tifOk && ordTypeOk && numbersOk) {
                 msg.isValid = true;
             }
 
             return msg;
         }
+
+        /**
+         * @brief Builds the ExecutionReport (35=8) rejecting `order`: ExecType and
+         * OrdStatus 8 (Rejected), OrdRejReason 99 (Other) and `text` in tag 58, with
+         * BodyLength (9) and CheckSum (10) filled in.
+         */
+        static std::string buildReject(const FixMsg& order, uint64_t execId, const char* text) {
+            std::string body;
+            body.reserve(160);
+            auto field = [&body](const char* tag, const std::string& value) {
+                body += tag;
+                body += '=';
+                body += value;
+                body += gFixDelimiter;
+            };
+            field("35", "8");
+            field("37", "NONE");
+            if (!order.clOrdId.empty()) field("11", order.clOrdId.toString());
+            field("17", std::to_string(execId));
+            field("150", "8");
+            field("39", "8");
+            if (!order.symbol.empty()) field("55", order.symbol.toString());
+            if (!order.side.empty()) field("54", order.side.toString());
+            field("38", std::to_string(order.quantity));
+            field("151", "0");
+            field("14", "0");
+            field("6", "0");
+            field("103", "99");
+            field("58", text);
+
+            std::string out = std::string("8=FIX.4.4") + gFixDelimiter + "9=" + std::to_string(body.size()) + gFixDelimiter;
+            out += body;
+            unsigned sum = 0;
+            for (unsigned char c : out) {
+                sum += c;
+            }
+            char checksum[8];
+            std::snprintf(checksum, sizeof(checksum), "%03u", sum % 256);
+            out += "10=";
+            out += checksum;
+            out += gFixDelimiter;
+            return out;
+        }
+
+    private:
+        /** @brief Reads the whole of `value` as a number, false if it is not one. */
+        template <typename T>
+        static bool parseNumber(std::string_view value, T& out) {
+            const char* last = value.data() + value.size();
+            const auto [ptr, ec] = std::from_chars(value.data(), last, out);
+            return ec == std::errc() && ptr == last;
+        }
+
+        /**
+         * @brief Maps FIX OrdType (tag 40): 1=Market, 2=Limit. Stop and other types are not supported.
+         * @return false if the value is not supported.
+         */
+        static bool parseOrdType(std::string_view value, Order::Type& type) {
+            if (value == "1") type = Order::Type::MARKET;
+            else if (value == "2") type = Order::Type::LIMIT;
+            else return false;
+            return true;
+        }
+
+        /**
+         * @brief Maps FIX TimeInForce (tag 59) to the engine flags.
+         * 0=Day, 1=GTC, 3=IOC, 4=FOK. Other values (OPG, GTX, GTD, ...) are not supported.
+         * @return false if the value is not supported.
+         */
+        static bool parseTimeInForce(std::string_view value, Order::TIF& tif) {
+            if (value == "0") tif = Order::TIF::DAY;
+            else if (value == "1") tif = Order::TIF::GOOD_TILL_CANCEL;
+            else if (value == "3") tif = Order::TIF::IMMEDIATE_OR_CANCEL;
+            else if (value == "4") tif = Order::TIF::FILL_OR_KILL;
+            else return false;
+            return true;
+        }
     };
 }
\ No newline at end of file
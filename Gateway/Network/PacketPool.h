@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "Memory/ObjectPool.h"
+
+namespace Exchange::Gateway::Network {
+
+    class PacketPool;
+
+    /**
+     * @struct PacketBuffer
+     * @brief Slab the listener reads a client's bytes into. Shared through PacketRef,
+     * returned to its pool by the last reference.
+     */
+    struct PacketBuffer {
+        static constexpr size_t SIZE = 2048;
+        static constexpr size_t CAPACITY = SIZE - 16;
+
+        std::atomic<uint32_t> refs{1};
+        PacketPool* pool{nullptr};      ///> Owner, nullptr if taken from the heap (pool exhausted)
+        char data[CAPACITY];
+
+        PacketBuffer() noexcept {}      // Not value-initialised: data is filled by read()
+    };
+    static_assert(sizeof(PacketBuffer) == PacketBuffer::SIZE);
+
+    /**
+     * @class PacketRef
+     * @brief Counted reference to a PacketBuffer: copies share the buffer, the last one
+     * to go returns it to the pool. One pointer wide, so a RawPacket moves through the
+     * ingress queue without touching the bytes.
+     */
+    class PacketRef {
+        friend class PacketPool;
+
+        PacketBuffer* mBuffer{nullptr};
+
+        explicit PacketRef(PacketBuffer* buffer) noexcept : mBuffer(buffer) {}
+
+        void reset() noexcept;
+
+    public:
+        PacketRef() = default;
+
+        PacketRef(const PacketRef& other) noexcept : mBuffer(other.mBuffer) {
+            if (mBuffer) {
+                mBuffer->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        PacketRef(PacketRef&& other) noexcept : mBuffer(std::exchange(other.mBuffer, nullptr)) {}
+
+        PacketRef& operator=(PacketRef other) noexcept {
+            std::swap(mBuffer, other.mBuffer);
+            return *this;
+        }
+
+        ~PacketRef() {
+            reset();
+        }
+
+        char* data() noexcept { return mBuffer->data; }
+        const char* data() const noexcept { return mBuffer->data; }
+        static constexpr size_t capacity() noexcept { return PacketBuffer::CAPACITY; }
+
+        /** @brief Whether the buffer comes from the pool rather than the heap. */
+        bool pooled() const noexcept { return mBuffer && mBuffer->pool; }
+        explicit operator bool() const noexcept { return mBuffer != nullptr; }
+    };
+
+    /**
+     * @class PacketPool
+     * @brief Preallocated receive buffers of the gateway. The listener takes one per
+     * read() and the kernel writes into it directly; the dispatcher parses the bytes in
+     * place and its reference hands the buffer back, from its own thread, lock free.
+     *
+     * @details
+     * Sized for every packet the ingress queue can hold plus the ones being read and
+     * parsed, so it is not expected to run dry. If it does, buffers come from the heap
+     * (pooled() is false) rather than stalling the reads of an edge-triggered socket.
+     */
+    class PacketPool {
+        Core::ObjectPool<PacketBuffer> mBuffers;
+
+    public:
+        /** @brief Constructor */
+        explicit PacketPool(uint32_t buffers) : mBuffers(buffers) {}
+
+        PacketPool(const PacketPool&) = delete;
+        PacketPool& operator=(const PacketPool&) = delete;
+
+        /** @brief A buffer with one reference, never empty. */
+        PacketRef acquire() {
+            if (PacketBuffer* b = mBuffers.acquire()) {
+                b->pool = this;
+                return PacketRef(b);
+            }
+            return PacketRef(new PacketBuffer);
+        }
+
+        uint32_t capacity() const noexcept { return mBuffers.capacity(); }
+        uint32_t available() const noexcept { return mBuffers.available(); }
+
+    private:
+        friend class PacketRef;
+
+        void release(PacketBuffer* b) noexcept {
+            mBuffers.release(b);
+        }
+    };
+
+    inline void PacketRef::reset() noexcept {
+        if (mBuffer && mBuffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (mBuffer->pool) {
+                mBuffer->pool->release(mBuffer);
+            }
+            else {
+                delete mBuffer;
+            }
+        }
+        mBuffer = nullptr;
+    }
+
+} // namespace Exchange::Gateway::Network
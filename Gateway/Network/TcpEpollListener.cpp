@@ -39,7 +39,6 @@ namespace Exchange::Gateway::Network {
 
     void TcpEpollListener::eventLoop(std::atomic<bool>* stopFlag) {
         epoll_event events[gCfg().maxFixEventSize()];
-        char buffer[1000];
 
         while (!stopFlag->load(std::memory_order_acquire)) {
             
@@ -48,6 +47,10 @@ namespace Exchange::Gateway::Network {
             if (count <= 0) continue;
 
             for (int i = 0; i < count; ++i) {
+                if (events[i].data.u64 & WATCH_TAG) {
+                    onReadable(static_cast<int>(static_cast<uint32_t>(events[i].data.u64)));
+                    continue;
+                }
                 int fd = events[i].data.fd;
 
                 if (fd == mServerFd) {
@@ -73,20 +76,75 @@ namespace Exchange::Gateway::Network {
     }
 
     void TcpEpollListener::handleRead(int clientFd) {
-        char buffer[1000];
-        int bytesRead = read(clientFd, buffer, sizeof(buffer));
+        // The kernel copies straight into the pooled buffer, which then travels by reference
+        PacketRef buffer = mPackets.acquire();
+        const ssize_t bytesRead = read(clientFd, buffer.data(), buffer.capacity());
+        const uint64_t recvTime = Core::TscClock::now();
 
         if (bytesRead <= 0) {
             close(clientFd);
             epoll_ctl(mEpollFd, EPOLL_CTL_DEL, clientFd, nullptr);
             return;
         }
+        if (!buffer.pooled()) {
+            mPacketPoolMisses.add();
+        }
+
+        mIngesssQueue->push(RawPacket{clientFd, static_cast<uint32_t>(bytesRead), std::move(buffer), recvTime});
+    }
+
+    void TcpEpollListener::watch(int fd, std::coroutine_handle<> h) {
+        std::lock_guard<std::mutex> lock(mWatchMutex);
+        if (mEpollFd < 0) {
+            ENG_THROW("Cannot watch fd %d, the listener is not running", fd);
+        }
+        auto [it, added] = mWatches.try_emplace(fd, Watch{h, Worker::current()});
+        if (!added) {
+            it->second = Watch{h, Worker::current()};
+        }
+
+        // One-shot: the fd is disarmed once reported, and re-armed by the next await
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.u64 = WATCH_TAG | static_cast<uint32_t>(fd);
+        if (epoll_ctl(mEpollFd, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) != 0) {
+            const int err = errno;
+            mWatches.erase(fd);
+            ENG_THROW_ERRNO(err, "epoll_ctl() failed for watched fd %d", fd);
+        }
+    }
 
-        mIngesssQueue->push({clientFd, std::string(buffer, bytesRead)});
+    void TcpEpollListener::onReadable(int fd) {
+        Watch w{};
+        {
+            std::lock_guard<std::mutex> lock(mWatchMutex);
+            const auto it = mWatches.find(fd);
+            if (it == mWatches.end() || !it->second.handle) {
+                return;
+            }
+            w = it->second;
+            it->second.handle = nullptr;
+        }
+        if (w.worker) {
+            w.worker->resume(w.handle);
+        } else {
+            w.handle.resume();
+        }
+    }
+
+    void TcpEpollListener::unwatch(int fd) {
+        std::lock_guard<std::mutex> lock(mWatchMutex);
+        if (mWatches.erase(fd) && mEpollFd >= 0) {
+            epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+        }
     }
 
     void TcpEpollListener::shutdown() {
-        close(mEpollFd);
+        {
+            std::lock_guard<std::mutex> lock(mWatchMutex);
+            close(mEpollFd);
+            mEpollFd = -1;
+        }
         close(mServerFd);
         mIngesssQueue->close();
     }
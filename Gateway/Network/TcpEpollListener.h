@@ -1,6 +1,14 @@
 #pragma once
 
+#include <coroutine>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Clock/TscClock.h"
+#include "Metrics/Metrics.h"
+#include "Scheduler/Coroutine.h"
+#include "PacketPool.h"
 
 // Linux specific headers for networking and threading
 #include <pthread.h>
@@ -18,24 +26,74 @@ namespace Exchange::Gateway::Network {
 
     extern Config& gc;
 
+    /**
+     * @brief Bytes of one read() from a client: a reference to the pooled buffer the
+     * kernel wrote them into, not a copy. Dropping the packet returns the buffer.
+     */
     struct RawPacket {
-        int clientSocket;
-        Core::String data;
+        int clientSocket{-1};
+        uint32_t length{0};
+        PacketRef buffer;
+        uint64_t recvTime{0};   // ns since epoch (TscClock), right after read()
+
+        std::string_view view() const noexcept { return std::string_view(buffer.data(), length); }
     };
 
     class TcpEpollListener {
     public: 
         using BlockingQueue = std::shared_ptr<Core::IBlockingQueue<RawPacket>>;
 
-        /** @brief Constructor */
-        TcpEpollListener(BlockingQueue q):mIngesssQueue(std::move(q)){}
+        /**
+         * @brief Constructor
+         * @param packets Receive buffers, must outlive every packet pushed to `q`
+         */
+        TcpEpollListener(BlockingQueue q, PacketPool& packets):mIngesssQueue(std::move(q)), mPackets(packets){}
 
         void run(std::atomic<bool>* stopFlag);
 
+        /**
+         * @brief Awaiter resuming the coroutine once `fd` is readable, through this
+         * listener's epoll (see readable()).
+         */
+        struct Readable {
+            TcpEpollListener& listener;
+            int fd;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { listener.watch(fd, h); }
+            void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief `co_await listener.readable(fd)` suspends until `fd` is readable. The
+         * coroutine resumes on the worker which awaited (on the listener thread outside
+         * workers, keep it short). One awaiting coroutine per fd.
+         * @throws Engine::EngException If the listener is not running or epoll_ctl() fails.
+         */
+        Readable readable(int fd) { return Readable{*this, fd}; }
+
+        /** @brief Removes `fd` from the epoll set, call it before closing a watched fd. */
+        void unwatch(int fd);
+
     private:
+        // Tags epoll data of watched fds, client sockets only set the fd
+        static constexpr uint64_t WATCH_TAG = 1ULL << 63;
+
+        struct Watch {
+            std::coroutine_handle<> handle;
+            Worker* worker;
+        };
+
         BlockingQueue mIngesssQueue;
+        PacketPool& mPackets;
+        Core::Counter mPacketPoolMisses{"gateway.packet_pool_misses"};   ///> Reads into a heap buffer, pool exhausted
         int mServerFd{-1};
         int mEpollFd{-1};
+        std::mutex mWatchMutex;
+        std::unordered_map<int, Watch> mWatches;   ///> Fds registered by readable(), handle empty once resumed
+
+        void watch(int fd, std::coroutine_handle<> h);
+        void onReadable(int fd);
 
         void setupServer();
         void eventLoop(std::atomic<bool>* stopFlag);
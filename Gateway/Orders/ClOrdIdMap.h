@@ -0,0 +1,145 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "String.h"
+
+namespace Exchange::Gateway::Orders {
+
+    /**
+     * @class ClOrdIdMap
+     * @brief Flat hash map from a client's (session, key) pair to a 64-bit value: the
+     * session is the FIX SenderCompID (tag 49), the key a ClOrdID (tag 11) and the value
+     * the exchange order id. The dispatcher also keys its client ids by session with an
+     * empty key.
+     *
+     * @details
+     * Open addressing with linear probing over one array of slots: a lookup hashes the
+     * pair once and usually reads a single cache line. Keys are Core::String, inline up
+     * to 23 characters, so typical CompIDs and ClOrdIDs cost no allocation. erase() shifts
+     * the following entries of the probe run back (no tombstones), so a table which only
+     * sees orders come and go never rebuilds; it doubles when 3/4 full.
+     * Not thread safe: each reactor owns its map.
+     */
+    class ClOrdIdMap {
+        static constexpr uint64_t EMPTY = 0;
+
+        struct Slot {
+            uint64_t hash{EMPTY};       ///> EMPTY or the hash of the pair (never 0)
+            uint64_t value{0};
+            Core::String session;
+            Core::String key;
+        };
+
+        std::vector<Slot> mSlots;
+        size_t mMask;
+        size_t mSize{0};
+
+        static uint64_t hash(std::string_view session, std::string_view key) noexcept {
+            uint64_t h = 1469598103934665603ULL;
+            for (char c : session) {
+                h = (h ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+            }
+            h = (h ^ 0x01) * 1099511628211ULL;     // SOH never occurs in a FIX value
+            for (char c : key) {
+                h = (h ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+            }
+            h ^= h >> 29;
+            return h == EMPTY ? 1 : h;
+        }
+
+        /** @brief Slot holding the pair, or nullptr. */
+        const Slot* lookup(uint64_t h, std::string_view session, std::string_view key) const noexcept {
+            for (size_t i = h & mMask; ; i = (i + 1) & mMask) {
+                const Slot& s = mSlots[i];
+                if (s.hash == EMPTY) {
+                    return nullptr;
+                }
+                if (s.hash == h && s.key.view() == key && s.session.view() == session) {
+                    return &s;
+                }
+            }
+        }
+
+        void rehash(size_t slots) {
+            std::vector<Slot> old(slots);
+            old.swap(mSlots);
+            mMask = slots - 1;
+            for (Slot& s : old) {
+                if (s.hash == EMPTY) {
+                    continue;
+                }
+                size_t i = s.hash & mMask;
+                while (mSlots[i].hash != EMPTY) {
+                    i = (i + 1) & mMask;
+                }
+                mSlots[i] = std::move(s);
+            }
+        }
+
+    public:
+        /** @brief Constructor, room for `expected` pairs before the first rehash. */
+        explicit ClOrdIdMap(size_t expected = 1024) {
+            const size_t slots = std::bit_ceil(expected + expected / 3 + 1);
+            mSlots.resize(slots);
+            mMask = slots - 1;
+        }
+
+        /** @return The value of the pair, nullptr if absent. Valid until the next insert(). */
+        const uint64_t* find(std::string_view session, std::string_view key) const noexcept {
+            const Slot* s = lookup(hash(session, key), session, key);
+            return s ? &s->value : nullptr;
+        }
+
+        /** @return false, and the map unchanged, if the pair is already present. */
+        bool insert(std::string_view session, std::string_view key, uint64_t value) {
+            const uint64_t h = hash(session, key);
+            if (lookup(h, session, key)) {
+                return false;
+            }
+            if ((mSize + 1) * 4 > mSlots.size() * 3) {
+                rehash(mSlots.size() * 2);
+            }
+            size_t i = h & mMask;
+            while (mSlots[i].hash != EMPTY) {
+                i = (i + 1) & mMask;
+            }
+            Slot& s = mSlots[i];
+            s.hash = h;
+            s.value = value;
+            s.session = session;
+            s.key = key;
+            ++mSize;
+            return true;
+        }
+
+        /** @return false if the pair was absent. */
+        bool erase(std::string_view session, std::string_view key) noexcept {
+            const Slot* s = lookup(hash(session, key), session, key);
+            if (!s) {
+                return false;
+            }
+            // Backward shift: move up every entry of the run whose home is not in (hole, j]
+            size_t hole = static_cast<size_t>(s - mSlots.data());
+            for (size_t j = (hole + 1) & mMask; mSlots[j].hash != EMPTY; j = (j + 1) & mMask) {
+                const size_t home = mSlots[j].hash & mMask;
+                if (((j - home) & mMask) >= ((j - hole) & mMask)) {
+                    std::swap(mSlots[hole], mSlots[j]);
+                    hole = j;
+                }
+            }
+            mSlots[hole].hash = EMPTY;
+            --mSize;
+            return true;
+        }
+
+        size_t size() const noexcept { return mSize; }
+        bool empty() const noexcept { return mSize == 0; }
+    };
+
+} // namespace Exchange::Gateway::Orders
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+#include "Exception.h"
+
+namespace Exchange::Gateway::Orders {
+
+    /**
+     * @class OrderIdAllocator
+     * @brief Exchange order ids of one reactor (one dispatcher thread). Unique across
+     * gateway instances, reactors and restarts without any shared state.
+     *
+     * @details
+     * @code
+     *   63      56 55                36 35    32 31                         0
+     *  [ instance ][       epoch       ][reactor][          counter          ]
+     * @endcode
+     * The instance comes from the configuration, the reactor is the index of the owning
+     * thread and the epoch is the start time in seconds (modulo 2^20, about 12 days). The
+     * counter starts at the millisecond of that second times 2^22, so a gateway restarted
+     * within the same second numbers above its previous run, which would have needed more
+     * than 4 million ids per millisecond to get there. next() is a local increment; when
+     * the counter wraps the epoch moves on by one. Ids are never 0.
+     */
+    class OrderIdAllocator {
+    public:
+        static constexpr unsigned COUNTER_BITS = 32;
+        static constexpr unsigned REACTOR_BITS = 4;
+        static constexpr unsigned EPOCH_BITS = 20;
+        static constexpr unsigned INSTANCE_BITS = 8;
+        static_assert(COUNTER_BITS + REACTOR_BITS + EPOCH_BITS + INSTANCE_BITS == 64);
+
+        static constexpr uint32_t MAX_INSTANCE = (1u << INSTANCE_BITS) - 1;
+        static constexpr uint32_t MAX_REACTOR = (1u << REACTOR_BITS) - 1;
+        static constexpr uint32_t EPOCH_MASK = (1u << EPOCH_BITS) - 1;
+        static constexpr unsigned MS_SHIFT = 22;        ///> 999 << 22 < 2^32
+
+    private:
+        uint64_t mPrefix;           ///> Instance and reactor bits
+        uint32_t mEpoch;
+        uint32_t mCounter{0};       ///> Last issued
+
+    public:
+        /**
+         * @brief Constructor, numbering from the current time (see above).
+         * @throws EngException If `instance` or `reactor` does not fit its bits.
+         */
+        OrderIdAllocator(uint32_t instance, uint32_t reactor)
+            : OrderIdAllocator(instance, reactor, realtime()) {}
+
+        /**
+         * @brief Constructor
+         * @param counter Last counter issued under `epoch`, numbering resumes after it
+         * @throws EngException If `instance` or `reactor` does not fit its bits.
+         */
+        OrderIdAllocator(uint32_t instance, uint32_t reactor, uint32_t epoch, uint32_t counter = 0)
+            : mEpoch(epoch & EPOCH_MASK), mCounter(counter) {
+            if (instance > MAX_INSTANCE) {
+                ENG_THROW("Gateway instance id %u out of range [0, %u]", instance, MAX_INSTANCE);
+            }
+            if (reactor > MAX_REACTOR) {
+                ENG_THROW("Reactor index %u out of range [0, %u]", reactor, MAX_REACTOR);
+            }
+            mPrefix = (static_cast<uint64_t>(instance) << (64 - INSTANCE_BITS))
+                    | (static_cast<uint64_t>(reactor) << COUNTER_BITS);
+        }
+
+        uint64_t next() noexcept {
+            if (++mCounter == 0) {
+                mCounter = 1;
+                mEpoch = (mEpoch + 1) & EPOCH_MASK;
+            }
+            return mPrefix | (static_cast<uint64_t>(mEpoch) << (COUNTER_BITS + REACTOR_BITS)) | mCounter;
+        }
+
+        static uint32_t instanceOf(uint64_t id) noexcept { return static_cast<uint32_t>(id >> (64 - INSTANCE_BITS)); }
+        static uint32_t epochOf(uint64_t id) noexcept {
+            return static_cast<uint32_t>(id >> (COUNTER_BITS + REACTOR_BITS)) & EPOCH_MASK;
+        }
+        static uint32_t reactorOf(uint64_t id) noexcept {
+            return static_cast<uint32_t>(id >> COUNTER_BITS) & MAX_REACTOR;
+        }
+        static uint32_t counterOf(uint64_t id) noexcept { return static_cast<uint32_t>(id); }
+
+    private:
+        OrderIdAllocator(uint32_t instance, uint32_t reactor, const timespec& now)
+            : OrderIdAllocator(instance, reactor, static_cast<uint32_t>(now.tv_sec),
+                               static_cast<uint32_t>(now.tv_nsec / 1000000) << MS_SHIFT) {}
+
+        static timespec realtime() noexcept {
+            timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            return ts;
+        }
+    };
+
+} // namespace Exchange::Gateway::Orders
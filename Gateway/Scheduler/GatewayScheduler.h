@@ -16,6 +16,7 @@ namespace Exchange::Gateway {
         Core::String mWorkerPrefix;
         size_t mWorkerCnt;
         std::map<Threads, std::string> mThreads;
+        std::map<Threads, WorkerHandle> mHandles;
         std::shared_ptr<std::atomic<bool>> mStopNetwork;
 
     public:
@@ -30,8 +31,11 @@ namespace Exchange::Gateway {
          * 
          * @param prefix Base name prefix for the worker threads (e.g., "gateway").
          *               Thread names will be formed as "{prefix}_listener" and "{prefix}_dispatcher".
+         * @param listener   Placement of the listener thread (<Threads><Listener>).
+         * @param dispatcher Placement of the dispatcher thread (<Threads><Dispatcher>).
          */
-        GatewayScheduler(const Core::String prefix) : mWorkerPrefix(std::move(prefix)),
+        GatewayScheduler(const Core::String prefix, const WorkerSpec& listener = {}, const WorkerSpec& dispatcher = {})
+            : mWorkerPrefix(std::move(prefix)),
             mStopNetwork(std::make_shared<std::atomic<bool>>(false))
         {
             // Register human-readable names for the two main worker threads
@@ -39,8 +43,8 @@ namespace Exchange::Gateway {
             mThreads.insert({Threads::Dispatcher, (mWorkerPrefix + "_dispatcher").toString()});
 
             // Spawn the listener and dispatcher workers
-            createWorker(mThreads[Threads::Listener]);
-            createWorker(mThreads[Threads::Dispatcher]);
+            mHandles[Threads::Listener] = createWorker(mThreads[Threads::Listener], listener);
+            mHandles[Threads::Dispatcher] = createWorker(mThreads[Threads::Dispatcher], dispatcher);
         }
 
         /**
@@ -60,7 +64,7 @@ namespace Exchange::Gateway {
             
             // Offload the blocking Epoll loop to a specific thread designated for network I/O.
             submitTo(
-                mThreads[Threads::Listener], 
+                mHandles[Threads::Listener], 
                 [stopNet, &listener](const CancelToken& token) {
                     // listener.run() is an event loop that blocks until stopNet signals an exit.
                     listener.run(stopNet.get());
@@ -71,7 +75,7 @@ namespace Exchange::Gateway {
             // Offload the FIX message processing loop to a separate thread.
             // This separates "receiving bytes" from "processing business logic" (decoupling).
             submitTo(
-                mThreads[Threads::Dispatcher], 
+                mHandles[Threads::Dispatcher], 
                 [&dispatcher](const CancelToken& token) {
                     // dispatcher.run() processes the incoming FIX message queue and forwards
                     // them to the matching engine/sequencer.
@@ -87,7 +91,8 @@ namespace Exchange::Gateway {
             LOG_INFO("Initiating Gateway shutdown...");
             mStopNetwork->store(true, std::memory_order_release);
             LOG_INFO("Network stop signal sent, waiting for clean shutdown...");
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+            // Joins the workers: the listener leaves its loop within one epoll_wait()
+            // timeout and closes the ingress queue, which ends the dispatcher loop
             Scheduler::shutdown();
             LOG_INFO("Gateway shutdown complete");
         }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "enum.h"
+
+namespace Exchange::Matching {
+
+    /**
+     * @enum ExecType
+     * @brief Kind of report emitted by a book in response to a request.
+     */
+    enum class ExecType : uint8_t {
+        ACCEPTED,   // Order entered the engine (may trade and/or rest afterwards)
+        TRADE,      // Aggressor traded against a resting order
+        CANCELLED,  // Remaining quantity removed from the book (or IOC/FOK remainder)
+        REPLACED,   // Price/qty of a resting order amended
+        EXPIRED,    // Non GTC order removed at end of day
+        REJECTED    // Request refused, see RejectReason
+    };
+
+    /**
+     * @enum RejectReason
+     * @brief Why a request was refused, or why an order was cancelled by the engine itself.
+     */
+    enum class RejectReason : uint8_t {
+        NONE,
+        UNKNOWN_SYMBOL,
+        UNKNOWN_ORDER,      // Cancel/replace for an order id which is not resting
+        DUPLICATE_ORDER_ID, // (clientId, orderId) already resting
+        INVALID_QTY,
+        BOOK_FULL,          // Order pool exhausted
+        PROTECTION_BAND     // Set on CANCELLED: sweep stopped after the maximum number of levels
+    };
+
+    /**
+     * @struct Execution
+     * @brief One report produced by the engine.
+     *
+     * @details
+     * For TRADE the (clientId, orderId) pair is the aggressor and (contraClientId,
+     * contraOrderId) the resting order which was hit; `leavesQty` is the aggressor's
+     * remaining quantity and `contraLeavesQty` the resting order's.
+     */
+    struct Execution {
+        ExecType type{};
+        RejectReason reason{RejectReason::NONE};
+        Order::Side side{};
+        uint64_t seqNo = 0;
+        uint64_t clientId = 0;
+        uint64_t orderId = 0;
+        int64_t price = 0;
+        uint64_t qty = 0;
+        uint64_t leavesQty = 0;
+        uint64_t contraClientId = 0;
+        uint64_t contraOrderId = 0;
+        uint64_t contraLeavesQty = 0;
+    };
+
+    // Reused across requests: the caller clears it (capacity is kept) so steady state
+    // emission does not allocate.
+    using Executions = std::vector<Execution>;
+
+} // namespace Exchange::Matching
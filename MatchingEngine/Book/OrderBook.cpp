@@ -0,0 +1,366 @@
+#include "OrderBook.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Exchange::Matching {
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    static Order::Side opposite(Order::Side side) noexcept {
+        return side == Order::Side::BUY ? Order::Side::SELL : Order::Side::BUY;
+    }
+
+    static bool isAon(Order::TIF tif) noexcept {
+        return Order::hasFlag(tif, Order::TIF::ALL_OR_NONE);
+    }
+
+    static bool isIoc(Order::TIF tif) noexcept {
+        return Order::hasFlag(tif, Order::TIF::IMMEDIATE_OR_CANCEL);
+    }
+
+    static bool crosses(Order::Side side, int64_t price, int64_t levelPrice) noexcept {
+        return side == Order::Side::BUY ? price >= levelPrice : price <= levelPrice;
+    }
+
+    OrderBook::OrderBook(uint32_t id, std::string symbol, BookContext& ctx)
+        : mId(id), mSymbol(std::move(symbol)), mCtx(ctx) {}
+
+    void OrderBook::newOrder(const OrderRequest& req, Executions& out) {
+        out.push_back(Execution{
+            .type = ExecType::ACCEPTED, .reason = RejectReason::NONE, .side = req.side,
+            .seqNo = req.seqNo, .clientId = req.clientId, .orderId = req.orderId,
+            .price = req.price, .qty = req.qty, .leavesQty = req.qty
+        });
+
+        const int64_t limit = limitOf(req);
+        uint64_t remaining = req.qty;
+        bool capped = false;
+
+        // AON/FOK: decide on aggregated level quantities before touching any order
+        bool fillable = !isAon(req.tif) || available(req.side, limit, req.qty) >= req.qty;
+        if (fillable) {
+            remaining = match(req.side, limit, req.qty, req.seqNo, req.clientId, req.orderId, out, capped);
+            if (remaining == 0) {
+                return;
+            }
+        }
+
+        // Market orders never rest, and a limit order stopped by the band would still
+        // cross the opposite side
+        if (capped || isIoc(req.tif) || req.type == Order::Type::MARKET) {
+            out.push_back(Execution{
+                .type = ExecType::CANCELLED,
+                .reason = capped ? RejectReason::PROTECTION_BAND : RejectReason::NONE,
+                .side = req.side, .seqNo = req.seqNo, .clientId = req.clientId, .orderId = req.orderId,
+                .price = req.price, .qty = remaining, .leavesQty = 0
+            });
+            return;
+        }
+
+        Handle h = mCtx.orders.acquire();
+        RestingOrder& o = mCtx.orders[h];
+        o.orderId = req.orderId;
+        o.clientId = req.clientId;
+        o.seqNo = req.seqNo;
+        o.price = req.price;
+        o.qty = remaining;
+        o.book = mId;
+        o.side = req.side;
+        o.tif = req.tif;
+        mCtx.index.insert(req.clientId, req.orderId, h);
+        link(h);
+    }
+
+    void OrderBook::cancel(Handle h, uint64_t seqNo, Executions& out) {
+        const RestingOrder& o = mCtx.orders[h];
+        out.push_back(Execution{
+            .type = ExecType::CANCELLED, .reason = RejectReason::NONE, .side = o.side,
+            .seqNo = seqNo, .clientId = o.clientId, .orderId = o.orderId,
+            .price = o.price, .qty = o.qty, .leavesQty = 0
+        });
+        unlink(h);
+        retire(h);
+    }
+
+    void OrderBook::replace(Handle h, int64_t newPrice, uint64_t newQty, uint64_t seqNo, Executions& out) {
+        RestingOrder& o = mCtx.orders[h];
+
+        // Quantity down at the same price: amend in place, priority is kept
+        if (newPrice == o.price && newQty <= o.qty) {
+            PriceLevel& lvl = mCtx.levels[o.level];
+            lvl.totalQty -= (o.qty - newQty);
+            if (isAon(o.tif)) {
+                lvl.aonQty -= (o.qty - newQty);
+            }
+            o.qty = newQty;
+            out.push_back(Execution{
+                .type = ExecType::REPLACED, .reason = RejectReason::NONE, .side = o.side,
+                .seqNo = seqNo, .clientId = o.clientId, .orderId = o.orderId,
+                .price = o.price, .qty = newQty, .leavesQty = newQty
+            });
+            return;
+        }
+
+        // Anything else loses priority. The slot and its index entry are kept, only the
+        // level membership changes.
+        unlink(h);
+        o.price = newPrice;
+        o.seqNo = seqNo;
+        out.push_back(Execution{
+            .type = ExecType::REPLACED, .reason = RejectReason::NONE, .side = o.side,
+            .seqNo = seqNo, .clientId = o.clientId, .orderId = o.orderId,
+            .price = newPrice, .qty = newQty, .leavesQty = newQty
+        });
+
+        uint64_t remaining = newQty;
+        bool capped = false;
+        if (!isAon(o.tif) || available(o.side, newPrice, newQty) >= newQty) {
+            remaining = match(o.side, newPrice, newQty, seqNo, o.clientId, o.orderId, out, capped);
+        }
+        if (remaining == 0) {
+            retire(h);
+            return;
+        }
+        if (capped) {
+            out.push_back(Execution{
+                .type = ExecType::CANCELLED, .reason = RejectReason::PROTECTION_BAND, .side = o.side,
+                .seqNo = seqNo, .clientId = o.clientId, .orderId = o.orderId,
+                .price = newPrice, .qty = remaining, .leavesQty = 0
+            });
+            retire(h);
+            return;
+        }
+        o.qty = remaining;
+        link(h);
+    }
+
+    void OrderBook::endOfDay(uint64_t seqNo, Executions& out) {
+        // Once a day: collect first, unlinking while walking would invalidate the walk
+        std::vector<Handle> expiring;
+        for (const auto* levels : {&mBids, &mAsks}) {
+            for (Handle lh : *levels) {
+                for (Handle h = mCtx.levels[lh].head; h != NULL_HANDLE; h = mCtx.orders[h].next) {
+                    if (!Order::hasFlag(mCtx.orders[h].tif, Order::TIF::GOOD_TILL_CANCEL)) {
+                        expiring.push_back(h);
+                    }
+                }
+            }
+        }
+
+        for (Handle h : expiring) {
+            const RestingOrder& o = mCtx.orders[h];
+            out.push_back(Execution{
+                .type = ExecType::EXPIRED, .reason = RejectReason::NONE, .side = o.side,
+                .seqNo = seqNo, .clientId = o.clientId, .orderId = o.orderId,
+                .price = o.price, .qty = o.qty, .leavesQty = 0
+            });
+            unlink(h);
+            retire(h);
+        }
+    }
+
+    uint64_t OrderBook::levelQty(Order::Side side, int64_t price) const noexcept {
+        const auto& levels = sideOf(side);
+        size_t pos = findLevel(levels, side, price);
+        return pos == npos ? 0 : mCtx.levels[levels[pos]].totalQty;
+    }
+
+    uint64_t OrderBook::available(Order::Side side, int64_t price, uint64_t wanted) const noexcept {
+        const auto& contra = sideOf(opposite(side));
+        const size_t band = mCtx.maxSweepLevels;
+        const size_t last = (band == 0 || band >= contra.size()) ? 0 : contra.size() - band;
+        uint64_t total = 0;
+        for (size_t i = contra.size(); i > last && total < wanted; --i) {
+            const PriceLevel& lvl = mCtx.levels[contra[i - 1]];
+            if (!crosses(side, price, lvl.price)) {
+                break;
+            }
+            total += lvl.totalQty - lvl.aonQty;
+        }
+        return total;
+    }
+
+    uint64_t OrderBook::match(Order::Side side, int64_t price, uint64_t qty, uint64_t seqNo,
+                              uint64_t clientId, uint64_t orderId, Executions& out, bool& capped) {
+        auto& contra = sideOf(opposite(side));
+        const uint32_t band = mCtx.maxSweepLevels;
+        uint32_t walked = 0;
+        capped = false;
+
+        // Trades of the whole sweep are appended to `out` and published in one batch by
+        // the caller, nothing is emitted level by level.
+
+        // Walk contiguous levels from the best one. Index based because a level made only
+        // of AON orders which are too large is passed over and stays in place.
+        size_t i = contra.size();
+        while (qty > 0 && i > 0) {
+            Handle lh = contra[i - 1];
+            PriceLevel& lvl = mCtx.levels[lh];
+
+            if (!crosses(side, price, lvl.price)) {
+                break;
+            }
+            if (band != 0 && walked == band) {
+                capped = true;
+                break;
+            }
+            ++walked;
+
+            // Walk the level in time priority
+            Handle rh = lvl.head;
+            while (qty > 0 && rh != NULL_HANDLE) {
+                RestingOrder& r = mCtx.orders[rh];
+                Handle next = r.next;
+                bool aon = isAon(r.tif);
+
+                if (aon && qty < r.qty) {
+                    // Cannot take all of it, next order keeps its chance
+                    rh = next;
+                    continue;
+                }
+
+                uint64_t fill = std::min(qty, r.qty);
+                qty -= fill;
+                r.qty -= fill;
+                lvl.totalQty -= fill;
+                if (aon) {
+                    lvl.aonQty -= fill;
+                }
+
+                out.push_back(Execution{
+                    .type = ExecType::TRADE, .reason = RejectReason::NONE, .side = side,
+                    .seqNo = seqNo, .clientId = clientId, .orderId = orderId,
+                    .price = lvl.price, .qty = fill, .leavesQty = qty,
+                    .contraClientId = r.clientId, .contraOrderId = r.orderId, .contraLeavesQty = r.qty
+                });
+
+                if (r.qty == 0) {
+                    detach(lvl, r);
+                    retire(rh);
+                }
+                rh = next;
+            }
+
+            if (lvl.count == 0) {
+                contra.erase(contra.begin() + static_cast<std::ptrdiff_t>(i - 1));
+                mCtx.levels.release(lh);
+            }
+            --i;
+        }
+        return qty;
+    }
+
+    int64_t OrderBook::limitOf(const OrderRequest& req) noexcept {
+        if (req.type != Order::Type::MARKET) {
+            return req.price;
+        }
+        return req.side == Order::Side::BUY ? std::numeric_limits<int64_t>::max()
+                                            : std::numeric_limits<int64_t>::min();
+    }
+
+    void OrderBook::link(Handle h) {
+        RestingOrder& o = mCtx.orders[h];
+        auto& levels = sideOf(o.side);
+
+        // First level that is not worse than the order's price
+        auto it = std::lower_bound(levels.begin(), levels.end(), o.price,
+            [this, side = o.side](Handle lh, int64_t price) {
+                return better(side, price, mCtx.levels[lh].price);
+            });
+
+        Handle lh;
+        if (it != levels.end() && mCtx.levels[*it].price == o.price) {
+            lh = *it;
+        }
+        else {
+            lh = mCtx.levels.acquire();
+            PriceLevel& fresh = mCtx.levels[lh];
+            fresh.price = o.price;
+            fresh.totalQty = 0;
+            fresh.aonQty = 0;
+            fresh.count = 0;
+            fresh.head = NULL_HANDLE;
+            fresh.tail = NULL_HANDLE;
+            levels.insert(it, lh);
+        }
+
+        PriceLevel& lvl = mCtx.levels[lh];
+        o.level = lh;
+        o.prev = lvl.tail;
+        o.next = NULL_HANDLE;
+        if (lvl.tail != NULL_HANDLE) {
+            mCtx.orders[lvl.tail].next = h;
+        }
+        else {
+            lvl.head = h;
+        }
+        lvl.tail = h;
+        lvl.totalQty += o.qty;
+        if (isAon(o.tif)) {
+            lvl.aonQty += o.qty;
+        }
+        ++lvl.count;
+    }
+
+    void OrderBook::detach(PriceLevel& lvl, RestingOrder& o) noexcept {
+        if (o.prev != NULL_HANDLE) {
+            mCtx.orders[o.prev].next = o.next;
+        }
+        else {
+            lvl.head = o.next;
+        }
+        if (o.next != NULL_HANDLE) {
+            mCtx.orders[o.next].prev = o.prev;
+        }
+        else {
+            lvl.tail = o.prev;
+        }
+        o.prev = o.next = o.level = NULL_HANDLE;
+        --lvl.count;
+    }
+
+    void OrderBook::unlink(Handle h) {
+        RestingOrder& o = mCtx.orders[h];
+        Handle lh = o.level;
+        PriceLevel& lvl = mCtx.levels[lh];
+
+        detach(lvl, o);
+        lvl.totalQty -= o.qty;
+        if (isAon(o.tif)) {
+            lvl.aonQty -= o.qty;
+        }
+        if (lvl.count > 0) {
+            return;
+        }
+
+        // Level is empty, drop it. The best level is the common case (pop_back).
+        auto& levels = sideOf(o.side);
+        if (levels.back() == lh) {
+            levels.pop_back();
+        }
+        else {
+            size_t pos = findLevel(levels, o.side, lvl.price);
+            levels.erase(levels.begin() + static_cast<std::ptrdiff_t>(pos));
+        }
+        mCtx.levels.release(lh);
+    }
+
+    void OrderBook::retire(Handle h) {
+        const RestingOrder& o = mCtx.orders[h];
+        mCtx.index.erase(o.clientId, o.orderId);
+        mCtx.orders.release(h);
+    }
+
+    size_t OrderBook::findLevel(const std::vector<Handle>& levels, Order::Side side, int64_t price) const noexcept {
+        auto it = std::lower_bound(levels.begin(), levels.end(), price,
+            [this, side](Handle lh, int64_t p) {
+                return better(side, p, mCtx.levels[lh].price);
+            });
+        if (it == levels.end() || mCtx.levels[*it].price != price) {
+            return npos;
+        }
+        return static_cast<size_t>(it - levels.begin());
+    }
+
+} // namespace Exchange::Matching
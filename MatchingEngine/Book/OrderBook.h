@@ -0,0 +1,193 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "RestingOrder.h"
+#include "SlotPool.h"
+#include "OrderIndex.h"
+#include "Execution.h"
+
+namespace Exchange::Matching {
+
+    class Snapshot;
+
+    /**
+     * @struct BookContext
+     * @brief Storage shared by all books of one engine.
+     *
+     * @details
+     * Cancel/replace requests only carry (clientId, orderId), not the symbol, so the
+     * index has to span every book. Orders and levels are pooled here for the same
+     * reason: a single handle space lets the index resolve straight to the slot and the
+     * slot tells which book it belongs to.
+     * The level pool has the same capacity as the order pool because every level in use
+     * holds at least one order, so acquiring a level can never fail on its own.
+     */
+    struct BookContext {
+        SlotPool<RestingOrder> orders;
+        SlotPool<PriceLevel> levels;
+        OrderIndex index;
+        uint32_t maxSweepLevels;    ///> Protection band: price levels one aggressor may walk, 0 = unbounded
+
+        /** @brief Constructor */
+        explicit BookContext(uint32_t maxOrders, uint32_t sweepLevels = 0)
+            : orders(maxOrders), levels(maxOrders), index(maxOrders), maxSweepLevels(sweepLevels) {}
+    };
+
+    /**
+     * @struct OrderRequest
+     * @brief Decoded new order as handed to a book.
+     */
+    struct OrderRequest {
+        uint64_t seqNo;
+        uint64_t clientId;
+        uint64_t orderId;
+        Order::Side side;
+        Order::TIF tif;
+        int64_t price;          // Ignored for market orders
+        uint64_t qty;
+        Order::Type type = Order::Type::LIMIT;
+    };
+
+    /**
+     * @class OrderBook
+     * @brief Price-time priority limit order book for a single symbol.
+     *
+     * @details
+     * Each side is a vector of level handles sorted so that the best price is at the
+     * back: bids ascending, asks descending. Matching therefore works from the back, and
+     * new levels are usually inserted close to the back as most flow arrives near the touch.
+     *
+     * Time in force (Order::TIF bit flags):
+     * - DAY: rests until cancelled or expired by endOfDay().
+     * - GTC: like DAY but survives endOfDay().
+     * - IOC: trades what it can, the remainder is cancelled instead of resting.
+     * - AON: only executes for its full quantity. Before matching, the quantity which can
+     *   be taken partially on the crossing levels (PriceLevel::totalQty - aonQty) is
+     *   added up level by level; if it is not enough nothing is matched, so there is
+     *   never a rollback. A resting AON order is skipped by incoming orders too small to
+     *   take all of it.
+     * - FOK (= AON | IOC): same check as AON, killed instead of resting when it fails.
+     *
+     * Market orders sweep the opposite side from the best level with no price limit and
+     * their remainder is always cancelled. Any aggressor (market or limit) walks at most
+     * BookContext::maxSweepLevels contiguous levels; what is left when the band is reached
+     * is cancelled with RejectReason::PROTECTION_BAND rather than resting through the
+     * opposite side. This bounds the work, and so the latency, of a single request when a
+     * large order hits a thin book.
+     */
+    class OrderBook {
+        friend class Snapshot;   // Raw (de)serialization of the state
+
+        uint32_t mId;                 ///> Index of this book inside the engine
+        std::string mSymbol;          ///> Instrument traded on this book
+        BookContext& mCtx;            ///> Shared pools/index
+        std::vector<Handle> mBids;    ///> Bid levels, best (highest) at back
+        std::vector<Handle> mAsks;    ///> Ask levels, best (lowest) at back
+
+    public:
+        /** @brief Constructor */
+        OrderBook(uint32_t id, std::string symbol, BookContext& ctx);
+
+        OrderBook(const OrderBook&) = delete;
+        OrderBook& operator=(const OrderBook&) = delete;
+
+        /**
+         * @brief Matches an incoming order against the opposite side and rests the
+         * remainder.
+         *
+         * @note The caller has already verified that the (clientId, orderId) pair is not
+         * resting and that the pool has a free slot.
+         */
+        void newOrder(const OrderRequest& req, Executions& out);
+
+        /**
+         * @brief Removes a resting order from the book and releases its slot.
+         * @param h Handle obtained from BookContext::index.
+         */
+        void cancel(Handle h, uint64_t seqNo, Executions& out);
+
+        /**
+         * @brief Amends a resting order.
+         *
+         * @details
+         * A quantity reduction at the same price is applied in place and keeps time
+         * priority. Any other change (price move, quantity increase) loses priority:
+         * the order is pulled from its level, may trade as an aggressor at the new
+         * price (subject to the AON availability check), and rests at the tail of the
+         * new level. `newQty` is the new open quantity.
+         */
+        void replace(Handle h, int64_t newPrice, uint64_t newQty, uint64_t seqNo, Executions& out);
+
+        /**
+         * @brief Day roll: expires every resting order without the GTC flag. GTC orders
+         * keep their level and time priority.
+         */
+        void endOfDay(uint64_t seqNo, Executions& out);
+
+        // ----- Introspection -----
+
+        uint32_t id() const noexcept { return mId; }
+        const std::string& symbol() const noexcept { return mSymbol; }
+
+        bool hasBid() const noexcept { return !mBids.empty(); }
+        bool hasAsk() const noexcept { return !mAsks.empty(); }
+        int64_t bestBid() const noexcept { return mCtx.levels[mBids.back()].price; }
+        int64_t bestAsk() const noexcept { return mCtx.levels[mAsks.back()].price; }
+
+        /** @return Aggregated open quantity at a price, 0 if the level does not exist. */
+        uint64_t levelQty(Order::Side side, int64_t price) const noexcept;
+
+        /** @return Number of price levels on a side. */
+        size_t depth(Order::Side side) const noexcept {
+            return side == Order::Side::BUY ? mBids.size() : mAsks.size();
+        }
+
+    private:
+        std::vector<Handle>& sideOf(Order::Side side) noexcept {
+            return side == Order::Side::BUY ? mBids : mAsks;
+        }
+        const std::vector<Handle>& sideOf(Order::Side side) const noexcept {
+            return side == Order::Side::BUY ? mBids : mAsks;
+        }
+
+        // true when `price` on `side` is a better (more aggressive) price than `other`
+        static bool better(Order::Side side, int64_t price, int64_t other) noexcept {
+            return side == Order::Side::BUY ? price > other : price < other;
+        }
+
+        /**
+         * @brief Quantity an incoming order can take partially at `price` or better within
+         * the protection band, counted from aggregated level quantities only. Stops as soon
+         * as `wanted` is reached.
+         */
+        uint64_t available(Order::Side side, int64_t price, uint64_t wanted) const noexcept;
+
+        /**
+         * @brief Trades an aggressor against the opposite side while prices cross.
+         * @param capped Set when the walk stopped on the protection band.
+         * @return Quantity left after matching.
+         */
+        uint64_t match(Order::Side side, int64_t price, uint64_t qty, uint64_t seqNo,
+                       uint64_t clientId, uint64_t orderId, Executions& out, bool& capped);
+
+        // Limit order price, or the price crossing every level for a market order
+        static int64_t limitOf(const OrderRequest& req) noexcept;
+
+        // Appends an order slot at the tail of its price level (creating the level if needed)
+        void link(Handle h);
+
+        // Removes an order slot from the level's FIFO list, quantities are left to the caller
+        void detach(PriceLevel& lvl, RestingOrder& o) noexcept;
+
+        // Removes an order slot from its level (dropping the level if it becomes empty)
+        void unlink(Handle h);
+
+        // Releases a fully filled or cancelled order slot together with its index entry
+        void retire(Handle h);
+
+        // Position of the level with `price` in the side vector, or npos
+        size_t findLevel(const std::vector<Handle>& levels, Order::Side side, int64_t price) const noexcept;
+    };
+
+} // namespace Exchange::Matching
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vector>
+#include "RestingOrder.h"
+#include "Exception.h"
+
+namespace Exchange::Matching {
+
+    class Snapshot;
+
+    /**
+     * @class OrderIndex
+     * @brief Open-addressing hash index from (clientId, orderId) to the pool slot of a
+     * resting order.
+     *
+     * @details
+     * - Table size is a power of two (>= 2x the number of orders it must hold) so the
+     *   load factor stays <= 0.5 and probe sequences remain short.
+     * - Linear probing keeps a probe sequence inside one or two cache lines.
+     * - Erase uses backward-shift deletion instead of tombstones, so a table which sees
+     *   millions of insert/erase pairs (market maker cancel flow) never degrades.
+     * - The table is allocated once in the constructor; insert/find/erase never allocate.
+     */
+    class OrderIndex {
+        friend class Snapshot;   // Raw (de)serialization of the state
+
+        struct Entry {
+            uint64_t clientId;
+            uint64_t orderId;
+            Handle handle;      // NULL_HANDLE marks an empty bucket
+        };
+
+        std::vector<Entry> mTable;
+        uint64_t mMask;
+        uint32_t mSize{0};
+
+        static uint64_t mix(uint64_t x) noexcept {
+            // splitmix64 finalizer
+            x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        uint64_t bucketOf(uint64_t clientId, uint64_t orderId) const noexcept {
+            return mix(orderId ^ mix(clientId)) & mMask;
+        }
+
+    public:
+        /**
+         * @brief Constructor
+         * @param maxOrders Maximum number of keys held at the same time.
+         */
+        explicit OrderIndex(uint32_t maxOrders) {
+            if (maxOrders == 0) {
+                ENG_THROW("OrderIndex capacity must be > 0");
+            }
+            uint64_t buckets = 1;
+            while (buckets < static_cast<uint64_t>(maxOrders) * 2) {
+                buckets <<= 1;
+            }
+            mTable.assign(buckets, Entry{0, 0, NULL_HANDLE});
+            mMask = buckets - 1;
+        }
+
+        OrderIndex(const OrderIndex&) = delete;
+        OrderIndex& operator=(const OrderIndex&) = delete;
+
+        /**
+         * @brief Adds a key.
+         * @return false if the key is already present (duplicate order id).
+         */
+        bool insert(uint64_t clientId, uint64_t orderId, Handle handle) noexcept {
+            uint64_t i = bucketOf(clientId, orderId);
+            while (mTable[i].handle != NULL_HANDLE) {
+                if (mTable[i].clientId == clientId && mTable[i].orderId == orderId) {
+                    return false;
+                }
+                i = (i + 1) & mMask;
+            }
+            mTable[i] = Entry{clientId, orderId, handle};
+            ++mSize;
+            return true;
+        }
+
+        /**
+         * @brief Looks up a key.
+         * @return Pool handle, or NULL_HANDLE if not found.
+         */
+        Handle find(uint64_t clientId, uint64_t orderId) const noexcept {
+            uint64_t i = bucketOf(clientId, orderId);
+            while (mTable[i].handle != NULL_HANDLE) {
+                if (mTable[i].clientId == clientId && mTable[i].orderId == orderId) {
+                    return mTable[i].handle;
+                }
+                i = (i + 1) & mMask;
+            }
+            return NULL_HANDLE;
+        }
+
+        /**
+         * @brief Removes a key.
+         * @return false if the key was not present.
+         *
+         * @details
+         * Backward-shift deletion: after emptying a bucket, every following entry of the
+         * same cluster whose home bucket is not cyclically in (hole, entry] is moved into
+         * the hole. This restores the invariant that no probe sequence crosses an empty
+         * bucket, without leaving tombstones behind.
+         */
+        bool erase(uint64_t clientId, uint64_t orderId) noexcept {
+            uint64_t i = bucketOf(clientId, orderId);
+            while (true) {
+                if (mTable[i].handle == NULL_HANDLE) {
+                    return false;
+                }
+                if (mTable[i].clientId == clientId && mTable[i].orderId == orderId) {
+                    break;
+                }
+                i = (i + 1) & mMask;
+            }
+
+            uint64_t hole = i;
+            uint64_t j = i;
+            while (true) {
+                j = (j + 1) & mMask;
+                if (mTable[j].handle == NULL_HANDLE) {
+                    break;
+                }
+                uint64_t home = bucketOf(mTable[j].clientId, mTable[j].orderId);
+                // Distance from home is larger than distance from the hole -> shift back
+                if (((j - home) & mMask) >= ((j - hole) & mMask)) {
+                    mTable[hole] = mTable[j];
+                    hole = j;
+                }
+            }
+            mTable[hole].handle = NULL_HANDLE;
+            --mSize;
+            return true;
+        }
+
+        uint32_t size() const noexcept { return mSize; }
+        uint64_t buckets() const noexcept { return mMask + 1; }
+    };
+
+} // namespace Exchange::Matching
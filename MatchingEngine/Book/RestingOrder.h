@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include "enum.h"
+
+namespace Exchange::Matching {
+
+    // Handles are plain indices into a pool, never raw pointers. This keeps every
+    // intra-book link position independent (pool can be copied/mapped as-is).
+    using Handle = uint32_t;
+    constexpr Handle NULL_HANDLE = std::numeric_limits<Handle>::max();
+
+    /**
+     * @struct RestingOrder
+     * @brief An order that lives in the book, stored in a pool slot.
+     *
+     * @details
+     * Orders at the same price form an intrusive doubly linked FIFO list (prev/next),
+     * so unlinking on cancel is O(1) once the slot is known. `level` points back to the
+     * owning price level so the aggregated level quantity can be adjusted without a search.
+     */
+    struct RestingOrder {
+        uint64_t orderId;       // Exchange assigned order id
+        uint64_t clientId;      // Owner of the order
+        uint64_t seqNo;         // Sequence number of the message which created the order
+        int64_t price;          // Fixed-point price (x10000)
+        uint64_t qty;           // Remaining (open) quantity
+        Handle prev;            // Previous order at the same price level (older)
+        Handle next;            // Next order at the same price level (newer)
+        Handle level;           // Owning price level
+        uint32_t book;          // Owning book
+        Order::Side side;
+        Order::TIF tif;
+    };
+
+    /**
+     * @struct PriceLevel
+     * @brief All resting orders at one price on one side, in time priority.
+     *
+     * @details
+     * `totalQty - aonQty` is the quantity any incoming order can take partially; it is
+     * what FOK/AON availability checks add up, so they never have to visit orders.
+     */
+    struct PriceLevel {
+        int64_t price;          // Fixed-point price (x10000)
+        uint64_t totalQty;      // Sum of open quantity of all orders on this level
+        uint64_t aonQty;        // Part of totalQty held by all-or-none orders
+        uint32_t count;         // Number of orders on this level
+        Handle head;            // Oldest order (first to be matched)
+        Handle tail;            // Newest order
+    };
+
+} // namespace Exchange::Matching
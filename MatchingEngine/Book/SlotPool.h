@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include "RestingOrder.h"
+#include "Exception.h"
+
+namespace Exchange::Matching {
+
+    class Snapshot;
+
+    /**
+     * @class SlotPool
+     * @brief Fixed capacity pool of T addressed by Handle.
+     *
+     * @details
+     * All storage is reserved up front, acquire()/release() only push/pop a free-list
+     * stack, so the steady state never touches the allocator. Freed slots are reused
+     * LIFO which keeps recently touched (cache hot) slots in circulation.
+     */
+    template <typename T>
+    class SlotPool {
+        friend class Snapshot;   // Raw (de)serialization of the state
+
+        std::vector<T> mSlots;       ///> Slot storage, never resized after construction
+        std::vector<Handle> mFree;   ///> Stack of free slot handles
+    public:
+        /** @brief Constructor */
+        explicit SlotPool(uint32_t capacity) : mSlots(capacity) {
+            if (capacity == 0 || capacity == NULL_HANDLE) {
+                ENG_THROW("SlotPool capacity must be in (0, %u)", NULL_HANDLE);
+            }
+            mFree.reserve(capacity);
+            // Push in reverse so that handle 0 is handed out first
+            for (uint32_t i = capacity; i > 0; --i) {
+                mFree.push_back(i - 1);
+            }
+        }
+
+        SlotPool(const SlotPool&) = delete;
+        SlotPool& operator=(const SlotPool&) = delete;
+
+        /**
+         * @brief Takes a free slot.
+         * @return Handle of the slot, or NULL_HANDLE if the pool is exhausted.
+         */
+        Handle acquire() noexcept {
+            if (mFree.empty()) {
+                return NULL_HANDLE;
+            }
+            Handle h = mFree.back();
+            mFree.pop_back();
+            return h;
+        }
+
+        /** @brief Returns a slot to the pool. */
+        void release(Handle h) noexcept {
+            mFree.push_back(h);
+        }
+
+        T& operator[](Handle h) noexcept { return mSlots[h]; }
+        const T& operator[](Handle h) const noexcept { return mSlots[h]; }
+
+        uint32_t capacity() const noexcept { return static_cast<uint32_t>(mSlots.size()); }
+        uint32_t used() const noexcept { return capacity() - static_cast<uint32_t>(mFree.size()); }
+    };
+
+} // namespace Exchange::Matching
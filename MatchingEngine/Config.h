@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include "XMLReader.h"
+#include "String.h"
+
+namespace Exchange::Matching {
+    class Config : public Core::XMLNode {
+        Core::String mIpcQueueEngine;
+        Core::String mMaxOrders;
+        Core::String mMaxSweepLevels;
+        Core::String mShardCount;
+        Core::String mShardFirstCpu;
+        Core::String mShardRingSize;
+        Core::String mSnapshotDirectory;
+        Core::String mSnapshotInterval;
+
+        Config(const tinyxml2::XMLElement* element):XMLNode(element){
+            mIpcQueueEngine = getChild("Ipc").getChild("MatchingEngineQueue").get();
+            mMaxOrders = getChild("Book").getChild("MaxOrders").get();
+            mMaxSweepLevels = getChild("Book").getChild("MaxSweepLevels").get();
+            mShardCount = getChild("Shards").getChild("Count").get();
+            mShardFirstCpu = getChild("Shards").getChild("FirstCpu").get();
+            mShardRingSize = getChild("Shards").getChild("RingSize").get();
+            mSnapshotDirectory = getChild("Snapshot").getChild("Directory").get();
+            mSnapshotInterval = getChild("Snapshot").getChild("IntervalMsgs").get();
+        }
+    public:
+        // Delete copy and move constructor to enforce singleton
+        Config(const Config&) = delete;
+        Config& operator=(const Config&) = delete;
+
+        // Lazy initialization
+        static void init(const tinyxml2::XMLElement* element) {
+            static Config instance(element);
+            getInstance() = &instance;
+        }
+
+        // Accessor
+        static Config& instance() {
+            Config* inst = getInstance();
+            if (!inst) {
+                ENG_THROW("Matching::Config accessed before init()");
+            }
+            return *inst;
+        }
+
+        // Getters
+        Core::String ipcQueueEngine() const { return mIpcQueueEngine; }
+        uint32_t maxOrders() const {return static_cast<uint32_t>(std::stoul(mMaxOrders.toString()));}
+        uint32_t maxSweepLevels() const {return static_cast<uint32_t>(std::stoul(mMaxSweepLevels.toString()));}
+        uint32_t shardCount() const {return static_cast<uint32_t>(std::stoul(mShardCount.toString()));}
+        int shardFirstCpu() const {return std::stoi(mShardFirstCpu.toString());}
+        size_t shardRingSize() const {return std::stoul(mShardRingSize.toString());}
+        Core::String snapshotDirectory() const { return mSnapshotDirectory; }
+        uint64_t snapshotInterval() const {return std::stoull(mSnapshotInterval.toString());}
+
+    private:
+        static Config*& getInstance() {
+            static Config* instance = nullptr;
+            return instance;
+        }
+    };
+} // namespace Exchange::Matching
@@ -0,0 +1,132 @@
+#include "EngineCore.h"
+
+namespace Exchange::Matching {
+
+    using Ipc::Msg::FieldId;
+    using Ipc::Msg::MsgType;
+
+    static uint16_t fid(FieldId id) { return static_cast<uint16_t>(id); }
+
+    uint32_t EngineCore::addBook(const std::string& symbol) {
+        auto it = mBookIds.find(symbol);
+        if (it != mBookIds.end()) {
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(mBooks.size());
+        mBooks.push_back(std::make_unique<OrderBook>(id, symbol, mCtx));
+        mBookIds.emplace(symbol, id);
+        LOG_INFO("Book created Symbol=%s Id=%u", symbol.c_str(), id);
+        return id;
+    }
+
+    OrderBook* EngineCore::findBook(const std::string& symbol) const {
+        auto it = mBookIds.find(symbol);
+        return it == mBookIds.end() ? nullptr : mBooks[it->second].get();
+    }
+
+    void EngineCore::onNewOrder(const std::string& symbol, const OrderRequest& req, Executions& out) {
+        onNewOrder(addBook(symbol), req, out);
+    }
+
+    void EngineCore::onNewOrder(uint32_t bookId, const OrderRequest& req, Executions& out) {
+        if (req.qty == 0) {
+            reject(RejectReason::INVALID_QTY, req.seqNo, req.clientId, req.orderId, out);
+            return;
+        }
+        if (mCtx.index.find(req.clientId, req.orderId) != NULL_HANDLE) {
+            reject(RejectReason::DUPLICATE_ORDER_ID, req.seqNo, req.clientId, req.orderId, out);
+            return;
+        }
+        // The order may rest, so a slot must be available before it is allowed to trade
+        if (mCtx.orders.used() == mCtx.orders.capacity()) {
+            reject(RejectReason::BOOK_FULL, req.seqNo, req.clientId, req.orderId, out);
+            return;
+        }
+        mBooks[bookId]->newOrder(req, out);
+    }
+
+    void EngineCore::onCancel(uint64_t seqNo, uint64_t clientId, uint64_t orderId, Executions& out) {
+        Handle h = mCtx.index.find(clientId, orderId);
+        if (h == NULL_HANDLE) {
+            reject(RejectReason::UNKNOWN_ORDER, seqNo, clientId, orderId, out);
+            return;
+        }
+        mBooks[mCtx.orders[h].book]->cancel(h, seqNo, out);
+    }
+
+    void EngineCore::onReplace(uint64_t seqNo, uint64_t clientId, uint64_t orderId,
+                               int64_t newPrice, uint64_t newQty, Executions& out) {
+        Handle h = mCtx.index.find(clientId, orderId);
+        if (h == NULL_HANDLE) {
+            reject(RejectReason::UNKNOWN_ORDER, seqNo, clientId, orderId, out);
+            return;
+        }
+        if (newQty == 0) {
+            reject(RejectReason::INVALID_QTY, seqNo, clientId, orderId, out);
+            return;
+        }
+        mBooks[mCtx.orders[h].book]->replace(h, newPrice, newQty, seqNo, out);
+    }
+
+    void EngineCore::onEndOfDay(uint64_t seqNo, Executions& out) {
+        for (auto& book : mBooks) {
+            book->endOfDay(seqNo, out);
+        }
+    }
+
+    void EngineCore::apply(const Ipc::Msg::IpcMessage& msg, Executions& out) {
+        const uint64_t seqNo = msg.getHeader().seqNo;
+        const uint64_t clientId = msg.getUint64(fid(FieldId::FIELD_CLIENT_ID)).value_or(0);
+        const uint64_t orderId = msg.getUint64(fid(FieldId::FIELD_ORDER_ID)).value_or(0);
+
+        switch (static_cast<MsgType>(msg.getHeader().MsgType)) {
+            case MsgType::NEW_ORDER: {
+                auto symbol = msg.getString(fid(FieldId::FIELD_SYMBOL));
+                if (!symbol) {
+                    reject(RejectReason::UNKNOWN_SYMBOL, seqNo, clientId, orderId, out);
+                    return;
+                }
+                onNewOrder(*symbol, decodeOrder(msg), out);
+                break;
+            }
+            case MsgType::CANCEL:
+                onCancel(seqNo, clientId, orderId, out);
+                break;
+            case MsgType::REPLACE:
+                onReplace(seqNo, clientId, orderId,
+                          msg.getInt64(fid(FieldId::FIELD_PRICE)).value_or(0),
+                          msg.getUint64(fid(FieldId::FIELD_QTY)).value_or(0),
+                          out);
+                break;
+            case MsgType::END_OF_DAY:
+                onEndOfDay(seqNo, out);
+                break;
+            default:
+                LOG_WARN("Unhandled MsgType=%u SeqNo=%lu", msg.getHeader().MsgType, seqNo);
+                break;
+        }
+    }
+
+    OrderRequest EngineCore::decodeOrder(const Ipc::Msg::IpcMessage& msg) {
+        OrderRequest req{};
+        req.seqNo = msg.getHeader().seqNo;
+        req.clientId = msg.getUint64(fid(FieldId::FIELD_CLIENT_ID)).value_or(0);
+        req.orderId = msg.getUint64(fid(FieldId::FIELD_ORDER_ID)).value_or(0);
+        req.side = static_cast<Order::Side>(msg.getUint64(fid(FieldId::FIELD_SIDE)).value_or(0));
+        req.tif = static_cast<Order::TIF>(msg.getUint64(fid(FieldId::FIELD_TIF)).value_or(0));
+        req.price = msg.getInt64(fid(FieldId::FIELD_PRICE)).value_or(0);
+        req.qty = msg.getUint64(fid(FieldId::FIELD_QTY)).value_or(0);
+        req.type = static_cast<Order::Type>(msg.getUint64(fid(FieldId::FIELD_ORD_TYPE))
+                                                .value_or(static_cast<uint64_t>(Order::Type::LIMIT)));
+        return req;
+    }
+
+    void EngineCore::reject(RejectReason reason, uint64_t seqNo, uint64_t clientId,
+                            uint64_t orderId, Executions& out) {
+        out.push_back(Execution{
+            .type = ExecType::REJECTED, .reason = reason, .side = Order::Side::BUY,
+            .seqNo = seqNo, .clientId = clientId, .orderId = orderId
+        });
+    }
+
+} // namespace Exchange::Matching
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "messaging.h"
+#include "Book/OrderBook.h"
+
+namespace Exchange::Matching {
+
+    class Snapshot;
+
+    /**
+     * @class EngineCore
+     * @brief Owns a set of order books together with the order pool and the
+     * (clientId, orderId) index they share, and applies sequenced IPC messages to them.
+     *
+     * @details
+     * Single threaded by design: one EngineCore is driven by exactly one thread, so
+     * books, pools and index are accessed without any synchronization.
+     */
+    class EngineCore {
+        friend class Snapshot;   // Raw (de)serialization of the state
+
+        BookContext mCtx;
+        std::vector<std::unique_ptr<OrderBook>> mBooks;             ///> Indexed by book id
+        std::unordered_map<std::string, uint32_t> mBookIds;         ///> Symbol -> book id
+
+    public:
+        /**
+         * @brief Constructor
+         * @param maxOrders Maximum number of orders resting across all books.
+         * @param maxSweepLevels Protection band, price levels one aggressor may walk (0 = unbounded).
+         */
+        explicit EngineCore(uint32_t maxOrders, uint32_t maxSweepLevels = 0) : mCtx(maxOrders, maxSweepLevels) {}
+
+        EngineCore(const EngineCore&) = delete;
+        EngineCore& operator=(const EngineCore&) = delete;
+
+        /**
+         * @brief Creates the book for a symbol (no-op if it exists).
+         * @return Book id
+         */
+        uint32_t addBook(const std::string& symbol);
+
+        /** @return Book for a symbol or nullptr. */
+        OrderBook* findBook(const std::string& symbol) const;
+
+        void onNewOrder(const std::string& symbol, const OrderRequest& req, Executions& out);
+        void onNewOrder(uint32_t bookId, const OrderRequest& req, Executions& out);
+        void onCancel(uint64_t seqNo, uint64_t clientId, uint64_t orderId, Executions& out);
+        void onReplace(uint64_t seqNo, uint64_t clientId, uint64_t orderId,
+                       int64_t newPrice, uint64_t newQty, Executions& out);
+
+        /** @brief Day roll: expires every non GTC order of every book, in book id order. */
+        void onEndOfDay(uint64_t seqNo, Executions& out);
+
+        /**
+         * @brief Decodes a sequenced message and applies it to the right book.
+         * Books are created on the first order seen for a symbol.
+         */
+        void apply(const Ipc::Msg::IpcMessage& msg, Executions& out);
+
+        const BookContext& context() const noexcept { return mCtx; }
+        const OrderBook& book(uint32_t id) const noexcept { return *mBooks[id]; }
+        size_t bookCount() const noexcept { return mBooks.size(); }
+
+        /** @brief Reads the order fields (side, type, price, qty, ids, tif) of a message. */
+        static OrderRequest decodeOrder(const Ipc::Msg::IpcMessage& msg);
+
+        static void reject(RejectReason reason, uint64_t seqNo, uint64_t clientId,
+                           uint64_t orderId, Executions& out);
+    };
+
+} // namespace Exchange::Matching
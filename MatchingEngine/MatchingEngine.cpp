@@ -0,0 +1,140 @@
+#include "MatchingEngine.h"
+
+#include <csignal>
+#include <sys/stat.h>
+#include <thread>
+
+#include "LoggingConfig.h"
+#include "SymbolsConfig.h"
+#include "ThreadsConfig.h"
+#include "Metrics/LatencyTracer.h"
+
+namespace Exchange::Matching {
+
+    static MatchingEngine* gInstance = nullptr;
+
+    MatchingEngine::MatchingEngine(const Core::String& name)
+        : mName(name) {
+        gInstance = this;
+    }
+
+    void MatchingEngine::setupSignalHandlers() {
+        struct sigaction sa{};
+        sa.sa_handler = MatchingEngine::signalHandler;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = 0;
+
+        sigaction(SIGINT,  &sa, nullptr);
+        sigaction(SIGTERM, &sa, nullptr);
+        Core::LatencyTracer::installSignal();
+    }
+
+    void MatchingEngine::signalHandler(int signum) {
+        if (!gInstance) return;
+
+        if (signum == SIGINT || signum == SIGTERM) {
+            gInstance->stop();
+        }
+    }
+
+    void MatchingEngine::start() {
+        Core::TscClock::calibrate();
+        LOG_INFO("Launching Matching Engine...");
+        setupSignalHandlers();
+
+        // Load configuration
+        Core::XMLReader reader("../config.xml");
+        Config::init(reader.getNode(mName));
+        Core::LoggingConfig::apply(reader.getNode(mName));
+        Core::MetricsRegistry::init(mName);
+
+        const Config& cfg = Config::instance();
+
+        // Throws if the sequencer has not created the queue yet
+        Ipc::Consumer inbound(cfg.ipcQueueEngine(), 4096);
+
+        // The gateway publishes the table; the same configuration gives the same ids without it
+        try {
+            mSymbols = Ipc::SymbolTable::open(Ipc::SYMBOL_TABLE_SEGMENT);
+        } catch (const std::exception& e) {
+            LOG_WARN("Symbol table not published (%s), building it from the configuration", e.what());
+            mSymbols = Ipc::SymbolTable(Core::SymbolsConfig(reader.getNode("Symbols")).symbols());
+        }
+
+        mRouter = std::make_unique<ShardRouter>(
+            cfg.shardCount(), cfg.maxOrders(), cfg.maxSweepLevels(), cfg.shardRingSize(), cfg.shardFirstCpu(), *this,
+            &mSymbols);
+        mSnapshotDir = cfg.snapshotDirectory().toString();
+        mSnapshotInterval = cfg.snapshotInterval();
+        if (mSnapshotInterval > 0) {
+            mkdir(mSnapshotDir.c_str(), 0755);
+            uint64_t seqNo = mRouter->restore(mSnapshotDir);
+            if (seqNo > 0) {
+                LOG_INFO("Engine state restored, replaying from SeqNo=%lu", seqNo + 1);
+            }
+        }
+
+        const Core::ThreadsConfig threads(reader.getNode(mName));
+        mScheduler = std::make_unique<EngineScheduler>(mName, cfg.shardCount(), threads.spec("Shard", "me-shard"));
+        mScheduler->start(*mRouter);
+
+        // The sequencer reader runs on the main thread
+        threads.spec("Reader", "me-reader").apply();
+        run(inbound);
+
+        mScheduler->shutdown(*mRouter);
+        Core::LatencyTracer::instance().dump();
+
+        LOG_INFO("Matching Engine stopped");
+    }
+
+    void MatchingEngine::stop() {
+        mShutdownRequested.store(true, std::memory_order_release);
+    }
+
+    void MatchingEngine::run(Ipc::Consumer& inbound) {
+        std::vector<uint8_t> buf(Ipc::MAX_MSG_SIZE);
+        Ipc::Msg::IpcMessage msg;
+        uint64_t sinceSnapshot = 0;
+        Core::LatencyTracer& tracer = Core::LatencyTracer::instance();
+        Core::Counter routed("engine.messages");
+        Core::Counter completed("engine.completed");
+        Core::Counter undecodable("engine.decode_errors");
+        Core::Gauge depth("engine.inbound_depth");
+
+        while (!mShutdownRequested.load(std::memory_order_acquire)) {
+            tracer.pollDump();
+            uint32_t n = inbound.read(buf.data(), static_cast<uint32_t>(buf.size()));
+            if (n == 0) {
+                const size_t done = mRouter->drain();
+                if (done == 0) {
+                    std::this_thread::yield();
+                }
+                completed.add(done);
+                continue;
+            }
+            depth.set(inbound.depth());
+            if (!Ipc::Msg::IpcMessage::decode(buf.data(), n, msg)) {
+                undecodable.add();
+                LOG_WARN("Dropping undecodable message (%u bytes)", n);
+                continue;
+            }
+            mRouter->accept(msg);
+            routed.add();
+            completed.add(mRouter->drain());
+
+            if (mSnapshotInterval > 0 && ++sinceSnapshot >= mSnapshotInterval) {
+                mRouter->snapshot(mSnapshotDir);
+                sinceSnapshot = 0;
+            }
+        }
+    }
+
+    void MatchingEngine::onExecution(const Execution& e) {
+        // Executions are logged only: there is no engine -> gateway queue, clients get no fills
+        LOG_DEBUG("EXEC Type=%u SeqNo=%lu Client=%lu Order=%lu Price=%ld Qty=%lu Leaves=%lu",
+            static_cast<unsigned>(e.type), e.seqNo, e.clientId, e.orderId,
+            e.price, e.qty, e.leavesQty);
+    }
+
+} // namespace Exchange::Matching
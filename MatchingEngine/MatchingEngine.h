@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "String.h"
+#include "Exception.h"
+#include "SharedMemory.h"
+#include "Config.h"
+#include "Shard/ShardRouter.h"
+#include "Scheduler/EngineScheduler.h"
+
+namespace Exchange::Matching {
+
+    /**
+     * @class MatchingEngine
+     * @brief Matching engine process: reads sequenced messages from the sequencer's
+     * shared memory queue and routes them to the engine shards owning the books.
+     *
+     * @details
+     * The thread calling start() is the sequencer-reader thread: it decodes, routes to
+     * the shards and merges their executions back in sequence order (see ShardRouter).
+     */
+    class MatchingEngine : public IExecutionSink {
+    public:
+        explicit MatchingEngine(const Core::String& name);
+
+        void start();
+        void stop();
+
+    private:
+        void setupSignalHandlers();
+        static void signalHandler(int signum);
+
+        /**
+         * @brief Main loop. Polls the inbound queue, routes every message and reports
+         * the merged executions.
+         */
+        void run(Ipc::Consumer& inbound);
+
+        void onExecution(const Execution& exec) override;
+
+    private:
+        Core::String mName;
+        std::atomic<bool> mShutdownRequested{false};
+        std::unique_ptr<EngineScheduler> mScheduler;
+        Ipc::SymbolTable mSymbols;              ///> Symbol ids of the orders, outlives mRouter
+        std::unique_ptr<ShardRouter> mRouter;
+        std::string mSnapshotDir;               ///> Where shard snapshots are written/restored
+        uint64_t mSnapshotInterval{0};          ///> Routed messages between snapshots, 0 = off
+    };
+
+} // namespace Exchange::Matching
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include "Scheduler.h"
+#include "String.h"
+#include "Shard/ShardRouter.h"
+
+namespace Exchange::Matching {
+
+    class EngineScheduler : public Scheduler {
+        Core::String mWorkerPrefix;
+        std::vector<WorkerHandle> mShardWorkers;
+
+    public:
+
+        /**
+         * @brief Constructor
+         * @details
+         * Creates one dedicated worker per engine shard. Each shard worker runs a busy
+         * polling loop for its whole lifetime, so a worker is never shared between shards.
+         *
+         * @param prefix Base name prefix for the worker threads (e.g., "MatchingEngine").
+         *               Thread names will be formed as "{prefix}_shard_{i}".
+         * @param shardCount Number of shards.
+         * @param shardSpec  Placement of the shard threads (<Threads><Shard>). With one CPU per
+         *                   shard in its list, shard i is pinned to the i-th; otherwise every
+         *                   shard may run on any CPU of the list.
+         */
+        EngineScheduler(const Core::String prefix, size_t shardCount, const WorkerSpec& shardSpec = {})
+            : mWorkerPrefix(std::move(prefix)) {
+            for (size_t i = 0; i < shardCount; ++i) {
+                const std::string id = (mWorkerPrefix + "_shard_").toString() + std::to_string(i);
+                mShardWorkers.push_back(createWorker(id, shardSpec.forIndex(i, shardCount)));
+            }
+        }
+
+        /**
+         * @brief Starts the workers and hands every shard loop to its worker.
+         * @param router Router owning the shards, one shard per worker.
+         */
+        void start(ShardRouter& router) {
+            if (router.shardCount() != mShardWorkers.size()) {
+                ENG_THROW("Shard count (%zu) does not match worker count (%zu)",
+                    router.shardCount(), mShardWorkers.size());
+            }
+
+            Scheduler::start();
+
+            for (size_t i = 0; i < mShardWorkers.size(); ++i) {
+                EngineShard& shard = router.shard(i);
+                submitTo(
+                    mShardWorkers[i],
+                    [&shard](const CancelToken&) {
+                        // Returns once the router sends ControlStop
+                        shard.run();
+                    },
+                    "Matching engine shard loop"
+                );
+            }
+            LOG_INFO("Engine shard loops submitted to %zu workers", mShardWorkers.size());
+        }
+
+        /**
+         * @brief Flushes outstanding work, stops every shard loop and joins the workers.
+         */
+        void shutdown(ShardRouter& router) {
+            router.stop();
+            Scheduler::shutdown();
+        }
+    };
+} // namespace Exchange::Matching
@@ -0,0 +1,149 @@
+#include "EngineShard.h"
+
+#include <pthread.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "Snapshot/Snapshot.h"
+
+namespace Exchange::Matching {
+
+    // Helper to dispatch a std::variant with a set of lambdas
+    template <class... Ts> struct Overloaded : Ts... { using Ts::operator()...; };
+    template <class... Ts> Overloaded(Ts...) -> Overloaded<Ts...>;
+
+    static void pinToCpu(int cpu) {
+        if (cpu < 0) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            LOG_WARN("Failed to pin shard thread to CPU %d", cpu);
+        }
+    }
+
+    EngineShard::EngineShard(uint32_t id, uint32_t maxOrders, uint32_t maxSweepLevels, size_t ringSize, int cpu)
+        : mId(id), mCpu(cpu), mCore(maxOrders, maxSweepLevels), mInbound(ringSize), mOutbound(ringSize) {
+        mOut.reserve(1024);
+        mBatch.reserve(1024);
+    }
+
+    void EngineShard::run() {
+        pinToCpu(mCpu);
+        LOG_INFO("Engine shard %u started (cpu=%d)", mId, mCpu);
+
+        mStopped = false;
+        while (!mStopped) {
+            if (!poll()) {
+                std::this_thread::yield();
+            }
+        }
+        reapSnapshot(true);
+        LOG_INFO("Engine shard %u stopped", mId);
+    }
+
+    bool EngineShard::poll() {
+        if (!mInbound.tryPop(mCmd)) {
+            return false;
+        }
+        mOut.clear();
+        std::visit(Overloaded{
+            [&](ShardMsg::AddBook& m) {
+                if (mCore.addBook(m.symbol) != m.bookId) {
+                    LOG_ERROR("Shard %u book id mismatch for %s", mId, m.symbol.c_str());
+                }
+            },
+            [&](ShardMsg::NewOrder& m) {
+                mCore.onNewOrder(m.bookId, m.order, mOut);
+                publish(mOut);
+            },
+            [&](ShardMsg::Cancel& m) {
+                mCore.onCancel(m.seqNo, m.clientId, m.orderId, mOut);
+                publish(mOut);
+            },
+            [&](ShardMsg::Replace& m) {
+                mCore.onReplace(m.seqNo, m.clientId, m.orderId, m.price, m.qty, mOut);
+                publish(mOut);
+            },
+            [&](ShardMsg::EndOfDay& m) {
+                mCore.onEndOfDay(m.seqNo, mOut);
+                publish(mOut);
+            },
+            [&](ShardMsg::TakeSnapshot& m) {
+                takeSnapshot(m.seqNo, m.path);
+            },
+            [&](ShardMsg::ControlStop&) {
+                mStopped = true;
+            }
+        }, mCmd);
+        return true;
+    }
+
+    uint64_t EngineShard::restore(const std::string& path) {
+        return Snapshot::load(path, mCore);
+    }
+
+    void EngineShard::takeSnapshot(uint64_t seqNo, const std::string& path) {
+        if (!reapSnapshot(false)) {
+            LOG_WARN("Shard %u previous snapshot still being written, skipping SeqNo=%lu", mId, seqNo);
+            return;
+        }
+
+        // Built before the fork: the child must not allocate (another thread may have
+        // held the allocator lock at the time of the fork)
+        const std::string tmp = path + ".tmp";
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            bool ok = Snapshot::write(mCore, seqNo, tmp.c_str(), path.c_str());
+            _exit(ok ? 0 : 1);
+        }
+        if (pid < 0) {
+            LOG_ERROR("Shard %u snapshot fork failed (errno %d)", mId, errno);
+            return;
+        }
+        mSnapshotPid = pid;
+        LOG_INFO("Shard %u snapshot started SeqNo=%lu Path=%s", mId, seqNo, path.c_str());
+    }
+
+    bool EngineShard::reapSnapshot(bool wait) {
+        if (mSnapshotPid < 0) {
+            return true;
+        }
+        int status = 0;
+        pid_t r = waitpid(mSnapshotPid, &status, wait ? 0 : WNOHANG);
+        if (r == 0) {
+            return false;
+        }
+        if (r < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            LOG_ERROR("Shard %u snapshot writer failed (status %d)", mId, status);
+        }
+        mSnapshotPid = -1;
+        return true;
+    }
+
+    void EngineShard::publish(const Executions& executions) {
+        // All executions of one command (e.g. every fill of a sweep) go out as one batch:
+        // one tail publish instead of one per trade.
+        mBatch.clear();
+        for (const auto& e : executions) {
+            mBatch.push_back(ShardMsg::Event{e, true, false});
+        }
+        mBatch.push_back(ShardMsg::Event{Execution{}, false, true});
+
+        // The router drains outputs while it routes, so a full ring only means the
+        // router is momentarily behind.
+        size_t sent = 0;
+        while (sent < mBatch.size()) {
+            size_t n = mOutbound.tryPushBulk(mBatch.data() + sent, mBatch.size() - sent);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            sent += n;
+        }
+    }
+
+} // namespace Exchange::Matching
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <sys/types.h>
+
+#include "EngineCore.h"
+#include "ShardMsg.h"
+#include "Lockfree/SpscRing.h"
+
+namespace Exchange::Matching {
+
+    /**
+     * @class EngineShard
+     * @brief A subset of the books, owned exclusively by one worker thread.
+     *
+     * @details
+     * The shard's EngineCore (books, order pool and order-id index) is only ever touched
+     * by the thread executing run(), so matching needs no locks. Commands arrive through
+     * an SPSC ring written by the router thread and executions leave through another
+     * SPSC ring read by the same router thread.
+     *
+     * Snapshots are written by a forked child: fork() gives the child a copy-on-write
+     * image of the shard state frozen between two commands, and the shard thread goes
+     * straight back to matching while the child writes the file. The only pause is the
+     * fork itself (page table copy), independent of the file size. At most one snapshot
+     * child per shard is in flight.
+     */
+    class EngineShard {
+        uint32_t mId;
+        int mCpu;                                       ///> CPU to pin the shard thread to, -1 for none
+        EngineCore mCore;
+        Core::SpscRing<ShardMsg::Msg> mInbound;         ///> Router -> shard
+        Core::SpscRing<ShardMsg::Event> mOutbound;      ///> Shard -> router
+        ShardMsg::Msg mCmd;                             ///> Command being executed (reused)
+        Executions mOut;                                ///> Executions of the current command (reused)
+        std::vector<ShardMsg::Event> mBatch;            ///> Events of the current command (reused)
+        bool mStopped{false};                           ///> ControlStop received
+        pid_t mSnapshotPid{-1};                         ///> Snapshot writer child, -1 if none
+
+    public:
+        /** @brief Constructor */
+        EngineShard(uint32_t id, uint32_t maxOrders, uint32_t maxSweepLevels, size_t ringSize, int cpu);
+
+        EngineShard(const EngineShard&) = delete;
+        EngineShard& operator=(const EngineShard&) = delete;
+
+        /**
+         * @brief Shard main loop, runs on the shard's worker thread until a ControlStop
+         * command is received.
+         */
+        void run();
+
+        /**
+         * @brief Executes the next command of the inbound ring, if any. run() loops on it;
+         * a test may call it from the router thread instead of running the shard.
+         * @return false if the ring was empty.
+         */
+        bool poll();
+
+        /**
+         * @brief Loads a snapshot written by this shard. Must be called before run().
+         * @return Sequence number the snapshot was taken at.
+         */
+        uint64_t restore(const std::string& path);
+
+        uint32_t id() const noexcept { return mId; }
+        Core::SpscRing<ShardMsg::Msg>& inbound() noexcept { return mInbound; }
+        Core::SpscRing<ShardMsg::Event>& outbound() noexcept { return mOutbound; }
+
+        /** @note Only safe to inspect once run() has returned. */
+        const EngineCore& core() const noexcept { return mCore; }
+
+    private:
+        void publish(const Executions& executions);
+        void takeSnapshot(uint64_t seqNo, const std::string& path);
+
+        // Collects a finished snapshot child. Returns false if one is still running.
+        bool reapSnapshot(bool wait);
+    };
+
+} // namespace Exchange::Matching
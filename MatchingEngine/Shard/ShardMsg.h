@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <variant>
+#include "Book/OrderBook.h"
+
+namespace Exchange::Matching::ShardMsg {
+
+    // <====== Router -> shard commands ======>
+
+    // Registers a book on the shard. Sent once, the first time a symbol is routed.
+    struct AddBook { std::string symbol; uint32_t bookId; };
+    struct NewOrder { uint32_t bookId; OrderRequest order; };
+    struct Cancel { uint64_t seqNo; uint64_t clientId; uint64_t orderId; };
+    struct Replace { uint64_t seqNo; uint64_t clientId; uint64_t orderId; int64_t price; uint64_t qty; };
+    // Broadcast to every shard, each one answers with the expiries of its own books
+    struct EndOfDay { uint64_t seqNo; };
+    // Writes the shard state as of `seqNo` to `path`. No executions are produced.
+    struct TakeSnapshot { uint64_t seqNo; std::string path; };
+    struct ControlStop {};
+    using Msg = std::variant<AddBook, NewOrder, Cancel, Replace, EndOfDay, TakeSnapshot, ControlStop>;
+
+    // <====== Shard -> router events ======>
+
+    /**
+     * @struct Event
+     * @brief One execution produced by a shard. Every command except AddBook,
+     * TakeSnapshot and ControlStop is answered by zero or more executions followed by an event with
+     * `endOfMsg` set, which is what lets the router merge shard outputs in sequence order.
+     */
+    struct Event {
+        Execution exec;
+        bool hasExec;
+        bool endOfMsg;
+    };
+
+} // namespace Exchange::Matching::ShardMsg
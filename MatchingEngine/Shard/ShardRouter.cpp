@@ -0,0 +1,250 @@
+#include "ShardRouter.h"
+
+#include <thread>
+#include <unistd.h>
+
+#include "Metrics/LatencyTracer.h"
+
+namespace Exchange::Matching {
+
+    using Ipc::Msg::FieldId;
+    using Ipc::Msg::MsgType;
+
+    static uint16_t fid(FieldId id) { return static_cast<uint16_t>(id); }
+
+    ShardRouter::ShardRouter(uint32_t shardCount, uint32_t maxOrders, uint32_t maxSweepLevels, size_t ringSize, int firstCpu,
+                             IExecutionSink& sink, const Ipc::SymbolTable* symbols)
+        : mBookCounts(shardCount, 0), mSymbols(symbols), mRoutesById(symbols ? symbols->size() : 0, Route{LOCAL, 0}),
+          mPending(static_cast<size_t>(shardCount) * ringSize * 2), mRestoredSeqNo(shardCount, 0), mSink(sink) {
+        if (shardCount == 0) {
+            ENG_THROW("ShardRouter needs at least one shard");
+        }
+        mShards.reserve(shardCount);
+        for (uint32_t i = 0; i < shardCount; ++i) {
+            int cpu = firstCpu < 0 ? -1 : firstCpu + static_cast<int>(i);
+            mShards.push_back(std::make_unique<EngineShard>(i, maxOrders, maxSweepLevels, ringSize, cpu));
+        }
+    }
+
+    uint32_t ShardRouter::shardOf(std::string_view symbol, uint32_t shardCount) noexcept {
+        uint64_t h = 1469598103934665603ULL;
+        for (char c : symbol) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ULL;
+        }
+        return static_cast<uint32_t>(h % shardCount);
+    }
+
+    void ShardRouter::route(const Ipc::Msg::IpcMessage& msg) {
+        const auto type = static_cast<MsgType>(msg.getHeader().MsgType);
+        const uint64_t seqNo = msg.getHeader().seqNo;
+        mLastSeqNo = seqNo;
+
+        if (type == MsgType::END_OF_DAY) {
+            // Every shard holds orders, answers are merged shard after shard
+            for (uint32_t i = 0; i < mShards.size(); ++i) {
+                if (seqNo <= mRestoredSeqNo[i]) {
+                    continue;
+                }
+                send(i, ShardMsg::EndOfDay{seqNo});
+                expect(i);
+            }
+            return;
+        }
+        if (type != MsgType::NEW_ORDER && type != MsgType::CANCEL && type != MsgType::REPLACE) {
+            LOG_WARN("Router ignoring MsgType=%u", msg.getHeader().MsgType);
+            return;
+        }
+
+        const uint64_t clientId = msg.getUint64(fid(FieldId::FIELD_CLIENT_ID)).value_or(0);
+        const uint64_t orderId = msg.getUint64(fid(FieldId::FIELD_ORDER_ID)).value_or(0);
+
+        Route r;
+        if (auto symbolId = msg.getUint64(fid(FieldId::FIELD_SYMBOL_ID))) {
+            if (*symbolId >= mRoutesById.size()) {
+                rejectLocally(RejectReason::UNKNOWN_SYMBOL, seqNo, clientId, orderId);
+                return;
+            }
+            r = mRoutesById[*symbolId];
+            if (r.shard == LOCAL) {
+                if (type != MsgType::NEW_ORDER) {
+                    // No order was ever routed for this symbol, so it cannot be resting
+                    rejectLocally(RejectReason::UNKNOWN_ORDER, seqNo, clientId, orderId);
+                    return;
+                }
+                r = addRoute(std::string(mSymbols->name(static_cast<uint32_t>(*symbolId))));
+            }
+        }
+        else if (auto symbol = msg.getString(fid(FieldId::FIELD_SYMBOL))) {
+            auto it = mRoutes.find(*symbol);
+            if (it == mRoutes.end()) {
+                if (type != MsgType::NEW_ORDER) {
+                    rejectLocally(RejectReason::UNKNOWN_ORDER, seqNo, clientId, orderId);
+                    return;
+                }
+                r = addRoute(*symbol);
+            }
+            else {
+                r = it->second;
+            }
+        }
+        else {
+            rejectLocally(RejectReason::UNKNOWN_SYMBOL, seqNo, clientId, orderId);
+            return;
+        }
+        if (seqNo <= mRestoredSeqNo[r.shard]) {
+            // Already part of the shard's snapshot (journal replay after restart)
+            return;
+        }
+
+        switch (type) {
+            case MsgType::NEW_ORDER:
+                send(r.shard, ShardMsg::NewOrder{r.bookId, EngineCore::decodeOrder(msg)});
+                break;
+            case MsgType::CANCEL:
+                send(r.shard, ShardMsg::Cancel{seqNo, clientId, orderId});
+                break;
+            default:
+                send(r.shard, ShardMsg::Replace{seqNo, clientId, orderId,
+                    msg.getInt64(fid(FieldId::FIELD_PRICE)).value_or(0),
+                    msg.getUint64(fid(FieldId::FIELD_QTY)).value_or(0)});
+                break;
+        }
+        expect(r.shard);
+    }
+
+    void ShardRouter::accept(Ipc::Msg::IpcMessage& msg) {
+        route(msg);
+        if (msg.markStage(Ipc::Msg::TraceStage::ENGINE_ACK)) {
+            Core::LatencyTracer::instance().record(*msg.getTrace(), Ipc::Msg::TraceStage::ENGINE_ACK,
+                Ipc::Msg::TraceStage::ENGINE_ACK);
+        }
+    }
+
+    size_t ShardRouter::drain() {
+        size_t completed = 0;
+        ShardMsg::Event ev;
+        while (Pending* head = mPending.front()) {
+            if (head->shard == LOCAL) {
+                mSink.onExecution(head->local);
+                mPending.pop();
+                ++completed;
+                continue;
+            }
+            auto& outbound = mShards[head->shard]->outbound();
+            bool done = false;
+            while (outbound.tryPop(ev)) {
+                if (ev.hasExec) {
+                    mSink.onExecution(ev.exec);
+                }
+                if (ev.endOfMsg) {
+                    done = true;
+                    break;
+                }
+            }
+            if (!done) {
+                // Head of line message still being matched, keep order
+                break;
+            }
+            mPending.pop();
+            ++completed;
+        }
+        return completed;
+    }
+
+    void ShardRouter::flush() {
+        while (!mPending.empty()) {
+            if (drain() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void ShardRouter::stop() {
+        flush();
+        for (uint32_t i = 0; i < mShards.size(); ++i) {
+            send(i, ShardMsg::ControlStop{});
+        }
+    }
+
+    std::string ShardRouter::snapshotPath(const std::string& dir, uint32_t shard) {
+        return dir + "/shard_" + std::to_string(shard) + ".snap";
+    }
+
+    void ShardRouter::snapshot(const std::string& dir) {
+        for (uint32_t i = 0; i < mShards.size(); ++i) {
+            send(i, ShardMsg::TakeSnapshot{mLastSeqNo, snapshotPath(dir, i)});
+        }
+    }
+
+    uint64_t ShardRouter::restore(const std::string& dir) {
+        uint64_t oldest = 0;
+        bool any = false;
+        for (uint32_t i = 0; i < mShards.size(); ++i) {
+            const std::string path = snapshotPath(dir, i);
+            if (::access(path.c_str(), F_OK) != 0) {
+                continue;
+            }
+            uint64_t seqNo = mShards[i]->restore(path);
+            mRestoredSeqNo[i] = seqNo;
+            oldest = any ? std::min(oldest, seqNo) : seqNo;
+            any = true;
+
+            // Book ids are per shard and stored in id order, routes follow directly
+            const EngineCore& core = mShards[i]->core();
+            for (uint32_t b = 0; b < core.bookCount(); ++b) {
+                const std::string& symbol = core.book(b).symbol();
+                mRoutes[symbol] = Route{i, b};
+                const uint32_t id = mSymbols ? mSymbols->find(symbol) : Ipc::SymbolTable::NONE;
+                if (id != Ipc::SymbolTable::NONE) {
+                    mRoutesById[id] = Route{i, b};
+                }
+            }
+            mBookCounts[i] = static_cast<uint32_t>(core.bookCount());
+        }
+        return oldest;
+    }
+
+    ShardRouter::Route ShardRouter::addRoute(const std::string& symbol) {
+        const uint32_t shard = shardOf(symbol, static_cast<uint32_t>(mShards.size()));
+        const Route r{shard, mBookCounts[shard]++};
+        send(shard, ShardMsg::AddBook{symbol, r.bookId});
+        mRoutes.emplace(symbol, r);
+        const uint32_t id = mSymbols ? mSymbols->find(symbol) : Ipc::SymbolTable::NONE;
+        if (id != Ipc::SymbolTable::NONE) {
+            mRoutesById[id] = r;
+        }
+        return r;
+    }
+
+    void ShardRouter::send(uint32_t shard, ShardMsg::Msg&& cmd) {
+        auto& inbound = mShards[shard]->inbound();
+        while (!inbound.tryPush(std::move(cmd))) {
+            // Shard is behind, make sure it is not waiting on us to consume its output
+            if (drain() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void ShardRouter::expect(uint32_t shard) {
+        while (!mPending.tryPush(Pending{shard, Execution{}})) {
+            if (drain() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void ShardRouter::rejectLocally(RejectReason reason, uint64_t seqNo, uint64_t clientId, uint64_t orderId) {
+        Pending p{LOCAL, Execution{
+            .type = ExecType::REJECTED, .reason = reason, .side = Order::Side::BUY,
+            .seqNo = seqNo, .clientId = clientId, .orderId = orderId
+        }};
+        while (!mPending.tryPush(p)) {
+            if (drain() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+} // namespace Exchange::Matching
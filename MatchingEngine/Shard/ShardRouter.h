@@ -0,0 +1,146 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "messaging.h"
+#include "SymbolTable.h"
+#include "EngineShard.h"
+
+namespace Exchange::Matching {
+
+    /**
+     * @class IExecutionSink
+     * @brief Receives the merged, sequence ordered execution stream.
+     */
+    class IExecutionSink {
+    public:
+        virtual ~IExecutionSink() = default;
+        virtual void onExecution(const Execution& exec) = 0;
+    };
+
+    /**
+     * @class ShardRouter
+     * @brief Fans sequenced messages out to engine shards by symbol hash and merges the
+     * shard outputs back in sequence order.
+     *
+     * @details
+     * Runs entirely on the sequencer-reader thread: route() and drain() are never called
+     * concurrently, which is what keeps both rings of every shard single-producer /
+     * single-consumer.
+     *
+     * Ordering: every routed message appends the target shard to `mPending` (a FIFO in
+     * routing = sequence order). drain() only releases the outputs of the message at the
+     * head of that FIFO, so the merged stream is in the same order as the input even
+     * though shards run at different speeds. Symbols always map to the same shard, so
+     * each book sees its messages in sequence order too.
+     *
+     * Orders from the gateway carry the symbol id of the SymbolTable (FIELD_SYMBOL_ID),
+     * whose route is an array lookup; a FIELD_SYMBOL name is routed through a map.
+     *
+     * Cancel/replace are routed by their symbol (FIX 35=F/G carry tag 55), the shard then
+     * resolves the order through its own (clientId, orderId) index. END_OF_DAY carries
+     * no symbol and is broadcast to every shard.
+     */
+    class ShardRouter {
+        static constexpr uint32_t LOCAL = static_cast<uint32_t>(-1);
+
+        struct Route {
+            uint32_t shard;
+            uint32_t bookId;
+        };
+
+        // Head of the merge FIFO. `shard == LOCAL` carries a reject generated by the
+        // router itself (no shard involved).
+        struct Pending {
+            uint32_t shard;
+            Execution local;
+        };
+
+        std::vector<std::unique_ptr<EngineShard>> mShards;
+        std::vector<uint32_t> mBookCounts;                  ///> Books registered per shard
+        std::unordered_map<std::string, Route> mRoutes;     ///> Symbol -> shard/book
+        const Ipc::SymbolTable* mSymbols;                   ///> Resolves FIELD_SYMBOL_ID, may be null
+        std::vector<Route> mRoutesById;                     ///> Symbol id -> shard/book, shard LOCAL if none yet
+        Core::SpscRing<Pending> mPending;                   ///> Merge order (single threaded use)
+        std::vector<uint64_t> mRestoredSeqNo;               ///> Per shard, messages up to it are already applied
+        uint64_t mLastSeqNo{0};                             ///> Last sequence number routed
+        IExecutionSink& mSink;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param shardCount Number of shards (worker threads).
+         * @param maxOrders  Order pool capacity of every shard.
+         * @param maxSweepLevels Protection band of every book, 0 = unbounded.
+         * @param ringSize   Capacity of each shard's inbound/outbound ring.
+         * @param firstCpu   Shard i is pinned to CPU firstCpu + i, -1 disables pinning.
+         * @param sink       Receiver of the merged execution stream.
+         * @param symbols    Symbol table of FIELD_SYMBOL_ID, must outlive the router. Without it,
+         *                   messages carrying a symbol id are rejected.
+         */
+        ShardRouter(uint32_t shardCount, uint32_t maxOrders, uint32_t maxSweepLevels, size_t ringSize, int firstCpu,
+                    IExecutionSink& sink, const Ipc::SymbolTable* symbols = nullptr);
+
+        ShardRouter(const ShardRouter&) = delete;
+        ShardRouter& operator=(const ShardRouter&) = delete;
+
+        /**
+         * @brief Sends a sequenced message to the shard owning its symbol.
+         * If the shard's ring is full, drains outputs until there is room.
+         */
+        void route(const Ipc::Msg::IpcMessage& msg);
+
+        /**
+         * @brief route() for a message read from the sequencer: a traced message is then
+         * stamped ENGINE_ACK and its engine stages recorded.
+         */
+        void accept(Ipc::Msg::IpcMessage& msg);
+
+        /**
+         * @brief Forwards all outputs which are ready, in sequence order, to the sink.
+         * Never blocks.
+         * @return Number of messages completed.
+         */
+        size_t drain();
+
+        /** @brief Drains until every routed message has been answered. */
+        void flush();
+
+        /** @brief Flushes and asks every shard loop to return. */
+        void stop();
+
+        /**
+         * @brief Asks every shard to snapshot its state, as of the last routed message,
+         * to "<dir>/shard_<i>.snap". Matching is not paused (see EngineShard).
+         */
+        void snapshot(const std::string& dir);
+
+        /**
+         * @brief Loads the shard snapshots found in `dir` and rebuilds the symbol routes.
+         * Must be called before the shards are started. Afterwards, route() drops every
+         * message a shard has already applied, so the journal can be replayed from the
+         * oldest snapshot sequence number.
+         * @return Oldest snapshot sequence number, 0 if there was no snapshot.
+         */
+        uint64_t restore(const std::string& dir);
+
+        size_t shardCount() const noexcept { return mShards.size(); }
+        EngineShard& shard(size_t i) noexcept { return *mShards[i]; }
+
+        /** @brief Stable symbol -> shard mapping (FNV-1a), identical across restarts. */
+        static uint32_t shardOf(std::string_view symbol, uint32_t shardCount) noexcept;
+
+    private:
+        static std::string snapshotPath(const std::string& dir, uint32_t shard);
+        /** @brief Places the book of a new symbol on its shard and records its route. */
+        Route addRoute(const std::string& symbol);
+        void send(uint32_t shard, ShardMsg::Msg&& cmd);
+        void expect(uint32_t shard);
+        void rejectLocally(RejectReason reason, uint64_t seqNo, uint64_t clientId, uint64_t orderId);
+    };
+
+} // namespace Exchange::Matching
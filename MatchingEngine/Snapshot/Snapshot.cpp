@@ -0,0 +1,214 @@
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+// Linux
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ipc/const.h"
+
+namespace Exchange::Matching {
+
+    static_assert(std::is_trivially_copyable_v<RestingOrder>, "RestingOrder is stored as raw bytes");
+    static_assert(std::is_trivially_copyable_v<PriceLevel>, "PriceLevel is stored as raw bytes");
+    static_assert(std::is_trivially_copyable_v<SnapshotHeader>, "SnapshotHeader is stored as raw bytes");
+
+    static uint64_t align(uint64_t offset) noexcept {
+        return (offset + Ipc::CACHE_LINE_SIZE - 1) & ~static_cast<uint64_t>(Ipc::CACHE_LINE_SIZE - 1);
+    }
+
+    /**
+     * @brief Sequential writer over a file descriptor which tracks the file offset, so
+     * sections can be padded to the offsets planned in the header.
+     */
+    class FileSink {
+        int mFd;
+        uint64_t mPos{0};
+        bool mOk{true};
+
+    public:
+        explicit FileSink(int fd) : mFd(fd) {}
+
+        void put(const void* data, uint64_t size) noexcept {
+            const char* p = static_cast<const char*>(data);
+            while (mOk && size > 0) {
+                ssize_t n = ::write(mFd, p, size);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    mOk = false;
+                    return;
+                }
+                p += n;
+                size -= static_cast<uint64_t>(n);
+                mPos += static_cast<uint64_t>(n);
+            }
+        }
+
+        void padTo(uint64_t offset) noexcept {
+            static const char zeros[Ipc::CACHE_LINE_SIZE] = {};
+            while (mOk && mPos < offset) {
+                put(zeros, std::min<uint64_t>(offset - mPos, sizeof(zeros)));
+            }
+        }
+
+        uint64_t pos() const noexcept { return mPos; }
+        bool ok() const noexcept { return mOk; }
+    };
+
+    bool Snapshot::write(const EngineCore& core, uint64_t seqNo, const char* tmpPath, const char* path) noexcept {
+        const BookContext& ctx = core.mCtx;
+        const uint32_t maxOrders = ctx.orders.capacity();
+
+        // Plan the layout first, everything is sized from the live state
+        SnapshotHeader hdr{};
+        std::strncpy(hdr.magic, MAGIC, sizeof(hdr.magic) - 1);
+        hdr.version = VERSION;
+        hdr.maxOrders = maxOrders;
+        hdr.seqNo = seqNo;
+        hdr.indexBuckets = ctx.index.buckets();
+        hdr.indexSize = ctx.index.size();
+        hdr.bookCount = static_cast<uint32_t>(core.mBooks.size());
+        hdr.freeOrders = static_cast<uint32_t>(ctx.orders.mFree.size());
+        hdr.freeLevels = static_cast<uint32_t>(ctx.levels.mFree.size());
+        hdr.booksOffset = align(sizeof(SnapshotHeader));
+        hdr.ordersOffset = align(hdr.booksOffset + sizeof(SnapshotBook) * hdr.bookCount);
+        hdr.levelsOffset = align(hdr.ordersOffset + sizeof(RestingOrder) * maxOrders);
+        hdr.freeOrdersOffset = align(hdr.levelsOffset + sizeof(PriceLevel) * maxOrders);
+        hdr.freeLevelsOffset = align(hdr.freeOrdersOffset + sizeof(Handle) * hdr.freeOrders);
+        hdr.indexOffset = align(hdr.freeLevelsOffset + sizeof(Handle) * hdr.freeLevels);
+
+        const uint64_t varOffset = align(hdr.indexOffset + sizeof(OrderIndex::Entry) * hdr.indexBuckets);
+        uint64_t end = varOffset;
+        for (const auto& book : core.mBooks) {
+            end = align(end + book->mSymbol.size());
+            end += sizeof(Handle) * (book->mBids.size() + book->mAsks.size());
+        }
+        hdr.totalSize = end;
+
+        int fd = ::open(tmpPath, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+        if (fd == -1) {
+            return false;
+        }
+
+        FileSink sink(fd);
+        sink.put(&hdr, sizeof(hdr));
+
+        sink.padTo(hdr.booksOffset);
+        uint64_t cursor = varOffset;
+        for (const auto& book : core.mBooks) {
+            SnapshotBook entry{};
+            entry.symbolOffset = cursor;
+            entry.symbolLen = static_cast<uint32_t>(book->mSymbol.size());
+            entry.bidsOffset = align(cursor + entry.symbolLen);
+            entry.bidCount = static_cast<uint32_t>(book->mBids.size());
+            entry.asksOffset = entry.bidsOffset + sizeof(Handle) * entry.bidCount;
+            entry.askCount = static_cast<uint32_t>(book->mAsks.size());
+            cursor = entry.asksOffset + sizeof(Handle) * entry.askCount;
+            sink.put(&entry, sizeof(entry));
+        }
+
+        sink.padTo(hdr.ordersOffset);
+        sink.put(ctx.orders.mSlots.data(), sizeof(RestingOrder) * maxOrders);
+        sink.padTo(hdr.levelsOffset);
+        sink.put(ctx.levels.mSlots.data(), sizeof(PriceLevel) * maxOrders);
+        sink.padTo(hdr.freeOrdersOffset);
+        sink.put(ctx.orders.mFree.data(), sizeof(Handle) * hdr.freeOrders);
+        sink.padTo(hdr.freeLevelsOffset);
+        sink.put(ctx.levels.mFree.data(), sizeof(Handle) * hdr.freeLevels);
+        sink.padTo(hdr.indexOffset);
+        sink.put(ctx.index.mTable.data(), sizeof(OrderIndex::Entry) * hdr.indexBuckets);
+
+        sink.padTo(varOffset);
+        for (const auto& book : core.mBooks) {
+            sink.put(book->mSymbol.data(), book->mSymbol.size());
+            sink.padTo(align(sink.pos()));
+            sink.put(book->mBids.data(), sizeof(Handle) * book->mBids.size());
+            sink.put(book->mAsks.data(), sizeof(Handle) * book->mAsks.size());
+        }
+
+        bool ok = sink.ok() && ::fsync(fd) == 0;
+        ok = (::close(fd) == 0) && ok;
+        return ok && ::rename(tmpPath, path) == 0;
+    }
+
+    void Snapshot::save(const EngineCore& core, uint64_t seqNo, const std::string& path) {
+        const std::string tmp = path + ".tmp";
+        if (!write(core, seqNo, tmp.c_str(), path.c_str())) {
+            ENG_THROW_ERRNO(errno, "Failed to write snapshot '%s'", path.c_str());
+        }
+    }
+
+    uint64_t Snapshot::load(const std::string& path, EngineCore& core) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            ENG_THROW_ERRNO(errno, "Failed to open snapshot '%s'", path.c_str());
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) == -1 || static_cast<uint64_t>(st.st_size) < sizeof(SnapshotHeader)) {
+            ::close(fd);
+            ENG_THROW("Snapshot '%s' is truncated", path.c_str());
+        }
+        const size_t size = static_cast<size_t>(st.st_size);
+        void* base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            ENG_THROW_ERRNO(errno, "Failed to map snapshot '%s'", path.c_str());
+        }
+
+        const char* bytes = static_cast<const char*>(base);
+        SnapshotHeader hdr;
+        std::memcpy(&hdr, bytes, sizeof(hdr));
+
+        BookContext& ctx = core.mCtx;
+        const char* error = nullptr;
+        if (std::strncmp(hdr.magic, MAGIC, sizeof(hdr.magic)) != 0 || hdr.version != VERSION) {
+            error = "bad signature or version";
+        }
+        else if (hdr.totalSize != size) {
+            error = "size mismatch";
+        }
+        else if (hdr.maxOrders != ctx.orders.capacity() || hdr.indexBuckets != ctx.index.buckets()) {
+            error = "capacity differs from configuration";
+        }
+        else if (!core.mBooks.empty() || ctx.orders.used() != 0) {
+            error = "target engine is not empty";
+        }
+        if (error) {
+            ::munmap(base, size);
+            ENG_THROW("Snapshot '%s' rejected: %s", path.c_str(), error);
+        }
+
+        // Slot arrays are copied as-is: handles need no fix-up
+        std::memcpy(ctx.orders.mSlots.data(), bytes + hdr.ordersOffset, sizeof(RestingOrder) * hdr.maxOrders);
+        std::memcpy(ctx.levels.mSlots.data(), bytes + hdr.levelsOffset, sizeof(PriceLevel) * hdr.maxOrders);
+        auto freeOrders = reinterpret_cast<const Handle*>(bytes + hdr.freeOrdersOffset);
+        ctx.orders.mFree.assign(freeOrders, freeOrders + hdr.freeOrders);
+        auto freeLevels = reinterpret_cast<const Handle*>(bytes + hdr.freeLevelsOffset);
+        ctx.levels.mFree.assign(freeLevels, freeLevels + hdr.freeLevels);
+        std::memcpy(ctx.index.mTable.data(), bytes + hdr.indexOffset, sizeof(OrderIndex::Entry) * hdr.indexBuckets);
+        ctx.index.mSize = hdr.indexSize;
+
+        auto books = reinterpret_cast<const SnapshotBook*>(bytes + hdr.booksOffset);
+        for (uint32_t i = 0; i < hdr.bookCount; ++i) {
+            const SnapshotBook& b = books[i];
+            uint32_t id = core.addBook(std::string(bytes + b.symbolOffset, b.symbolLen));
+            OrderBook& book = *core.mBooks[id];
+            auto bids = reinterpret_cast<const Handle*>(bytes + b.bidsOffset);
+            book.mBids.assign(bids, bids + b.bidCount);
+            auto asks = reinterpret_cast<const Handle*>(bytes + b.asksOffset);
+            book.mAsks.assign(asks, asks + b.askCount);
+        }
+
+        ::munmap(base, size);
+        LOG_INFO("Snapshot '%s' loaded SeqNo=%lu Books=%u Orders=%u",
+            path.c_str(), hdr.seqNo, hdr.bookCount, hdr.indexSize);
+        return hdr.seqNo;
+    }
+
+} // namespace Exchange::Matching
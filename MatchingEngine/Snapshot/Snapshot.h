@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "EngineCore.h"
+
+namespace Exchange::Matching {
+
+    /**
+     * @struct SnapshotHeader
+     * @brief First bytes of a snapshot file.
+     *
+     * @details
+     * The file only contains offsets from its start, never pointers, and every section
+     * starts on a cache line. Pools and the index are stored as the raw slot arrays: all
+     * links inside them are already handles (indices), so the bytes are valid wherever
+     * the file is mapped.
+     *
+     * Layout:
+     * @code
+     * SnapshotHeader
+     * SnapshotBook[bookCount]          @ booksOffset
+     * RestingOrder[maxOrders]          @ ordersOffset
+     * PriceLevel[maxOrders]            @ levelsOffset
+     * Handle[freeOrders]               @ freeOrdersOffset
+     * Handle[freeLevels]               @ freeLevelsOffset
+     * OrderIndex bucket[indexBuckets]  @ indexOffset
+     * per book: symbol bytes, bid level handles, ask level handles (see SnapshotBook)
+     * @endcode
+     */
+    struct SnapshotHeader {
+        char magic[16];
+        uint32_t version;
+        uint32_t maxOrders;
+        uint64_t seqNo;             // Last sequence number applied to the state
+        uint64_t indexBuckets;
+        uint32_t indexSize;
+        uint32_t bookCount;
+        uint32_t freeOrders;
+        uint32_t freeLevels;
+        uint64_t booksOffset;
+        uint64_t ordersOffset;
+        uint64_t levelsOffset;
+        uint64_t freeOrdersOffset;
+        uint64_t freeLevelsOffset;
+        uint64_t indexOffset;
+        uint64_t totalSize;
+    };
+
+    /**
+     * @struct SnapshotBook
+     * @brief One book of the snapshot, stored in book id order.
+     */
+    struct SnapshotBook {
+        uint64_t symbolOffset;
+        uint64_t bidsOffset;        // Handle[bidCount], same order as OrderBook::mBids
+        uint64_t asksOffset;        // Handle[askCount], same order as OrderBook::mAsks
+        uint32_t symbolLen;
+        uint32_t bidCount;
+        uint32_t askCount;
+        uint32_t reserved;
+    };
+
+    /**
+     * @class Snapshot
+     * @brief Saves and restores the complete state of an EngineCore (books, pools and
+     * order-id index).
+     *
+     * @details
+     * write() does not allocate, lock or log: it only issues open/write/fsync/rename
+     * system calls. This is what makes it safe to call from a child created by fork()
+     * in a multi-threaded process, where the child sees a copy-on-write image of the
+     * parent's memory frozen at the fork and the parent keeps matching.
+     */
+    class Snapshot {
+    public:
+        static constexpr const char* MAGIC = "ENG_SNAPSHOT";
+        static constexpr uint32_t VERSION = 1;
+
+        /**
+         * @brief Writes the state of `core` to `tmpPath`, then renames it to `path` so a
+         * reader never sees a partially written file.
+         * @return false on any I/O error (errno is preserved).
+         */
+        static bool write(const EngineCore& core, uint64_t seqNo, const char* tmpPath, const char* path) noexcept;
+
+        /** @brief Convenience wrapper, writes through "<path>.tmp". Throws on error. */
+        static void save(const EngineCore& core, uint64_t seqNo, const std::string& path);
+
+        /**
+         * @brief Maps a snapshot file and loads it into an empty core.
+         * @note `core` must have been built with the same maxOrders as the snapshot.
+         * @return Sequence number the snapshot was taken at: replay resumes after it.
+         */
+        static uint64_t load(const std::string& path, EngineCore& core);
+    };
+
+} // namespace Exchange::Matching
@@ -0,0 +1,13 @@
+#include "MatchingEngine.h"
+
+int main() {
+    try {
+        Exchange::Matching::MatchingEngine engine("MatchingEngine");
+        engine.start();
+    }
+    catch (Engine::EngException& ex) {
+        ex.log();
+        return 1;
+    }
+    return 0;
+}
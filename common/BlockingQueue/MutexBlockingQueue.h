@@ -1,5 +1,9 @@
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+
 #include "IBlockingQueue.h"
 #include "Exception.h"
 
@@ -15,7 +19,7 @@ namespace Exchange::Core {
     class MutexBlockingQueue : public IBlockingQueue<T> {
         std::queue<T> m_Queue; ///> Internal queue to hold elements 
         std::size_t m_Capacity; ///> Maximum capacity of the queue 
-        bool m_Closed; ///> Flag indicating if the queue is closed for pushing new elements
+        bool m_Closed{false}; ///> Flag indicating if the queue is closed for pushing new elements
 
         mutable std::mutex m_Mutex; ///> Mutex for synchronizing access to the queue
         std::condition_variable m_NotFullCv; ///> Condition variable to signal when the queue is not full
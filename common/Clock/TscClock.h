@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define EXCHANGE_HAS_TSC 1
+#endif
+
+namespace Exchange::Core {
+
+    /**
+     * @class TscClock
+     * @brief Nanosecond wall clock served from the CPU time stamp counter.
+     *
+     * @details
+     * At first use, or at calibrate(), the TSC is calibrated against CLOCK_REALTIME over CALIBRATION_NS:
+     * two (TSC, realtime) pairs give the tick rate, the first one the anchor. now() is
+     * then one rdtsc, a subtraction and a 64x64 multiply-shift, without a system call
+     * or vDSO page access.
+     *
+     * Without an invariant TSC (constant rate across P-states, synchronised between
+     * cores) the clock falls back to clock_gettime(CLOCK_REALTIME).
+     *
+     * @note The rate is fixed after calibration: NTP slewing of CLOCK_REALTIME is not
+     * followed, the drift is in the ppm range over the life of the process.
+     */
+    class TscClock {
+        static constexpr uint64_t CALIBRATION_NS = 10'000'000;
+        static constexpr unsigned SHIFT = 32;
+
+        bool mTsc{false};
+        uint64_t mTicks0{0};            ///> Anchor, TSC value
+        uint64_t mNs0{0};               ///> Anchor, realtime ns
+        uint64_t mMult{0};              ///> ns per tick << SHIFT
+        uint64_t mTicksPerSecond{1'000'000'000};
+
+        static uint64_t realtime() noexcept {
+            timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(ts.tv_nsec);
+        }
+
+        static bool invariantTsc() noexcept {
+#ifdef EXCHANGE_HAS_TSC
+            unsigned eax, ebx, ecx, edx;
+            if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) && eax >= 0x80000007
+                && __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+                return (edx & (1u << 8)) != 0;
+            }
+#endif
+            return false;
+        }
+
+        // Realtime read bracketed by two TSC reads, the TSC value is their midpoint
+        static void sample(uint64_t& ticks, uint64_t& ns) noexcept {
+            uint64_t best = UINT64_MAX;
+            for (int i = 0; i < 5; ++i) {
+                const uint64_t t0 = readTicks();
+                const uint64_t n = realtime();
+                const uint64_t t1 = readTicks();
+                if (t1 - t0 < best) {
+                    best = t1 - t0;
+                    ticks = t0 + (t1 - t0) / 2;
+                    ns = n;
+                }
+            }
+        }
+
+        TscClock() noexcept {
+            if (!invariantTsc()) {
+                return;
+            }
+            uint64_t t0, n0, t1, n1;
+            sample(t0, n0);
+            do {
+                sample(t1, n1);
+            } while (n1 - n0 < CALIBRATION_NS);
+            if (t1 <= t0) {
+                return;
+            }
+            mTicksPerSecond = static_cast<uint64_t>(
+                static_cast<unsigned __int128>(t1 - t0) * 1'000'000'000ULL / (n1 - n0));
+            mMult = static_cast<uint64_t>((static_cast<unsigned __int128>(n1 - n0) << SHIFT) / (t1 - t0));
+            mTicks0 = t0;
+            mNs0 = n0;
+            mTsc = true;
+        }
+
+    public:
+        TscClock(const TscClock&) = delete;
+        TscClock& operator=(const TscClock&) = delete;
+
+        static const TscClock& instance() noexcept {
+            static const TscClock clock;
+            return clock;
+        }
+
+        /** @brief Calibrates now (blocks ~CALIBRATION_NS), so that no hot thread pays for it. */
+        static void calibrate() noexcept {
+            instance();
+        }
+
+        /** @brief Raw counter (TSC, or realtime ns on the fallback path). */
+        static uint64_t readTicks() noexcept {
+#ifdef EXCHANGE_HAS_TSC
+            return __rdtsc();
+#else
+            return realtime();
+#endif
+        }
+
+        /** @brief Nanoseconds since epoch. */
+        static uint64_t now() noexcept {
+            const TscClock& c = instance();
+            return c.mTsc ? c.toNanos(readTicks()) : realtime();
+        }
+
+        /** @brief Converts a readTicks() value taken in this process to nanoseconds since epoch. */
+        uint64_t toNanos(uint64_t ticks) const noexcept {
+            if (!mTsc) {
+                return ticks;
+            }
+            const int64_t delta = static_cast<int64_t>(ticks - mTicks0);
+            const uint64_t magnitude = static_cast<uint64_t>(delta < 0 ? -delta : delta);
+            const uint64_t ns = static_cast<uint64_t>((static_cast<unsigned __int128>(magnitude) * mMult) >> SHIFT);
+            return delta < 0 ? mNs0 - ns : mNs0 + ns;
+        }
+
+        bool usesTsc() const noexcept { return mTsc; }
+        uint64_t ticksPerSecond() const noexcept { return mTicksPerSecond; }
+    };
+
+    /**
+     * @class DateCache
+     * @brief "YYYY-MM-DD HH:MM:SS" of a nanosecond timestamp, rebuilt (localtime_r +
+     * strftime) only when the second changes. One instance per thread.
+     */
+    class DateCache {
+        time_t mSecond{-1};
+        char mText[32]{};
+
+    public:
+        const char* format(uint64_t ns) noexcept {
+            const time_t sec = static_cast<time_t>(ns / 1'000'000'000ULL);
+            if (sec != mSecond) {
+                std::tm tm{};
+                localtime_r(&sec, &tm);
+                std::strftime(mText, sizeof(mText), "%Y-%m-%d %H:%M:%S", &tm);
+                mSecond = sec;
+            }
+            return mText;
+        }
+    };
+
+} // namespace Exchange::Core
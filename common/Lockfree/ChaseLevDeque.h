@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "ipc/const.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class ChaseLevDeque
+     * @brief Growable lock-free work-stealing deque (Chase & Lev, with the C11 memory
+     * orderings of Lê et al., PPoPP 2013).
+     *
+     * @details
+     * The owner thread pushes and pops at the bottom (LIFO, cache-warm); any other thread
+     * steals from the top (FIFO, oldest and usually largest work). Only the last element
+     * is contended: owner and thieves then race with a CAS on `mTop`.
+     * Elements are read racily by thieves before the CAS decides who owns them, so T must
+     * be trivially copyable: store pointers or indices. When full, the owner moves to an
+     * array twice as large; arrays replaced this way stay allocated until destruction since
+     * a thief may still be reading them.
+     */
+    template <typename T>
+    class ChaseLevDeque {
+        static_assert(std::is_trivially_copyable_v<T>, "ChaseLevDeque elements must be trivially copyable");
+
+        struct Array {
+            size_t mask;
+            std::unique_ptr<std::atomic<T>[]> slots;
+
+            explicit Array(size_t size) : mask(size - 1), slots(new std::atomic<T>[size]) {}
+            size_t size() const noexcept { return mask + 1; }
+            T get(int64_t i) const noexcept { return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed); }
+            void put(int64_t i, T v) noexcept { slots[static_cast<size_t>(i) & mask].store(v, std::memory_order_relaxed); }
+        };
+
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<int64_t> mTop{0};    ///> Next element to steal
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<int64_t> mBottom{0}; ///> Next free slot (owner)
+        std::atomic<Array*> mArray;
+        std::vector<std::unique_ptr<Array>> mArrays;                    ///> Current and retired arrays (owner)
+
+    public:
+        /** @brief Constructor, `capacity` is rounded up to a power of two. */
+        explicit ChaseLevDeque(size_t capacity = 256) {
+            size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            mArrays.push_back(std::make_unique<Array>(size));
+            mArray.store(mArrays.back().get(), std::memory_order_relaxed);
+        }
+
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+        /** @brief Owner only. Pushes at the bottom, grows the array if it is full. */
+        void push(T value) {
+            const int64_t b = mBottom.load(std::memory_order_relaxed);
+            const int64_t t = mTop.load(std::memory_order_acquire);
+            Array* a = mArray.load(std::memory_order_relaxed);
+            if (b - t > static_cast<int64_t>(a->mask)) {
+                auto bigger = std::make_unique<Array>(a->size() * 2);
+                for (int64_t i = t; i < b; ++i) {
+                    bigger->put(i, a->get(i));
+                }
+                a = bigger.get();
+                mArrays.push_back(std::move(bigger));
+                mArray.store(a, std::memory_order_release);
+            }
+            a->put(b, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            mBottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        /** @brief Owner only. Pops the most recently pushed element. */
+        std::optional<T> pop() {
+            const int64_t b = mBottom.load(std::memory_order_relaxed) - 1;
+            Array* a = mArray.load(std::memory_order_relaxed);
+            mBottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = mTop.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                // Empty
+                mBottom.store(b + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            T value = a->get(b);
+            if (t == b) {
+                // Last element: race the thieves for it
+                const bool won = mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                mBottom.store(b + 1, std::memory_order_relaxed);
+                if (!won) {
+                    return std::nullopt;
+                }
+            }
+            return value;
+        }
+
+        /**
+         * @brief Any thread. Takes the oldest element.
+         * @return nullopt if the deque is empty or another thread won the element.
+         */
+        std::optional<T> steal() {
+            int64_t t = mTop.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = mBottom.load(std::memory_order_acquire);
+            if (t >= b) {
+                return std::nullopt;
+            }
+            Array* a = mArray.load(std::memory_order_acquire);
+            T value = a->get(t);
+            if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        /** @brief Approximate number of elements. */
+        size_t size() const noexcept {
+            const int64_t n = mBottom.load(std::memory_order_relaxed) - mTop.load(std::memory_order_relaxed);
+            return n > 0 ? static_cast<size_t>(n) : 0;
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+    };
+
+} // namespace Exchange::Core
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Exception.h"
+#include "ipc/const.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class MpscRing
+     * @brief Bounded lock-free multi-producer / single-consumer ring.
+     *
+     * @details
+     * Each slot carries a sequence number (D. Vyukov's bounded queue): a slot at position
+     * `pos` is free for the producer when its sequence equals `pos` and readable by the
+     * consumer when it equals `pos + 1`. Producers claim a position with one CAS on
+     * `mTail`, move the value in and publish it with a release store of the sequence; the
+     * consumer never touches `mTail`. The consumer owns `mHead`, so popping is a load, a
+     * move and a store: no read-modify-write at all.
+     * A producer interrupted between claim and publish delays the consumer (it sees the
+     * slot as empty) but never blocks other producers.
+     * Indices grow monotonically and are masked, so capacity is rounded up to a power of two.
+     */
+    template <typename T>
+    class MpscRing {
+        struct Slot {
+            std::atomic<size_t> seq;
+            T value;
+        };
+
+        std::unique_ptr<Slot[]> mSlots;
+        size_t mMask;
+
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<size_t> mTail{0}; ///> Next position to claim (producers)
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<size_t> mHead{0}; ///> Next position to read (consumer)
+
+    public:
+        /** @brief Constructor */
+        explicit MpscRing(size_t capacity) {
+            if (capacity == 0) {
+                ENG_THROW("MpscRing capacity must be > 0");
+            }
+            size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            mSlots = std::make_unique<Slot[]>(size);
+            for (size_t i = 0; i < size; ++i) {
+                mSlots[i].seq.store(i, std::memory_order_relaxed);
+            }
+            mMask = size - 1;
+        }
+
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        /**
+         * @brief Producer side, any thread. Moves `value` into the ring.
+         * @return false if the ring is full (value is left untouched).
+         */
+        bool tryPush(T&& value) {
+            size_t pos = mTail.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = mSlots[pos & mMask];
+                const size_t seq = slot.seq.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        slot.value = std::move(value);
+                        slot.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0) {
+                    return false;   // The slot still holds the value of the previous lap
+                }
+                else {
+                    pos = mTail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Consumer side. Moves the oldest element into `out`.
+         * @return false if the ring is empty.
+         */
+        bool tryPop(T& out) {
+            const size_t head = mHead.load(std::memory_order_relaxed);
+            Slot& slot = mSlots[head & mMask];
+            if (slot.seq.load(std::memory_order_acquire) != head + 1) {
+                return false;
+            }
+            out = std::move(slot.value);
+            slot.seq.store(head + mMask + 1, std::memory_order_release);
+            mHead.store(head + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /** @brief Consumer side. true if no published element is waiting. */
+        bool empty() const noexcept {
+            const size_t head = mHead.load(std::memory_order_relaxed);
+            return mSlots[head & mMask].seq.load(std::memory_order_acquire) != head + 1;
+        }
+
+        /** @brief Approximate number of queued elements. */
+        size_t size() const noexcept {
+            const size_t head = mHead.load(std::memory_order_relaxed);
+            const size_t tail = mTail.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        size_t capacity() const noexcept { return mMask + 1; }
+    };
+
+} // namespace Exchange::Core
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "Exception.h"
+#include "ipc/const.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class SpscRing
+     * @brief Bounded lock-free single-producer / single-consumer ring for in-process
+     * thread hand-off.
+     *
+     * @details
+     * Same protocol as the shared memory ring in Ipc::Producer/Consumer: the producer
+     * owns `mTail`, the consumer owns `mHead`, each publishes with release and observes
+     * the other side with acquire. In addition each side keeps a cached copy of the other
+     * side's index so the shared cache line is only touched when the ring looks full
+     * (producer) or empty (consumer).
+     * Indices grow monotonically and are masked, so capacity is rounded up to a power of two.
+     */
+    template <typename T>
+    class SpscRing {
+        std::vector<T> mSlots;
+        size_t mMask;
+
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<size_t> mHead{0}; ///> Next slot to read (consumer)
+        size_t mCachedTail{0};                                       ///> Consumer's last view of mTail
+
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<size_t> mTail{0}; ///> Next slot to write (producer)
+        size_t mCachedHead{0};                                       ///> Producer's last view of mHead
+
+    public:
+        /** @brief Constructor */
+        explicit SpscRing(size_t capacity) {
+            if (capacity == 0) {
+                ENG_THROW("SpscRing capacity must be > 0");
+            }
+            size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            mSlots.resize(size);
+            mMask = size - 1;
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        /**
+         * @brief Producer side. Moves `value` into the ring.
+         * @return false if the ring is full (value is left untouched).
+         */
+        bool tryPush(T&& value) {
+            const size_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mCachedHead > mMask) {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+                if (tail - mCachedHead > mMask) {
+                    return false;
+                }
+            }
+            mSlots[tail & mMask] = std::move(value);
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool tryPush(const T& value) {
+            T copy(value);
+            return tryPush(std::move(copy));
+        }
+
+        /**
+         * @brief Producer side. Copies up to `count` elements and publishes them with a
+         * single release store, the consumer sees the batch at once.
+         * @return Number of elements pushed, less than `count` if the ring filled up.
+         */
+        size_t tryPushBulk(const T* values, size_t count) {
+            const size_t tail = mTail.load(std::memory_order_relaxed);
+            size_t room = mMask + 1 - (tail - mCachedHead);
+            if (room < count) {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+                room = mMask + 1 - (tail - mCachedHead);
+            }
+            const size_t n = std::min(room, count);
+            for (size_t i = 0; i < n; ++i) {
+                mSlots[(tail + i) & mMask] = values[i];
+            }
+            if (n > 0) {
+                mTail.store(tail + n, std::memory_order_release);
+            }
+            return n;
+        }
+
+        /**
+         * @brief Consumer side. Moves the oldest element into `out`.
+         * @return false if the ring is empty.
+         */
+        bool tryPop(T& out) {
+            const size_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mCachedTail) {
+                mCachedTail = mTail.load(std::memory_order_acquire);
+                if (head == mCachedTail) {
+                    return false;
+                }
+            }
+            out = std::move(mSlots[head & mMask]);
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Consumer side. Peeks at the oldest element without consuming it.
+         * @return nullptr if the ring is empty.
+         */
+        T* front() {
+            const size_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mCachedTail) {
+                mCachedTail = mTail.load(std::memory_order_acquire);
+                if (head == mCachedTail) {
+                    return nullptr;
+                }
+            }
+            return &mSlots[head & mMask];
+        }
+
+        /** @brief Consumer side. Drops the element returned by front(). */
+        void pop() {
+            mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /** @brief Approximate number of queued elements (exact when called by either side). */
+        size_t size() const noexcept {
+            return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+        size_t capacity() const noexcept { return mMask + 1; }
+    };
+
+} // namespace Exchange::Core
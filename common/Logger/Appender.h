@@ -1,44 +1,338 @@
 #pragma once
-#include "Log.h"
 
-namespace Exchange::Core {
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Linux
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef EXCHANGE_WITH_SQLITE
+#include <sqlite3.h>
+#endif
 
+#include "LogRecord.h"
+#include "String.h"
 
+namespace Exchange::Core {
+
+    /**
+     * @class IAppender
+     * @brief Output of the logger. Only ever called from the logger thread, so
+     * implementations need no locking and may block without stalling producers.
+     */
     class IAppender {
     public:
         virtual ~IAppender() = default;
-        virtual void append(const Log& log) = 0;
+
+        /**
+         * @param line Formatted text line ending with '\n', empty when wantsLine() is false.
+         * The line is shared by every appender of the record, it is formatted once.
+         */
+        virtual void append(const LogRecord& record, std::string_view line) = 0;
+
+        /** @brief End of a polling round: hand buffered data to the OS. */
+        virtual void flush() {}
+
+        /** @brief false if the appender only uses the raw record (saves the formatting). */
+        virtual bool wantsLine() const { return true; }
+
+        /** @brief Failure since the last call, empty if none. The backend logs it as a record. */
+        virtual std::string takeError() { return {}; }
     };
 
 
+    /**
+     * @class ConsoleAppender
+     * @brief Writes lines to stdout, one fwrite per polling round.
+     */
     class ConsoleAppender : public IAppender {
-        void append(const Log& log) override {
-            std::printf(log.toString());
+        static constexpr size_t BUFFER = 64 * 1024;
+        std::unique_ptr<char[]> mBuffer{new char[BUFFER]};
+        size_t mLen{0};
+
+    public:
+        ~ConsoleAppender() override { flush(); }
+
+        void append(const LogRecord&, std::string_view line) override {
+            if (mLen + line.size() > BUFFER) {
+                flush();
+            }
+            if (line.size() > BUFFER) {
+                std::fwrite(line.data(), 1, line.size(), stdout);
+                return;
+            }
+            std::memcpy(mBuffer.get() + mLen, line.data(), line.size());
+            mLen += line.size();
+        }
+
+        void flush() override {
+            if (mLen > 0) {
+                std::fwrite(mBuffer.get(), 1, mLen, stdout);
+                mLen = 0;
+            }
+            std::fflush(stdout);
         }
     };
 
+    /**
+     * @class FileAppender
+     * @brief Appends lines to "<path>/<name>.log" in large blocks, with size and time
+     * based rotation.
+     *
+     * @details
+     * Lines are collected in a BUFFER sized block which is written with one write()
+     * when it fills up or at the end of a polling round. Rotation renames
+     * "<name>.log" to "<name>.log.1" (older files shift up to keepFiles, the oldest is
+     * dropped) and reopens a fresh file; it happens on the logger thread, between two
+     * records, so producers never wait for it.
+     */
     class FileAppender : public IAppender {
+        static constexpr size_t BUFFER = 256 * 1024;
+
         String path;
         String name;
+        std::string mFile;
+        uint64_t mMaxBytes;
+        uint32_t mRotateSeconds;
+        uint32_t mKeepFiles;
+
+        int mFd{-1};
+        int mError{0};
+        uint64_t mSize{0};                  ///> Bytes in the current file, buffered included
+        uint64_t mOpenedSecond{0};          ///> Timestamp (s) of the first record of the current file
+        std::unique_ptr<char[]> mBuffer{new char[BUFFER]};
+        size_t mLen{0};
+
+        void open() {
+            mFd = ::open(mFile.c_str(), O_CREAT | O_WRONLY | O_APPEND | O_CLOEXEC, 0644);
+            mError = (mFd == -1) ? errno : 0;
+            struct stat st{};
+            mSize = (mFd != -1 && ::fstat(mFd, &st) == 0) ? static_cast<uint64_t>(st.st_size) : 0;
+            mOpenedSecond = 0;
+        }
+
+        void writeBuffer() {
+            write(mBuffer.get(), mLen);
+            mLen = 0;
+        }
+
+        void write(const char* p, size_t left) {
+            while (mFd != -1 && left > 0) {
+                ssize_t n = ::write(mFd, p, left);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    mError = errno;         // Lines are lost, the appender keeps going
+                    break;
+                }
+                p += n;
+                left -= static_cast<size_t>(n);
+            }
+        }
+
+        void rotate() {
+            writeBuffer();
+            if (mFd != -1) {
+                ::close(mFd);
+                mFd = -1;
+            }
+            if (mKeepFiles == 0) {
+                ::unlink(mFile.c_str());
+            }
+            for (uint32_t i = mKeepFiles; i > 0; --i) {
+                const std::string from = (i == 1) ? mFile : mFile + "." + std::to_string(i - 1);
+                ::rename(from.c_str(), (mFile + "." + std::to_string(i)).c_str());
+            }
+            open();
+        }
+
     public:
-        /** @brief Constructor */
-        FileAppender(String path, String name) 
-            : path(std::move(path)), name(std::move(name)) {}
-        
-        void append(const Log& log) override {
-            // todo
+        /**
+         * @brief Constructor, opens (creates) the file. See error() for the outcome.
+         * @param maxBytes Rotate once the file would exceed this size, 0 = never.
+         * @param rotateSeconds Rotate when the first record of the file is older, 0 = never.
+         * @param keepFiles Number of rotated files kept next to the live one.
+         */
+        FileAppender(String path, String name, uint64_t maxBytes = 0, uint32_t rotateSeconds = 0,
+                     uint32_t keepFiles = 5)
+            : path(std::move(path)), name(std::move(name)),
+              mMaxBytes(maxBytes), mRotateSeconds(rotateSeconds), mKeepFiles(keepFiles) {
+            ::mkdir(this->path.get(), 0755);
+            mFile = this->path.toString() + "/" + this->name.toString() + ".log";
+            open();
+        }
+
+        ~FileAppender() override {
+            writeBuffer();
+            if (mFd != -1) {
+                ::close(mFd);
+            }
+        }
+
+        /** @brief errno of the last failed open/write, 0 if none. */
+        int error() const { return mError; }
+        const std::string& file() const { return mFile; }
+
+        void append(const LogRecord& record, std::string_view line) override {
+            const uint64_t second = record.timestamp / 1000000000ULL;
+            if (mOpenedSecond == 0) {
+                mOpenedSecond = second;
+            }
+            const bool full = mMaxBytes > 0 && mSize > 0 && mSize + line.size() > mMaxBytes;
+            const bool expired = mRotateSeconds > 0 && second >= mOpenedSecond + mRotateSeconds;
+            if (full || expired) {
+                rotate();
+                mOpenedSecond = second;
+            }
+            if (mLen + line.size() > BUFFER) {
+                writeBuffer();
+            }
+            mSize += line.size();
+            if (line.size() > BUFFER) {
+                write(line.data(), line.size());       // Keeps the order: the buffer is empty
+                return;
+            }
+            std::memcpy(mBuffer.get() + mLen, line.data(), line.size());
+            mLen += line.size();
+        }
+
+        void flush() override {
+            writeBuffer();
         }
     };
 
 
+    /**
+     * @class DatabaseAppender
+     * @brief Stores records as rows of a table in a local SQLite database file.
+     *
+     * @details
+     * Stand-in for a remote log database: same table layout, no server. Rows of one
+     * polling round are inserted in a single transaction through a prepared statement.
+     * Table: (timestamp_ns INTEGER, level TEXT, file TEXT, line INTEGER, function TEXT,
+     * message TEXT). Requires a build with SQLite (EXCHANGE_WITH_SQLITE), error() tells
+     * otherwise.
+     */
     class DatabaseAppender : public IAppender {
-        Core::String url;
         Core::String dbName;
-        Core::String password;
         Core::String tableName;
+        std::string mError;
+#ifdef EXCHANGE_WITH_SQLITE
+        sqlite3* mDb{nullptr};
+        sqlite3_stmt* mInsert{nullptr};
+        bool mInTransaction{false};
+        uint64_t mRows{0};              ///> Rows inserted by the open transaction
+        uint64_t mLost{0};              ///> Rows not stored since the last takeError()
+        std::string mLastFailure;       ///> Reported once until a write succeeds again
+        std::string mFailure;
+
+        void failed(uint64_t rows) {
+            mLost += rows;
+            const char* msg = sqlite3_errmsg(mDb);
+            if (mLastFailure != msg) {
+                mLastFailure = msg;
+                mFailure = mLastFailure;
+            }
+        }
+#endif
+
     public:
-        void append(const Log& log) override {
-            // todo
+        /** @param dbName Path of the database file, created if missing. */
+        DatabaseAppender(Core::String dbName, Core::String tableName = "logs")
+            : dbName(std::move(dbName)), tableName(std::move(tableName)) {
+#ifdef EXCHANGE_WITH_SQLITE
+            if (sqlite3_open(this->dbName.get(), &mDb) != SQLITE_OK) {
+                mError = sqlite3_errmsg(mDb);
+                return;
+            }
+            const std::string table = this->tableName.toString();
+            const std::string create = "CREATE TABLE IF NOT EXISTS " + table +
+                " (timestamp_ns INTEGER, level TEXT, file TEXT, line INTEGER, function TEXT, message TEXT)";
+            const std::string insert = "INSERT INTO " + table + " VALUES (?, ?, ?, ?, ?, ?)";
+            if (sqlite3_exec(mDb, "PRAGMA journal_mode=WAL", nullptr, nullptr, nullptr) != SQLITE_OK
+                || sqlite3_exec(mDb, create.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK
+                || sqlite3_prepare_v2(mDb, insert.c_str(), -1, &mInsert, nullptr) != SQLITE_OK) {
+                mError = sqlite3_errmsg(mDb);
+            }
+#else
+            mError = "built without SQLite";
+#endif
+        }
+
+        ~DatabaseAppender() override {
+#ifdef EXCHANGE_WITH_SQLITE
+            flush();
+            sqlite3_finalize(mInsert);
+            sqlite3_close(mDb);
+#endif
+        }
+
+        /** @brief Empty if the database is usable. */
+        const std::string& error() const { return mError; }
+
+        bool wantsLine() const override { return false; }
+
+        void append(const LogRecord& record, std::string_view) override {
+#ifdef EXCHANGE_WITH_SQLITE
+            if (!mInsert) {
+                return;
+            }
+            if (!mInTransaction) {
+                mInTransaction = sqlite3_exec(mDb, "BEGIN", nullptr, nullptr, nullptr) == SQLITE_OK;
+            }
+            char message[1024];
+            const size_t len = LogFormatter::format(record, message, sizeof(message));
+            const LogSite& site = *record.site;
+            sqlite3_bind_int64(mInsert, 1, static_cast<sqlite3_int64>(record.timestamp));
+            sqlite3_bind_text(mInsert, 2, LogFormatter::levelName(site.level), -1, SQLITE_STATIC);
+            sqlite3_bind_text(mInsert, 3, site.file, -1, SQLITE_STATIC);
+            sqlite3_bind_int(mInsert, 4, static_cast<int>(site.line));
+            sqlite3_bind_text(mInsert, 5, site.func, -1, SQLITE_STATIC);
+            sqlite3_bind_text(mInsert, 6, message, static_cast<int>(len), SQLITE_TRANSIENT);
+            if (sqlite3_step(mInsert) == SQLITE_DONE) {
+                ++mRows;
+                mLastFailure.clear();
+            }
+            else {
+                failed(1);
+            }
+            sqlite3_reset(mInsert);
+#else
+            (void)record;
+#endif
+        }
+
+        void flush() override {
+#ifdef EXCHANGE_WITH_SQLITE
+            if (mInTransaction) {
+                if (sqlite3_exec(mDb, "COMMIT", nullptr, nullptr, nullptr) != SQLITE_OK) {
+                    failed(mRows);
+                    sqlite3_exec(mDb, "ROLLBACK", nullptr, nullptr, nullptr);
+                }
+                mInTransaction = false;
+                mRows = 0;
+            }
+#endif
+        }
+
+        std::string takeError() override {
+#ifdef EXCHANGE_WITH_SQLITE
+            std::string error;
+            if (!mFailure.empty()) {
+                error = "database " + dbName.toString() + ": " + mFailure
+                      + " (" + std::to_string(mLost) + " rows lost)";
+            }
+            mFailure.clear();
+            mLost = 0;
+            return error;
+#else
+            return {};
+#endif
         }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Linux
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LogRecord.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @struct BinaryLogHeader
+     * @brief First bytes of a binary log file.
+     *
+     * @details
+     * The header is followed by a stream of entries, each starting with a BinaryLogEntry
+     * tag byte. A site entry describes a LOG_* call site (format, file, function, line,
+     * level) and is written once, before the first record that refers to it. A record
+     * entry only holds the site id, the timestamp and the packed arguments exactly as
+     * captured in LogRecord::args. A zero tag marks the end of the data, the file may
+     * still be mapped and zero-filled past it.
+     *
+     * Record timestamps are converted with `ns = anchorNs + (ts - anchorTicks) * 1e9 / ticksPerSecond`.
+     */
+    struct BinaryLogHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t ticksPerSecond;
+        uint64_t anchorTicks;
+        uint64_t anchorNs;          // Nanoseconds since epoch at anchorTicks
+    };
+
+    enum class BinaryLogEntry : uint8_t {
+        END    = 0,
+        SITE   = 1,     // uint32 id, uint32 line, uint8 level, uint16 fmtLen, fileLen, funcLen, strings
+        RECORD = 2      // uint32 id, uint64 timestamp, uint8 argCount, uint16 argBytes, args
+    };
+
+    static constexpr char BINARY_LOG_MAGIC[8] = {'E', 'X', 'B', 'L', 'O', 'G', '0', '1'};
+    static constexpr uint32_t BINARY_LOG_VERSION = 1;
+
+    /**
+     * @class BinaryLogWriter
+     * @brief Appends LogRecords to a memory mapped binary log file (logger thread only).
+     *
+     * @details
+     * The file is grown and mapped in CHUNK steps, so appending is a memcpy into the
+     * page cache, without a system call per batch. close() truncates the file to the
+     * bytes actually written.
+     */
+    class BinaryLogWriter {
+        static constexpr size_t CHUNK = 16 * 1024 * 1024;
+        static constexpr size_t RECORD_HEADER = 1 + 4 + 8 + 1 + 2;
+
+        int mFd{-1};
+        char* mMap{nullptr};
+        size_t mMapped{0};
+        size_t mPos{0};
+        std::vector<bool> mKnownSites;
+
+        bool reserve(size_t bytes) noexcept {
+            if (mPos + bytes + 1 <= mMapped) {      // Keep room for the END tag
+                return true;
+            }
+            const size_t size = mMapped + CHUNK;
+            if (::ftruncate(mFd, static_cast<off_t>(size)) == -1) {
+                return false;
+            }
+            void* map = ::mremap(mMap, mMapped, size, MREMAP_MAYMOVE);
+            if (map == MAP_FAILED) {
+                return false;
+            }
+            mMap = static_cast<char*>(map);
+            mMapped = size;
+            return true;
+        }
+
+        template <typename V>
+        void put(V value) noexcept {
+            std::memcpy(mMap + mPos, &value, sizeof(V));
+            mPos += sizeof(V);
+        }
+
+        void putBytes(const char* s, size_t n) noexcept {
+            std::memcpy(mMap + mPos, s, n);
+            mPos += n;
+        }
+
+        bool putSite(const LogSite& site) noexcept {
+            const uint16_t fmtLen = static_cast<uint16_t>(std::strlen(site.fmt ? site.fmt : ""));
+            const uint16_t fileLen = static_cast<uint16_t>(std::strlen(site.file ? site.file : ""));
+            const uint16_t funcLen = static_cast<uint16_t>(std::strlen(site.func ? site.func : ""));
+            if (!reserve(1 + 4 + 4 + 1 + 3 * 2 + fmtLen + fileLen + funcLen)) {
+                return false;
+            }
+            put(BinaryLogEntry::SITE);
+            put(site.id);
+            put(site.line);
+            put(static_cast<uint8_t>(site.level));
+            put(fmtLen);
+            put(fileLen);
+            put(funcLen);
+            putBytes(site.fmt, fmtLen);
+            putBytes(site.file, fileLen);
+            putBytes(site.func, funcLen);
+            return true;
+        }
+
+    public:
+        BinaryLogWriter() = default;
+        BinaryLogWriter(const BinaryLogWriter&) = delete;
+        BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+        ~BinaryLogWriter() { close(); }
+
+        bool isOpen() const noexcept { return mMap != nullptr; }
+        size_t size() const noexcept { return mPos; }
+
+        /** @brief Creates (truncates) `path` and writes the header. @return false with errno set. */
+        bool open(const std::string& path, const BinaryLogHeader& clock) {
+            close();
+            mFd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+            if (mFd == -1) {
+                return false;
+            }
+            void* map = MAP_FAILED;
+            if (::ftruncate(mFd, static_cast<off_t>(CHUNK)) == 0) {
+                map = ::mmap(nullptr, CHUNK, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+            }
+            if (map == MAP_FAILED) {
+                const int err = errno;
+                ::close(mFd);
+                mFd = -1;
+                errno = err;
+                return false;
+            }
+            mMap = static_cast<char*>(map);
+            mMapped = CHUNK;
+            mPos = 0;
+            mKnownSites.clear();
+
+            BinaryLogHeader hdr = clock;
+            std::memcpy(hdr.magic, BINARY_LOG_MAGIC, sizeof(hdr.magic));
+            hdr.version = BINARY_LOG_VERSION;
+            put(hdr);
+            return true;
+        }
+
+        /**
+         * @brief Appends one record, preceded by its site on first use.
+         * @return false if the file could not grow; the writer is closed then.
+         */
+        bool append(const LogRecord& r) noexcept {
+            if (!isOpen()) {
+                return false;
+            }
+            const LogSite& site = *r.site;
+            if (site.id >= mKnownSites.size()) {
+                mKnownSites.resize(site.id + 1, false);
+            }
+            if (!mKnownSites[site.id]) {
+                if (!putSite(site)) {
+                    close();
+                    return false;
+                }
+                mKnownSites[site.id] = true;
+            }
+            if (!reserve(RECORD_HEADER + r.argBytes)) {
+                close();
+                return false;
+            }
+            put(BinaryLogEntry::RECORD);
+            put(site.id);
+            put(r.timestamp);
+            put(r.argCount);
+            put(r.argBytes);
+            putBytes(r.args, r.argBytes);
+            return true;
+        }
+
+        /** @brief Unmaps the file and cuts it to the written size. */
+        void close() noexcept {
+            if (mMap) {
+                ::munmap(mMap, mMapped);
+                mMap = nullptr;
+            }
+            if (mFd != -1) {
+                if (::ftruncate(mFd, static_cast<off_t>(mPos)) == -1) {
+                    // Zero tail is read as END, the file stays valid
+                }
+                ::close(mFd);
+                mFd = -1;
+            }
+            mMapped = 0;
+        }
+    };
+
+    /**
+     * @class BinaryLogReader
+     * @brief Maps a binary log file and replays its records as LogRecords.
+     *
+     * @details
+     * The sites are rebuilt from the file, so
+     * the LogRecords returned by next() can be rendered with LogFormatter as if they
+     * came from the live process. Timestamps are converted to nanoseconds since epoch.
+     */
+    class BinaryLogReader {
+        struct Site {
+            LogSite site;
+            std::string fmt;
+            std::string file;
+            std::string func;
+        };
+
+        const char* mBase{nullptr};
+        size_t mSize{0};
+        size_t mPos{0};
+        BinaryLogHeader mHeader{};
+        std::vector<std::unique_ptr<Site>> mSites;
+
+        template <typename V>
+        bool get(V& value) noexcept {
+            if (mPos + sizeof(V) > mSize) {
+                return false;
+            }
+            std::memcpy(&value, mBase + mPos, sizeof(V));
+            mPos += sizeof(V);
+            return true;
+        }
+
+        bool getString(std::string& out, uint16_t n) {
+            if (mPos + n > mSize) {
+                return false;
+            }
+            out.assign(mBase + mPos, n);
+            mPos += n;
+            return true;
+        }
+
+        bool readSite() {
+            uint32_t id;
+            auto s = std::make_unique<Site>();
+            uint8_t level;
+            uint16_t fmtLen, fileLen, funcLen;
+            if (!get(id) || !get(s->site.line) || !get(level) || !get(fmtLen) || !get(fileLen) || !get(funcLen)
+                || !getString(s->fmt, fmtLen) || !getString(s->file, fileLen) || !getString(s->func, funcLen)) {
+                return false;
+            }
+            s->site.fmt = s->fmt.c_str();
+            s->site.file = s->file.c_str();
+            s->site.func = s->func.c_str();
+            s->site.level = static_cast<LogLevel>(level);
+            s->site.id = id;
+            if (id >= mSites.size()) {
+                mSites.resize(id + 1);
+            }
+            mSites[id] = std::move(s);
+            return true;
+        }
+
+    public:
+        BinaryLogReader() = default;
+        BinaryLogReader(const BinaryLogReader&) = delete;
+        BinaryLogReader& operator=(const BinaryLogReader&) = delete;
+        ~BinaryLogReader() {
+            if (mBase) {
+                ::munmap(const_cast<char*>(mBase), mSize);
+            }
+        }
+
+        /** @brief Maps `path` and checks its header. @return nullptr or an error message. */
+        const char* open(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1) {
+                return std::strerror(errno);
+            }
+            struct stat st{};
+            if (::fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < sizeof(BinaryLogHeader)) {
+                ::close(fd);
+                return "file is truncated";
+            }
+            void* map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED) {
+                return std::strerror(errno);
+            }
+            mBase = static_cast<const char*>(map);
+            mSize = static_cast<size_t>(st.st_size);
+            get(mHeader);
+            if (std::memcmp(mHeader.magic, BINARY_LOG_MAGIC, sizeof(mHeader.magic)) != 0
+                || mHeader.version != BINARY_LOG_VERSION || mHeader.ticksPerSecond == 0) {
+                return "not a binary log file or unsupported version";
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Reads the next record into `r`. Its site stays valid while the reader lives.
+         * @return false at the end of the data (or on a malformed entry).
+         */
+        bool next(LogRecord& r) {
+            BinaryLogEntry tag;
+            while (get(tag)) {
+                if (tag == BinaryLogEntry::SITE) {
+                    if (!readSite()) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (tag != BinaryLogEntry::RECORD) {
+                    return false;
+                }
+                uint32_t id;
+                uint64_t ticks;
+                if (!get(id) || !get(ticks) || !get(r.argCount) || !get(r.argBytes)
+                    || id >= mSites.size() || !mSites[id] || r.argBytes > LogRecord::ARG_BYTES || mPos + r.argBytes > mSize) {
+                    return false;
+                }
+                std::memcpy(r.args, mBase + mPos, r.argBytes);
+                mPos += r.argBytes;
+
+                r.site = &mSites[id]->site;
+                const int64_t delta = static_cast<int64_t>(ticks - mHeader.anchorTicks);
+                r.timestamp = mHeader.anchorNs + static_cast<uint64_t>(
+                    static_cast<long double>(delta) * 1e9L / static_cast<long double>(mHeader.ticksPerSecond));
+                return true;
+            }
+            return false;
+        }
+    };
+
+} // namespace Exchange::Core
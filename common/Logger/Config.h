@@ -1,28 +1,54 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <memory>
+#include <optional>
 #include <vector>
 #include "Appender.h"
 #include "Filter.h"
+#include "Logger.h"
 
 namespace Exchange::Core {
 
+    /**
+     * @class Config
+     * @brief Logger configuration: appenders with their filter chains and the runtime
+     * level of each module. Nothing changes until apply().
+     */
     class Config {
-        std::map<uint16_t, IAppender*> mAppenders;
-        std::map<uint16_t, std::vector<IFilter*>> mFilters;
+        std::vector<LogRoute> mAppenders;
+        std::array<std::optional<LogLevel>, static_cast<size_t>(LogModule::COUNT)> mLevels;
     public:
         Config() = default;
-        void addAppender(IAppender* appender) {
-            mAppenders.insert({mAppenders.size(),std::move(appender)});
+        void addAppender(std::shared_ptr<IAppender> appender) {
+            mAppenders.push_back({std::move(appender), {}});
         }
-        void addAppender(IAppender* appender, IFilter* filter) {
-            mAppenders.insert({mAppenders.size(),std::move(appender)});
-            mFilters.insert({mAppenders.size()-1, std::vector<IFilter*>{filter}});
+        void addAppender(std::shared_ptr<IAppender> appender, std::shared_ptr<IFilter> filter) {
+            mAppenders.push_back({std::move(appender), {std::move(filter)}});
         }
-        void addAppender(IAppender* appender, std::vector<IFilter*> filters) {
-            mAppenders.insert({mAppenders.size(),std::move(appender)});
-            mFilters.insert({mAppenders.size()-1, filters});
+        void addAppender(std::shared_ptr<IAppender> appender, std::vector<std::shared_ptr<IFilter>> filters) {
+            mAppenders.push_back({std::move(appender), std::move(filters)});
+        }
+
+        /** @brief Runtime minimum level of one module, modules not set keep their level. */
+        void setLevel(LogModule module, LogLevel level) {
+            mLevels[static_cast<size_t>(module)] = level;
+        }
+
+        /**
+         * @brief Installs the configuration in the logger. The appenders replace the
+         * current ones (the default console) unless none were added.
+         */
+        void apply() const {
+            for (size_t i = 0; i < mLevels.size(); ++i) {
+                if (mLevels[i]) {
+                    Logger::setLevel(static_cast<LogModule>(i), *mLevels[i]);
+                }
+            }
+            if (!mAppenders.empty()) {
+                LogBackend::instance().setAppenders(mAppenders);
+            }
         }
     };
     
-}
\ No newline at end of file
+}
@@ -1,14 +1,19 @@
 #pragma once
 
-#include "Log.h"
+#include "LogRecord.h"
 
 
 namespace Exchange::Core {
 
+    /**
+     * @class IFilter
+     * @brief Decides whether an appender receives a record (logger thread only).
+     */
     class IFilter {
     public:
         virtual ~IFilter() = default;
-        virtual bool filter(const Log& log) = 0;
+        /** @return true to keep the record. */
+        virtual bool filter(const LogRecord& record) = 0;
     };
 
 
@@ -17,8 +22,8 @@ namespace Exchange::Core {
     public:
         /** @brief Constructor */
         LevelFilter(LogLevel minLevel): minLevel(minLevel) {}
-        bool filter(const Log& log) override {
-            return log.getLevel() > minLevel;
+        bool filter(const LogRecord& record) override {
+            return record.site->level >= minLevel;
         }
     };
 };
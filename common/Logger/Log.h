@@ -24,6 +24,19 @@ namespace Exchange::Core {
         FATAL
     };
 
+    /**
+     * @enum LogModule
+     * @brief Component a log call belongs to, each has its own runtime level.
+     */
+    enum class LogModule : uint8_t {
+        CORE,
+        GATEWAY,
+        IPC,
+        SEQUENCER,
+        ENGINE,
+        COUNT
+    };
+
     class LogHelper {
     public:
         static std::string levelToString(LogLevel level) {
@@ -37,47 +50,40 @@ namespace Exchange::Core {
             }
             return levelToString(LogLevel::INFO); // default
         }
-    };
-
-    class Log {
-        std::tm mTimestamp;
-        LogLevel mLevel;
-        Core::String mMessage;
-        Core::String mFile;
-        Core::String mFunc;
-        uint64_t mLine;
-    
-    public:
-
-        /** @brief Constructor */
-        Log(LogLevel level, const std::string& message, const std::string& file, const std::string& function, uint64_t line)
-            :mLevel(level), mMessage(message), mFile(file), mFunc(function), mLine(line) {
 
-            // Timestamp
-            auto now = std::chrono::system_clock::now();
-            std::time_t t = std::chrono::system_clock::to_time_t(now);
-
-            #ifdef _WIN32
-                localtime_s(&mTimestamp, &t);
-            #else
-                localtime_r(&t, &mTimestamp);
-            #endif
+        /** @brief "TRACE" ... "FATAL" to LogLevel. @return false if the name is unknown. */
+        static bool levelFromString(const std::string& name, LogLevel& level) {
+            for (uint8_t i = 0; i <= static_cast<uint8_t>(LogLevel::FATAL); ++i) {
+                if (levelToString(static_cast<LogLevel>(i)) == name) {
+                    level = static_cast<LogLevel>(i);
+                    return true;
+                }
+            }
+            return false;
         }
-        
-        Core::String toString() const {
-            std::ostringstream oss;
-            oss << "[" << std::put_time(&mTimestamp, "%Y-%m-%d %H:%M:%S") << "]"
-                << "[" << LogHelper::levelToString(mLevel) << "]"
-                << "[" << mFunc << "]" 
-                << mFile << ":" << mLine << " - "
-                << mMessage;
-            return oss.str();
+
+        static std::string moduleToString(LogModule module) {
+            switch(module) {
+                case LogModule::CORE: return "Core";
+                case LogModule::GATEWAY: return "Gateway";
+                case LogModule::IPC: return "Ipc";
+                case LogModule::SEQUENCER: return "Sequencer";
+                case LogModule::ENGINE: return "Engine";
+                case LogModule::COUNT: break;
+            }
+            return "Core";
         }
 
-        LogLevel getLevel() const {
-            return mLevel;
+        /** @brief "Core", "Gateway", "Ipc", "Sequencer", "Engine" to LogModule. */
+        static bool moduleFromString(const std::string& name, LogModule& module) {
+            for (uint8_t i = 0; i < static_cast<uint8_t>(LogModule::COUNT); ++i) {
+                if (moduleToString(static_cast<LogModule>(i)) == name) {
+                    module = static_cast<LogModule>(i);
+                    return true;
+                }
+            }
+            return false;
         }
     };
 
-
 }
\ No newline at end of file
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Appender.h"
+#include "BinaryLog.h"
+#include "Filter.h"
+#include "LogRecord.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class LogRing
+     * @brief Per-thread single-producer / single-consumer ring of LogRecord.
+     *
+     * @details
+     * The owning thread claims a slot, fills it in place and publishes it with one
+     * release store; the logger thread is the only consumer. Records are never copied
+     * on the producer side. When the ring is full the record is dropped and counted,
+     * the caller never waits for the logger thread.
+     */
+    class LogRing {
+    public:
+        static constexpr size_t CAPACITY = 2048;   // Power of two, 512 KiB per thread
+
+    private:
+        std::unique_ptr<LogRecord[]> mSlots{new LogRecord[CAPACITY]()};   ///> Zeroed: pages are faulted in up front
+        alignas(64) std::atomic<size_t> mHead{0};    ///> Consumer
+        alignas(64) std::atomic<size_t> mTail{0};    ///> Producer
+        size_t mCachedHead{0};                       ///> Producer's last view of mHead
+        std::atomic<uint64_t> mDropped{0};
+        std::atomic<bool> mClosed{false};            ///> Owning thread has exited
+
+    public:
+        /** @brief Producer side. @return Slot to fill, or nullptr if the ring is full. */
+        LogRecord* claim() noexcept {
+            const size_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mCachedHead >= CAPACITY) {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+                if (tail - mCachedHead >= CAPACITY) {
+                    mDropped.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+            }
+            return &mSlots[tail & (CAPACITY - 1)];
+        }
+
+        /** @brief Producer side. Makes the slot returned by claim() visible. */
+        void publish() noexcept {
+            mTail.store(mTail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /** @brief Consumer side. Number of records ready to be read. */
+        size_t readable() const noexcept {
+            return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_relaxed);
+        }
+
+        /** @brief Consumer side. i-th oldest record, i < readable(). */
+        const LogRecord& peek(size_t i) const noexcept {
+            return mSlots[(mHead.load(std::memory_order_relaxed) + i) & (CAPACITY - 1)];
+        }
+
+        /** @brief Consumer side. Hands `n` read records back to the producer. */
+        void consume(size_t n) noexcept {
+            mHead.store(mHead.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        uint64_t takeDropped() noexcept { return mDropped.exchange(0, std::memory_order_relaxed); }
+        void close() noexcept { mClosed.store(true, std::memory_order_release); }
+        bool closed() const noexcept { return mClosed.load(std::memory_order_acquire); }
+    };
+
+    /**
+     * @struct LogRoute
+     * @brief One appender and the filters a record must pass to reach it.
+     */
+    struct LogRoute {
+        std::shared_ptr<IAppender> appender;
+        std::vector<std::shared_ptr<IFilter>> filters;
+
+        bool accepts(const LogRecord& r) const {
+            for (const auto& f : filters) {
+                if (!f->filter(r)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @class LogBackend
+     * @brief Logger thread: collects the records of every thread's LogRing and hands
+     * them to the appenders in batches.
+     *
+     * @details
+     * - The calling thread only pays for the record capture (see Logger::log); timestamp
+     *   conversion, printf formatting and all I/O happen here.
+     * - Records of one polling round are merged across threads by timestamp. A record
+     *   is formatted once and the line shared by all appenders; appenders flush at the
+     *   end of the round.
+     * - The date/time prefix is rebuilt only when the second changes (DateCache).
+     * - Appenders default to a ConsoleAppender, see Core::Config to install others.
+     * - Optionally, records go to a binary log file instead (setBinaryOutput() or the
+     *   EXCHANGE_LOG_BINARY environment variable), to be rendered later by log_decoder.
+     * - Logging after the backend has been destroyed (static destructors at exit) falls
+     *   back to formatting on the calling thread.
+     */
+    class LogBackend {
+        static constexpr size_t MAX_LINE = 1024;
+        static constexpr size_t MAX_PER_ROUND = 256;     ///> Records taken from one ring per round
+        static constexpr const char* BINARY_ENV = "EXCHANGE_LOG_BINARY";   ///> Binary log path at startup
+
+        enum State : int { RUNNING, STOPPED };
+        static inline std::atomic<int> sState{RUNNING};
+
+        std::mutex mMutex;                               ///> Guards mRings and the pending output changes
+        std::vector<std::shared_ptr<LogRing>> mRings;
+        std::string mBinaryPath;
+        bool mBinaryChanged{false};
+        std::vector<LogRoute> mPendingRoutes;
+        bool mRoutesChanged{false};
+        std::atomic<bool> mRunning{true};
+        std::atomic<uint64_t> mFlushRequested{0};
+        std::atomic<uint64_t> mFlushDone{0};
+        std::thread mThread;
+
+        // Logger thread state
+        std::vector<const LogRecord*> mBatch;
+        std::vector<std::pair<LogRing*, size_t>> mTaken;
+        std::vector<LogRoute> mRoutes{{std::make_shared<ConsoleAppender>(), {}}};
+        char mLine[MAX_LINE];
+        DateCache mDates;
+        BinaryLogWriter mBinary;
+
+        LogBackend() {
+            if (const char* path = std::getenv(BINARY_ENV)) {
+                mBinaryPath = path;
+                mBinaryChanged = true;
+            }
+            mThread = std::thread([this] { run(); });
+        }
+
+        ~LogBackend() {
+            mRunning.store(false, std::memory_order_release);
+            if (mThread.joinable()) {
+                mThread.join();
+            }
+            sState.store(STOPPED, std::memory_order_release);
+        }
+
+        /**
+         * @brief Ring of the calling thread, registered on first use. The thread_local
+         * holder marks the ring closed on thread exit; the logger thread drops it once
+         * drained.
+         */
+        struct ThreadRing {
+            std::shared_ptr<LogRing> ring;
+            ThreadRing() : ring(std::make_shared<LogRing>()) {
+                LogBackend& b = instance();
+                std::lock_guard<std::mutex> lock(b.mMutex);
+                b.mRings.push_back(ring);
+            }
+            ~ThreadRing() { ring->close(); }
+        };
+
+    public:
+        LogBackend(const LogBackend&) = delete;
+        LogBackend& operator=(const LogBackend&) = delete;
+
+        static LogBackend& instance() {
+            static LogBackend backend;
+            return backend;
+        }
+
+        static bool running() noexcept {
+            return sState.load(std::memory_order_acquire) == RUNNING;
+        }
+
+        static LogRing& threadRing() {
+            thread_local ThreadRing holder;
+            return *holder.ring;
+        }
+
+        /** @brief Blocks until every record published before the call has been written. */
+        void flush() {
+            const uint64_t ticket = mFlushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+            while (mFlushDone.load(std::memory_order_acquire) < ticket && mRunning.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        /**
+         * @brief Replaces the appenders, an empty list restores the console. Records
+         * published before the call go to the previous appenders. Returns once the
+         * logger thread has switched; the previous appenders are released there.
+         */
+        void setAppenders(std::vector<LogRoute> routes) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mPendingRoutes = std::move(routes);
+                mRoutesChanged = true;
+            }
+            flush();
+        }
+
+        /**
+         * @brief Sends records to a binary log file from now on (see BinaryLogWriter),
+         * an empty path switches back to text. WARNING and above still go to the
+         * appenders too. Returns once the logger thread has switched.
+         */
+        void setBinaryOutput(const std::string& path) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mBinaryPath = path;
+                mBinaryChanged = true;
+            }
+            flush();
+        }
+
+        /** @brief Formats and writes one record on the calling thread (fallback path). */
+        static void writeDirect(const LogRecord& r) {
+            char line[MAX_LINE];
+            DateCache dates;
+            size_t n = LogFormatter::line(r, line, sizeof(line), dates);
+            std::fwrite(line, 1, n, stdout);
+            std::fflush(stdout);
+        }
+
+    private:
+        void append(const LogRecord& r) {
+            if (mBinary.isOpen()) {
+                mBinary.append(r);
+                if (r.site->level < LogLevel::WARNING) {
+                    return;
+                }
+            }
+            size_t len = 0;
+            bool formatted = false;
+            for (const LogRoute& route : mRoutes) {
+                if (!route.accepts(r)) {
+                    continue;
+                }
+                if (!formatted && route.appender->wantsLine()) {
+                    len = LogFormatter::line(r, mLine, MAX_LINE, mDates);
+                    formatted = true;
+                }
+                route.appender->append(r, std::string_view(mLine, formatted ? len : 0));
+            }
+        }
+
+        // Messages of the logger itself, they go through the appenders like any record
+        template <typename... Args>
+        void report(const LogSite& site, const Args&... args) {
+            LogRecord r;
+            r.timestamp = TscClock::now();
+            r.site = &site;
+            LogArgWriter writer(r);
+            (writer.add(args), ...);
+            writer.finish();
+            append(r);
+        }
+
+        // Logger thread: applies setAppenders() / setBinaryOutput() requests
+        void switchOutput() {
+            static const LogSite cannotOpen{"cannot open binary log '%s': %s", __FILE__, __func__, __LINE__,
+                LogLevel::ERROR, LogSite::nextId()};
+            std::vector<LogRoute> released;
+            std::string path;
+            bool binaryChanged;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mRoutesChanged) {
+                    mRoutesChanged = false;
+                    released.swap(mRoutes);
+                    mRoutes.swap(mPendingRoutes);
+                    if (mRoutes.empty()) {
+                        mRoutes.push_back({std::make_shared<ConsoleAppender>(), {}});
+                    }
+                }
+                binaryChanged = mBinaryChanged;
+                mBinaryChanged = false;
+                path = mBinaryPath;
+            }
+            for (const LogRoute& route : released) {
+                route.appender->flush();
+            }
+            if (binaryChanged) {
+                mBinary.close();
+                if (!path.empty() && !mBinary.open(path, BinaryLogHeader{{}, 0, 0, 1000000000ULL, 0, 0})) {
+                    report(cannotOpen, path, std::strerror(errno));
+                }
+            }
+        }
+
+        // One polling round. Returns the number of records written.
+        size_t drainOnce() {
+            static const LogSite droppedSite{"%lu records dropped (ring full)", __FILE__, __func__, __LINE__,
+                LogLevel::WARNING, LogSite::nextId()};
+            static const LogSite appenderSite{"log appender failed: %s", __FILE__, __func__, __LINE__,
+                LogLevel::ERROR, LogSite::nextId()};
+            switchOutput();
+            std::vector<std::shared_ptr<LogRing>> rings;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                rings = mRings;
+            }
+
+            mBatch.clear();
+            mTaken.clear();
+            uint64_t dropped = 0;
+            for (const auto& ring : rings) {
+                // Records are read in place and only handed back once written
+                size_t n = std::min(ring->readable(), MAX_PER_ROUND);
+                for (size_t i = 0; i < n; ++i) {
+                    mBatch.push_back(&ring->peek(i));
+                }
+                mTaken.emplace_back(ring.get(), n);
+                dropped += ring->takeDropped();
+            }
+
+            std::stable_sort(mBatch.begin(), mBatch.end(),
+                [](const LogRecord* a, const LogRecord* b) { return a->timestamp < b->timestamp; });
+            for (const LogRecord* r : mBatch) {
+                append(*r);
+            }
+            for (auto& [ring, n] : mTaken) {
+                ring->consume(n);
+            }
+            if (dropped > 0) {
+                report(droppedSite, dropped);
+            }
+            for (const LogRoute& route : mRoutes) {
+                if (const std::string error = route.appender->takeError(); !error.empty()) {
+                    report(appenderSite, error);
+                }
+            }
+            for (const LogRoute& route : mRoutes) {
+                route.appender->flush();
+            }
+
+            // Forget rings of exited threads once they are empty
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mRings.erase(std::remove_if(mRings.begin(), mRings.end(),
+                    [](const std::shared_ptr<LogRing>& r) { return r->closed() && r->readable() == 0; }),
+                    mRings.end());
+            }
+            return mBatch.size();
+        }
+
+        void run() {
+            while (true) {
+                const bool running = mRunning.load(std::memory_order_acquire);
+                const uint64_t ticket = mFlushRequested.load(std::memory_order_acquire);
+                size_t written = 0;
+                size_t n;
+                while ((n = drainOnce()) > 0) {
+                    written += n;
+                }
+                mFlushDone.store(ticket, std::memory_order_release);
+                if (!running) {
+                    mBinary.close();
+                    mRoutes.clear();
+                    break;
+                }
+                if (written == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+            }
+        }
+    };
+
+} // namespace Exchange::Core
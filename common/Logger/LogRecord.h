@@ -0,0 +1,339 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Clock/TscClock.h"
+#include "Log.h"
+#include "String.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @enum LogArgType
+     * @brief Tag written in front of every captured log argument.
+     */
+    enum class LogArgType : uint8_t {
+        INT64,
+        UINT64,
+        DOUBLE,
+        STRING,     // uint16 length, bytes, '\0'
+        POINTER
+    };
+
+    /**
+     * @struct LogSite
+     * @brief Static description of one LOG_* call site.
+     *
+     * @details
+     * Each macro expansion owns one LogSite, built the first time the statement runs.
+     * Its id is the call site's format-id: binary log files store the site once and
+     * refer to it by id from every record.
+     */
+    struct LogSite {
+        const char* fmt;        // printf style format, must be a literal
+        const char* file;
+        const char* func;
+        uint32_t line;
+        LogLevel level;
+        uint32_t id;
+
+        /** @brief Next free format-id, ids are dense from 0. */
+        static uint32_t nextId() noexcept {
+            static std::atomic<uint32_t> sNext{0};
+            return sNext.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @struct LogRecord
+     * @brief One deferred log statement, exactly as captured on the calling thread.
+     *
+     * @details
+     * Only a pointer to the static LogSite and the raw argument values are stored.
+     * Strings passed as arguments are copied because they may not outlive the call.
+     * Formatting happens later on the logger thread.
+     */
+    struct LogRecord {
+        static constexpr size_t SIZE = 256;
+        static constexpr size_t HEADER_SIZE = 24;
+        static constexpr size_t ARG_BYTES = SIZE - HEADER_SIZE;
+
+        uint64_t timestamp;     // Nanoseconds since epoch (TscClock)
+        const LogSite* site;
+        uint16_t argBytes;      // Used part of `args`
+        uint8_t argCount;
+        uint8_t reserved[5];
+        char args[ARG_BYTES];
+    };
+    static_assert(sizeof(LogRecord) == LogRecord::SIZE, "LogRecord must stay 256 bytes");
+
+    /**
+     * @class LogArgWriter
+     * @brief Packs the arguments of a log call into a LogRecord.
+     *
+     * @details
+     * Types are resolved at compile time, so the hot path is a handful of stores per
+     * argument. Whatever does not fit into the record is dropped, the message then ends
+     * with "<truncated>" once formatted.
+     */
+    class LogArgWriter {
+        LogRecord& mRecord;
+        char* mPos;
+        char* mEnd;
+
+        template <typename> static constexpr bool unsupported = false;
+
+        bool reserve(size_t bytes) noexcept {
+            return static_cast<size_t>(mEnd - mPos) >= bytes;
+        }
+
+        template <typename V>
+        void putValue(LogArgType type, V value) noexcept {
+            if (!reserve(1 + sizeof(V))) {
+                mEnd = mPos; // Keep arguments in order: nothing after a dropped one
+                return;
+            }
+            *mPos++ = static_cast<char>(type);
+            std::memcpy(mPos, &value, sizeof(V));
+            mPos += sizeof(V);
+            ++mRecord.argCount;
+        }
+
+        void putString(const char* s, size_t len) noexcept {
+            if (!s) {
+                s = "(null)";
+                len = 6;
+            }
+            if (!reserve(1 + sizeof(uint16_t) + 1)) {
+                mEnd = mPos;
+                return;
+            }
+            size_t room = static_cast<size_t>(mEnd - mPos) - (1 + sizeof(uint16_t) + 1);
+            uint16_t n = static_cast<uint16_t>(len < room ? len : room);
+            *mPos++ = static_cast<char>(LogArgType::STRING);
+            std::memcpy(mPos, &n, sizeof(n));
+            mPos += sizeof(n);
+            std::memcpy(mPos, s, n);
+            mPos += n;
+            *mPos++ = '\0';
+            ++mRecord.argCount;
+        }
+
+    public:
+        explicit LogArgWriter(LogRecord& record) noexcept
+            : mRecord(record), mPos(record.args), mEnd(record.args + LogRecord::ARG_BYTES) {
+            mRecord.argCount = 0;
+        }
+
+        template <typename T>
+        void add(const T& value) noexcept {
+            using D = std::decay_t<T>;
+            if constexpr (std::is_enum_v<D>) {
+                add(static_cast<std::underlying_type_t<D>>(value));
+            }
+            else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+                putValue(LogArgType::INT64, static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_integral_v<D>) {
+                putValue(LogArgType::UINT64, static_cast<uint64_t>(value));
+            }
+            else if constexpr (std::is_floating_point_v<D>) {
+                putValue(LogArgType::DOUBLE, static_cast<double>(value));
+            }
+            else if constexpr (std::is_same_v<D, char*> || std::is_same_v<D, const char*>) {
+                const char* s = value;
+                putString(s, s ? std::strlen(s) : 0);
+            }
+            else if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>) {
+                putString(value.data(), value.size());
+            }
+            else if constexpr (isBasicString<D>) {
+                putString(value.get(), value.size());
+            }
+            else if constexpr (std::is_pointer_v<D>) {
+                putValue(LogArgType::POINTER, reinterpret_cast<uint64_t>(value));
+            }
+            else {
+                static_assert(unsupported<D>, "Unsupported LOG_* argument type");
+            }
+        }
+
+        /** @brief Records how many argument bytes were used. */
+        void finish() noexcept {
+            mRecord.argBytes = static_cast<uint16_t>(mPos - mRecord.args);
+        }
+    };
+
+    /**
+     * @class LogFormatter
+     * @brief Renders the message of a LogRecord (printf semantics) on the logger thread.
+     *
+     * @details
+     * Conversions are applied one at a time with snprintf: length modifiers written at
+     * the call site are ignored and replaced by the width of the captured value, so a
+     * mismatched "%d" / "%lu" / "%ls" can no longer read garbage.
+     */
+    class LogFormatter {
+        struct Arg {
+            LogArgType type;
+            int64_t i;
+            uint64_t u;
+            double d;
+            const char* s;
+        };
+
+        static bool next(const LogRecord& r, size_t& off, Arg& a) noexcept {
+            if (off >= r.argBytes) {
+                return false;
+            }
+            a.type = static_cast<LogArgType>(r.args[off++]);
+            switch (a.type) {
+                case LogArgType::STRING: {
+                    uint16_t n;
+                    std::memcpy(&n, r.args + off, sizeof(n));
+                    a.s = r.args + off + sizeof(n);
+                    off += sizeof(n) + n + 1;
+                    break;
+                }
+                case LogArgType::DOUBLE:
+                    std::memcpy(&a.d, r.args + off, sizeof(a.d));
+                    off += sizeof(a.d);
+                    break;
+                default:
+                    std::memcpy(&a.u, r.args + off, sizeof(a.u));
+                    a.i = static_cast<int64_t>(a.u);
+                    off += sizeof(a.u);
+                    break;
+            }
+            return true;
+        }
+
+        static size_t append(char* out, size_t pos, size_t cap, const char* s) noexcept {
+            while (*s && pos + 1 < cap) {
+                out[pos++] = *s++;
+            }
+            return pos;
+        }
+
+    public:
+        /**
+         * @brief Writes the formatted message into `out` (always '\0' terminated).
+         * Arguments without a matching conversion are ignored, as printf does.
+         * @return Length written.
+         */
+        static size_t format(const LogRecord& r, char* out, size_t cap) noexcept {
+            size_t pos = 0;
+            size_t off = 0;
+            const char* f = (r.site && r.site->fmt) ? r.site->fmt : "";
+
+            while (*f && pos + 1 < cap) {
+                if (*f != '%') {
+                    out[pos++] = *f++;
+                    continue;
+                }
+                if (f[1] == '%') {
+                    out[pos++] = '%';
+                    f += 2;
+                    continue;
+                }
+
+                // %[flags][width][.precision][length]conversion
+                char spec[32];
+                size_t n = 0;
+                spec[n++] = *f++;
+                while (*f && std::strchr("-+ #0123456789.", *f) && n < sizeof(spec) - 4) {
+                    spec[n++] = *f++;
+                }
+                while (*f && std::strchr("hlLqjzt", *f)) {
+                    ++f;
+                }
+                char conv = *f ? *f++ : 's';
+
+                Arg a{};
+                if (!next(r, off, a)) {
+                    pos = append(out, pos, cap, "<truncated>");
+                    continue;
+                }
+
+                int w = 0;
+                const size_t room = cap - pos;
+                auto emit = [&](const char* suffix, auto value) {
+                    std::strcpy(spec + n, suffix);
+                    w = std::snprintf(out + pos, room, spec, value);
+                };
+
+                if (a.type == LogArgType::STRING) {
+                    emit("s", a.s);
+                }
+                else if (std::strchr("eEfFgGaA", conv)) {
+                    spec[n] = conv;
+                    spec[n + 1] = '\0';
+                    w = std::snprintf(out + pos, room, spec,
+                        a.type == LogArgType::DOUBLE ? a.d : static_cast<double>(a.i));
+                }
+                else if (a.type == LogArgType::DOUBLE) {
+                    emit("g", a.d);
+                }
+                else if (conv == 'p' || a.type == LogArgType::POINTER) {
+                    emit("p", reinterpret_cast<void*>(a.u));
+                }
+                else if (conv == 'c') {
+                    emit("c", static_cast<int>(a.i));
+                }
+                else if (std::strchr("uoxX", conv)) {
+                    char suffix[4] = {'l', 'l', conv, '\0'};
+                    emit(suffix, static_cast<unsigned long long>(a.u));
+                }
+                else if (a.type == LogArgType::UINT64) {
+                    emit("llu", static_cast<unsigned long long>(a.u));
+                }
+                else {
+                    emit("lld", static_cast<long long>(a.i));
+                }
+
+                if (w > 0) {
+                    pos += (static_cast<size_t>(w) < room) ? static_cast<size_t>(w) : room - 1;
+                }
+            }
+            out[pos] = '\0';
+            return pos;
+        }
+
+        static const char* levelName(LogLevel level) noexcept {
+            switch (level) {
+                case LogLevel::TRACE:   return "TRACE";
+                case LogLevel::DEBUG:   return "DEBUG";
+                case LogLevel::INFO:    return "INFO";
+                case LogLevel::WARNING: return "WARNING";
+                case LogLevel::ERROR:   return "ERROR";
+                case LogLevel::FATAL:   return "FATAL";
+            }
+            return "INFO";
+        }
+
+        /**
+         * @brief "[YYYY-MM-DD HH:MM:SS.uuuuuu][LEVEL][func]file:line - message\n"
+         * @param dates Cache of the date/time part, owned by the formatting thread.
+         * @return Length written, the line is not '\0' terminated.
+         */
+        static size_t line(const LogRecord& r, char* out, size_t cap, DateCache& dates) noexcept {
+            const unsigned micros = static_cast<unsigned>((r.timestamp % 1000000000ULL) / 1000);
+            const char* prefix = dates.format(r.timestamp);
+            int n = std::snprintf(out, cap, "[%s.%06u][%s][%s]%s:%u - ",
+                prefix, micros, levelName(r.site->level), r.site->func, r.site->file, r.site->line);
+            size_t len = n > 0 ? std::min(static_cast<size_t>(n), cap - 2) : 0;
+            len += format(r, out + len, cap - len - 1);
+            out[len++] = '\n';
+            return len;
+        }
+    };
+
+} // namespace Exchange::Core
@@ -1,178 +1,160 @@
 // Logger.h
 #pragma once
 
-#include <iostream>
-#include <chrono>
-#include <string>
-#include <sstream>
-#include <ctime>
-#include <iomanip>
-#include <cstdint>  
-#include <cstring>  
-#include <unordered_map>
-#include <atomic>
-#include <vector>
-
-#include "String.h"
+#include <cstdint>
 
-namespace Exchange::Core {
+#include "Log.h"
+#include "LogBackend.h"
 
-    enum class LogLevel : uint8_t {
-        TRACE,
-        DEBUG,
-        INFO,
-        WARNING,
-        ERROR,
-        FATAL
-    };
+namespace Exchange::Core {
 
-    class LogHelper {
-    public:
-        static std::string levelToString(LogLevel level) {
-            switch(level) {
-                case LogLevel::TRACE: return "TRACE";
-                case LogLevel::DEBUG: return "DEBUG";
-                case LogLevel::INFO:  return "INFO";
-                case LogLevel::WARNING: return "WARNING";
-                case LogLevel::ERROR: return "ERROR";
-                case LogLevel::FATAL: return "FATAL";
-            }
-            return levelToString(LogLevel::INFO); // default
+    /**
+     * @class Logger
+     * @brief Front end of the LOG_* macros.
+     *
+     * @details
+     * log() runs on the calling thread and does no formatting: it claims a record in the
+     * thread's LogRing, stores the timestamp, a pointer to the call site's static LogSite
+     * (format, file, function, line, level) and the raw arguments, and publishes it. The
+     * logger thread (LogBackend) turns records into text later. A full ring drops the
+     * record rather than blocking. FATAL records are flushed before returning since the
+     * process is likely to end.
+     *
+     * Two filters run before anything else, see the LOG_* macros:
+     * - LOG_MIN_LEVEL removes lower levels at compile time (arguments are never evaluated);
+     * - a runtime minimum level per LogModule, one relaxed load.
+     *
+     * @note The format string must be a string literal: only its address is captured.
+     */
+    class Logger {
+        static inline std::atomic<LogLevel> sLevels[static_cast<size_t>(LogModule::COUNT)]{};
+
+        template <typename... Args>
+        static void fill(LogRecord& r, const LogSite& site, const Args&... args) noexcept {
+            r.timestamp = TscClock::now();
+            r.site = &site;
+            LogArgWriter writer(r);
+            (writer.add(args), ...);
+            writer.finish();
         }
-    };
 
-    class Log {
-        std::tm mTimestamp;
-        LogLevel mLevel;
-        Core::String mMessage;
-        Core::String mFile;
-        Core::String mFunc;
-        uint64_t mLine;
-    
     public:
-
-        /** @brief Constructor */
-        Log(LogLevel level, const std::string& message, const std::string& file, const std::string& function, uint64_t line)
-            :mLevel(level), mMessage(message), mFile(file), mFunc(function), mLine(line) {
-
-            // Timestamp
-            auto now = std::chrono::system_clock::now();
-            std::time_t t = std::chrono::system_clock::to_time_t(now);
-
-            #ifdef _WIN32
-                localtime_s(&mTimestamp, &t);
-            #else
-                localtime_r(&t, &mTimestamp);
-            #endif
-        }
-        
-        Core::String toString(){
-            std::ostringstream oss;
-            oss << "[" << std::put_time(&mTimestamp, "%Y-%m-%d %H:%M:%S") << "]"
-                << "[" << LogHelper::levelToString(mLevel) << "]"
-                << "[" << mFunc << "]" 
-                << mFile << ":" << mLine << " - "
-                << mMessage;
-            return oss.str();
+        /** @brief Runtime check done by the LOG_* macros before evaluating any argument. */
+        static bool enabled(LogModule module, LogLevel level) noexcept {
+            return level >= sLevels[static_cast<size_t>(module)].load(std::memory_order_relaxed);
         }
 
-        LogLevel getLevel() const {
-            return mLevel;
+        /** @brief Minimum level logged for `module` from now on (TRACE by default). */
+        static void setLevel(LogModule module, LogLevel level) noexcept {
+            sLevels[static_cast<size_t>(module)].store(level, std::memory_order_relaxed);
         }
-    };
 
-    class Logger {
-        // helper: format with va_list
-        static std::string vformat(const char* fmt, va_list args) {
-            if (!fmt) return std::string();
-            va_list argsCopy;
-            va_copy(argsCopy, args);
-            int len = std::vsnprintf(nullptr, 0, fmt, argsCopy);
-            va_end(argsCopy);
-            if (len < 0) return std::string();
-
-            std::string result;
-            result.resize(static_cast<size_t>(len));
-            std::vsnprintf(result.data(), result.size() + 1, fmt, args);
-            return result;
+        static LogLevel level(LogModule module) noexcept {
+            return sLevels[static_cast<size_t>(module)].load(std::memory_order_relaxed);
         }
 
-        // convenience wrapper
-        static std::string format(const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string s = vformat(fmt, args);
-            va_end(args);
-            return s;
-        }
-    public:
+        /** @brief Type-checks the arguments of a compiled-out LOG_* call, never defined. */
+        template <typename... Args>
+        static int discard(const char* fmt, const Args&... args) noexcept;
+
+        /**
+         * @param site Static description of the call site, see LOG_SITE_.
+         * @param fmt Same literal as site.fmt, passed again so the macros can forward __VA_ARGS__.
+         */
+        template <typename... Args>
+        static void log(const LogSite& site, const char* fmt, const Args&... args) {
+            (void)fmt;
+            if (!LogBackend::running()) {
+                LogRecord r;
+                fill(r, site, args...);
+                LogBackend::writeDirect(r);
+                return;
+            }
 
-        // static void log(LogLevel level, const std::string& msg, const char* file, const char* func, uint64_t line) {
-        //     Log log(level,msg,file,func,line);
-        //     Core::String str = log.toString();
-        //     std::cout << str.toString() << std::endl;
-        // }
-
-        static void log(LogLevel level, const char* file, const char* func, uint64_t line, const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string msg = vformat(fmt, args);
-            va_end(args);
-
-            Log log(level, msg, file ? file : "", func ? func : "", line);
-            Core::String str = log.toString();
-            std::cout << str.toString() << std::endl;
+            LogRing& ring = LogBackend::threadRing();
+            if (LogRecord* r = ring.claim()) {
+                fill(*r, site, args...);
+                ring.publish();
+            }
+            else if (site.level >= LogLevel::ERROR) {
+                // Ring full: errors are written by the caller rather than dropped
+                LogRecord direct;
+                fill(direct, site, args...);
+                LogBackend::writeDirect(direct);
+            }
+            if (site.level == LogLevel::FATAL) {
+                LogBackend::instance().flush();
+            }
         }
 
-        static void debug(const char* file, const char* func, uint64_t line, const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string msg = vformat(fmt, args);
-            va_end(args);
-            log(LogLevel::DEBUG, file, func, line, "%s", msg.c_str());
-        }
-        static void trace(const char* file, const char* func, uint64_t line, const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string msg = vformat(fmt, args);
-            va_end(args);
-            log(LogLevel::TRACE, file, func, line, "%s", msg.c_str());
-        }
-        static void info(const char* file, const char* func, uint64_t line, const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string msg = vformat(fmt, args);
-            va_end(args);
-            log(LogLevel::INFO, file, func, line, "%s", msg.c_str());
-        }
-        static void warn(const char* file, const char* func, uint64_t line, const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string msg = vformat(fmt, args);
-            va_end(args);
-            log(LogLevel::WARNING, file, func, line, "%s", msg.c_str());
-        }
-        static void error(const char* file, const char* func, uint64_t line, const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string msg = vformat(fmt, args);
-            va_end(args);
-            log(LogLevel::ERROR, file, func, line, "%s", msg.c_str());
-        }
-        static void fatal(const char* file, const char* func, uint64_t line, const char* fmt, ...) {
-            va_list args;
-            va_start(args, fmt);
-            std::string msg = vformat(fmt, args);
-            va_end(args);
-            log(LogLevel::FATAL, file, func, line, "%s", msg.c_str());
+        /** @brief Waits until everything logged so far has been written. */
+        static void flush() {
+            if (LogBackend::running()) {
+                LogBackend::instance().flush();
+            }
         }
     };
 
 }
 
-#define LOG_DEBUG(...) Exchange::Core::Logger::debug(__FILE__, __PRETTY_FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_TRACE(...) Exchange::Core::Logger::trace(__FILE__, __PRETTY_FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_INFO(...)  Exchange::Core::Logger::info(__FILE__, __PRETTY_FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_WARN(...)  Exchange::Core::Logger::warn(__FILE__, __PRETTY_FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_ERROR(...) Exchange::Core::Logger::error(__FILE__, __PRETTY_FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_FATAL(...) Exchange::Core::Logger::fatal(__FILE__, __PRETTY_FUNCTION__, __LINE__, __VA_ARGS__)
\ No newline at end of file
+/**
+ * Module of a LOG_* call site: the innermost LOG_MODULE visible from the call, so code
+ * in Exchange::Gateway logs as GATEWAY and so on. Everything else logs as CORE.
+ */
+inline constexpr Exchange::Core::LogModule LOG_MODULE = Exchange::Core::LogModule::CORE;
+namespace Exchange::Gateway { inline constexpr Core::LogModule LOG_MODULE = Core::LogModule::GATEWAY; }
+namespace Exchange::Ipc { inline constexpr Core::LogModule LOG_MODULE = Core::LogModule::IPC; }
+namespace Exchange::Sequencer { inline constexpr Core::LogModule LOG_MODULE = Core::LogModule::SEQUENCER; }
+namespace Exchange::Matching { inline constexpr Core::LogModule LOG_MODULE = Core::LogModule::ENGINE; }
+
+/**
+ * Compile-time minimum level (0 = TRACE ... 5 = FATAL). Calls below it expand to an
+ * unevaluated sizeof: no code, no argument evaluation, but still type-checked.
+ * Release builds (NDEBUG) default to INFO, override with -DLOG_MIN_LEVEL=n.
+ */
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 2
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// One static LogSite per macro expansion, built the first time the statement is logged
+#define LOG_FORMAT_(fmt, ...) fmt
+#define LOG_SITE_(level, ...)                                                                   \
+    do {                                                                                        \
+        if (Exchange::Core::Logger::enabled(LOG_MODULE, level)) {                               \
+            static const Exchange::Core::LogSite logSite_{LOG_FORMAT_(__VA_ARGS__, 0), __FILE__, \
+                __PRETTY_FUNCTION__, __LINE__, level, Exchange::Core::LogSite::nextId()};       \
+            Exchange::Core::Logger::log(logSite_, __VA_ARGS__);                                 \
+        }                                                                                       \
+    } while (0)
+#define LOG_DISABLED_(...) do { (void)sizeof(Exchange::Core::Logger::discard(__VA_ARGS__)); } while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(...) LOG_SITE_(Exchange::Core::LogLevel::TRACE, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) LOG_DISABLED_(__VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(...) LOG_SITE_(Exchange::Core::LogLevel::DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOG_DISABLED_(__VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 2
+#define LOG_INFO(...)  LOG_SITE_(Exchange::Core::LogLevel::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...)  LOG_DISABLED_(__VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 3
+#define LOG_WARN(...)  LOG_SITE_(Exchange::Core::LogLevel::WARNING, __VA_ARGS__)
+#else
+#define LOG_WARN(...)  LOG_DISABLED_(__VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 4
+#define LOG_ERROR(...) LOG_SITE_(Exchange::Core::LogLevel::ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOG_DISABLED_(__VA_ARGS__)
+#endif
+#define LOG_FATAL(...) LOG_SITE_(Exchange::Core::LogLevel::FATAL, __VA_ARGS__)
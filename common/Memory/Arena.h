@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "Exception.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class Arena
+     * @brief Bump allocator for the objects of one batch: allocate() moves a pointer
+     * forward, reset() drops everything at once, nothing is freed individually.
+     *
+     * @details
+     * Memory comes in chunks of at least `chunkSize` bytes taken from the heap the first
+     * time they are needed. reset() rewinds to the first chunk but keeps them all, so once
+     * the largest batch has been seen a loop of allocate() ... reset() never calls malloc.
+     * A request larger than the chunk size gets a chunk of its own, kept and reused in the
+     * same way.
+     * Destructors are not run: the arena holds trivially destructible data, or objects
+     * whose destruction the owner handles before reset().
+     * Not thread safe: an arena is owned by one thread (typically one per worker).
+     */
+    class Arena {
+        struct Chunk {
+            Chunk* next;
+            size_t capacity;    ///> Usable bytes after the header
+
+            char* begin() noexcept { return reinterpret_cast<char*>(this + 1); }
+            char* end() noexcept { return begin() + capacity; }
+        };
+
+        size_t mChunkSize;
+        Chunk* mFirst{nullptr};
+        Chunk* mCurrent{nullptr};
+        uintptr_t mPtr{0};          ///> Next free byte of mCurrent
+        uintptr_t mEnd{0};
+        size_t mReserved{0};        ///> Bytes of all chunks
+
+        static uintptr_t alignUp(uintptr_t p, size_t align) noexcept {
+            return (p + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        }
+
+        void enter(Chunk* c) noexcept {
+            mCurrent = c;
+            mPtr = reinterpret_cast<uintptr_t>(c->begin());
+            mEnd = reinterpret_cast<uintptr_t>(c->end());
+        }
+
+        /** @brief Slow path: moves to the next chunk able to hold the request, adding one if needed. */
+        void* refill(size_t bytes, size_t align) {
+            const size_t needed = bytes + align - 1;
+            Chunk* prev = mCurrent;
+            Chunk* next = mCurrent ? mCurrent->next : mFirst;
+            if (!next || next->capacity < needed) {
+                const size_t capacity = needed > mChunkSize ? needed : mChunkSize;
+                Chunk* c = static_cast<Chunk*>(::operator new(sizeof(Chunk) + capacity));
+                c->capacity = capacity;
+                c->next = next;
+                (prev ? prev->next : mFirst) = c;
+                mReserved += capacity;
+                next = c;
+            }
+            enter(next);
+            const uintptr_t p = alignUp(mPtr, align);
+            mPtr = p + bytes;
+            return reinterpret_cast<void*>(p);
+        }
+
+        void release() noexcept {
+            while (mFirst) {
+                Chunk* next = mFirst->next;
+                ::operator delete(mFirst);
+                mFirst = next;
+            }
+            mCurrent = nullptr;
+            mPtr = mEnd = 0;
+            mReserved = 0;
+        }
+
+    public:
+        static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        /** @brief Constructor, no memory is taken until the first allocate(). */
+        explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE) : mChunkSize(chunkSize) {
+            if (chunkSize == 0) {
+                ENG_THROW("Arena chunk size must be > 0");
+            }
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        Arena(Arena&& other) noexcept
+            : mChunkSize(other.mChunkSize), mFirst(std::exchange(other.mFirst, nullptr)),
+              mCurrent(std::exchange(other.mCurrent, nullptr)), mPtr(std::exchange(other.mPtr, 0)),
+              mEnd(std::exchange(other.mEnd, 0)), mReserved(std::exchange(other.mReserved, 0)) {}
+
+        ~Arena() {
+            release();
+        }
+
+        /**
+         * @brief `bytes` bytes aligned on `align` (a power of two), valid until reset().
+         * @throws std::bad_alloc When a new chunk is needed and the heap is exhausted.
+         */
+        void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+            const uintptr_t p = alignUp(mPtr, align);
+            if (mCurrent && p + bytes <= mEnd) {
+                mPtr = p + bytes;
+                return reinterpret_cast<void*>(p);
+            }
+            return refill(bytes, align);
+        }
+
+        /** @brief Constructs a T in the arena; its destructor will not be called. */
+        template <typename T, typename... Args>
+        T* create(Args&&... args) {
+            return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /** @brief Uninitialised array of `n` T. */
+        template <typename T>
+        T* allocateArray(size_t n) {
+            return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+        }
+
+        /** @brief Ends the batch: every allocation is dropped, the chunks are kept. */
+        void reset() noexcept {
+            if (mFirst) {
+                enter(mFirst);
+            }
+        }
+
+        /** @brief Bytes taken from the heap so far, never shrinks before destruction. */
+        size_t reserved() const noexcept { return mReserved; }
+        size_t chunkSize() const noexcept { return mChunkSize; }
+    };
+
+} // namespace Exchange::Core
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "Arena.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class ArenaResource
+     * @brief std::pmr view of an Arena, so that standard containers (std::pmr::vector,
+     * std::pmr::string, ...) can live in the memory of the current batch.
+     *
+     * @details
+     * Deallocation is a no-op and the memory comes back on Arena::reset(). Unlike
+     * std::pmr::monotonic_buffer_resource, whose release() hands its buffers back to the
+     * upstream resource, the arena keeps its chunks: a container rebuilt every batch stops
+     * calling malloc after the first one. Containers must not outlive the batch.
+     */
+    class ArenaResource : public std::pmr::memory_resource {
+        Arena& mArena;
+
+    public:
+        /** @param arena Must outlive the resource. */
+        explicit ArenaResource(Arena& arena) noexcept : mArena(arena) {}
+
+        Arena& arena() const noexcept { return mArena; }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t align) override {
+            return mArena.allocate(bytes, align);
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            const auto* o = dynamic_cast<const ArenaResource*>(&other);
+            return o && &o->mArena == &mArena;
+        }
+    };
+
+    /**
+     * @class ScopedArena
+     * @brief Arena, its pmr view and the reset at the end of a batch in one object.
+     *
+     * @code
+     * ScopedArena batch;                   // One per thread, outside the loop
+     * while (poll()) {
+     *     auto reset = batch.scope();      // Everything below is dropped at the end of the iteration
+     *     std::pmr::vector<Order> orders(batch.resource());
+     *     ...
+     * }
+     * @endcode
+     */
+    class ScopedArena {
+        Arena mArena;
+        ArenaResource mResource{mArena};
+
+    public:
+        /** @brief Resets the arena when it goes out of scope. */
+        class Scope {
+            Arena& mArena;
+        public:
+            explicit Scope(Arena& arena) noexcept : mArena(arena) {}
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            ~Scope() { mArena.reset(); }
+        };
+
+        explicit ScopedArena(size_t chunkSize = Arena::DEFAULT_CHUNK_SIZE) : mArena(chunkSize) {}
+
+        ScopedArena(const ScopedArena&) = delete;
+        ScopedArena& operator=(const ScopedArena&) = delete;
+
+        [[nodiscard]] Scope scope() noexcept { return Scope(mArena); }
+
+        Arena& arena() noexcept { return mArena; }
+        std::pmr::memory_resource* resource() noexcept { return &mResource; }
+    };
+
+} // namespace Exchange::Core
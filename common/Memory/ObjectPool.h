@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "Exception.h"
+#include "ipc/const.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class ObjectPool
+     * @brief Fixed capacity pool of T, shared between threads: any thread may take an
+     * object and any thread may give it back, without locks and without the heap.
+     *
+     * @details
+     * Storage for all the objects is reserved by the constructor. Free slots form a stack
+     * (Treiber stack) whose links are slot indices kept apart from the objects. The head
+     * packs the index of the top slot with a 32-bit version bumped by every push and pop,
+     * so a pop racing with a pop and push of the same slot fails its CAS instead of
+     * installing a stale link (ABA).
+     * Slots are reused LIFO which keeps recently touched, cache hot, objects in circulation.
+     */
+    template <typename T>
+    class ObjectPool {
+        static constexpr uint32_t NIL = UINT32_MAX;
+
+        struct alignas(T) Slot {
+            unsigned char bytes[sizeof(T)];
+        };
+
+        std::unique_ptr<Slot[]> mSlots;
+        std::unique_ptr<std::atomic<uint32_t>[]> mNext;     ///> Link of each free slot
+        uint32_t mCapacity;
+
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<uint64_t> mHead;    ///> Version << 32 | top slot
+        alignas(Ipc::CACHE_LINE_SIZE) std::atomic<uint32_t> mAvailable;
+
+        static uint64_t pack(uint64_t head, uint32_t index) noexcept {
+            return (((head >> 32) + 1) << 32) | index;
+        }
+
+        uint32_t indexOf(const void* p) const noexcept {
+            return static_cast<uint32_t>(static_cast<const Slot*>(p) - mSlots.get());
+        }
+
+    public:
+        /** @brief unique_ptr deleter returning the object to its pool. */
+        struct Deleter {
+            ObjectPool* pool;
+            void operator()(T* p) const noexcept { pool->release(p); }
+        };
+        using Ptr = std::unique_ptr<T, Deleter>;
+
+        /** @brief Constructor */
+        explicit ObjectPool(uint32_t capacity) : mCapacity(capacity) {
+            if (capacity == 0 || capacity == NIL) {
+                ENG_THROW("ObjectPool capacity must be in (0, %u)", NIL);
+            }
+            mSlots = std::make_unique<Slot[]>(capacity);
+            mNext = std::make_unique<std::atomic<uint32_t>[]>(capacity);
+            for (uint32_t i = 0; i < capacity; ++i) {
+                mNext[i].store(i + 1 < capacity ? i + 1 : NIL, std::memory_order_relaxed);
+            }
+            mHead.store(0, std::memory_order_relaxed);
+            mAvailable.store(capacity, std::memory_order_relaxed);
+        }
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /** @brief Objects still held are not destroyed: release them first. */
+        ~ObjectPool() = default;
+
+        /**
+         * @brief Takes an uninitialised slot, any thread.
+         * @return nullptr if the pool is exhausted.
+         */
+        void* allocate() noexcept {
+            uint64_t head = mHead.load(std::memory_order_acquire);
+            for (;;) {
+                const uint32_t top = static_cast<uint32_t>(head);
+                if (top == NIL) {
+                    return nullptr;
+                }
+                const uint32_t next = mNext[top].load(std::memory_order_relaxed);
+                if (mHead.compare_exchange_weak(head, pack(head, next),
+                                                std::memory_order_acquire, std::memory_order_acquire)) {
+                    mAvailable.fetch_sub(1, std::memory_order_relaxed);
+                    return mSlots[top].bytes;
+                }
+            }
+        }
+
+        /** @brief Returns a slot taken with allocate(), any thread. */
+        void deallocate(void* p) noexcept {
+            const uint32_t index = indexOf(p);
+            uint64_t head = mHead.load(std::memory_order_relaxed);
+            do {
+                mNext[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            } while (!mHead.compare_exchange_weak(head, pack(head, index),
+                                                  std::memory_order_release, std::memory_order_relaxed));
+            mAvailable.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Constructs a T in a free slot.
+         * @return nullptr if the pool is exhausted.
+         */
+        template <typename... Args>
+        T* acquire(Args&&... args) {
+            void* p = allocate();
+            if (!p) {
+                return nullptr;
+            }
+            try {
+                return ::new (p) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(p);
+                throw;
+            }
+        }
+
+        /** @brief Destroys an object of acquire() and returns its slot. */
+        void release(T* p) noexcept {
+            p->~T();
+            deallocate(p);
+        }
+
+        /** @brief acquire() wrapped in a unique_ptr which releases the object. */
+        template <typename... Args>
+        Ptr make(Args&&... args) {
+            return Ptr(acquire(std::forward<Args>(args)...), Deleter{this});
+        }
+
+        /** @brief Whether `p` points into the pool's storage. */
+        bool owns(const void* p) const noexcept {
+            const auto* s = static_cast<const Slot*>(p);
+            return s >= mSlots.get() && s < mSlots.get() + mCapacity;
+        }
+
+        uint32_t capacity() const noexcept { return mCapacity; }
+        /** @brief Free slots, exact once concurrent calls have returned. */
+        uint32_t available() const noexcept { return mAvailable.load(std::memory_order_relaxed); }
+    };
+
+} // namespace Exchange::Core
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Exchange::Core {
+
+    /**
+     * @struct HdrHistogramData
+     * @brief Storage of an HdrHistogram, plain integers so it can live in shared memory
+     * (updated with the __atomic builtins, like the Ipc ring indices).
+     */
+    struct HdrHistogramData {
+        static constexpr unsigned SUB_BITS = 7;
+        static constexpr uint64_t SUB_BUCKETS = 1ULL << SUB_BITS;
+        static constexpr uint64_t HALF = SUB_BUCKETS / 2;
+        static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * HALF + HALF;
+
+        uint64_t counts[BUCKETS];
+        uint64_t total;
+        uint64_t sum;
+        uint64_t max;
+    };
+
+    /**
+     * @class HdrHistogram
+     * @brief Fixed-size log-linear histogram of uint64 values (nanoseconds in practice)
+     * with ~1.6% relative precision over the full 64 bit range.
+     *
+     * @details
+     * Values below SUB_BUCKETS are counted exactly. Above, each power of two is split
+     * into SUB_BUCKETS / 2 linear buckets, so the index is a count-leading-zeros and two
+     * shifts. Counts are relaxed atomics: record() is wait-free from any thread and
+     * readers (percentile(), merge()) see a consistent-enough view without locking.
+     *
+     * The default constructor owns its storage; the other one is a view over storage
+     * owned elsewhere, e.g. a MetricsRegistry segment, possibly mapped read-only (the
+     * readers never write).
+     */
+    class HdrHistogram {
+    public:
+        static constexpr unsigned SUB_BITS = HdrHistogramData::SUB_BITS;
+        static constexpr uint64_t SUB_BUCKETS = HdrHistogramData::SUB_BUCKETS;
+        static constexpr uint64_t HALF = HdrHistogramData::HALF;
+        static constexpr size_t BUCKETS = HdrHistogramData::BUCKETS;
+
+    private:
+        std::unique_ptr<HdrHistogramData> mOwned;
+        HdrHistogramData* mData;
+
+        static uint64_t load(const uint64_t& v) noexcept { return __atomic_load_n(&v, __ATOMIC_RELAXED); }
+        static void add(uint64_t& v, uint64_t n) noexcept { __atomic_fetch_add(&v, n, __ATOMIC_RELAXED); }
+        static void raise(uint64_t& v, uint64_t to) noexcept {
+            uint64_t cur = load(v);
+            while (to > cur && !__atomic_compare_exchange_n(&v, &cur, to, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            }
+        }
+
+    public:
+        HdrHistogram() : mOwned(new HdrHistogramData()), mData(mOwned.get()) {}
+        explicit HdrHistogram(HdrHistogramData* data) noexcept : mData(data) {}
+
+        HdrHistogram(const HdrHistogram&) = delete;
+        HdrHistogram& operator=(const HdrHistogram&) = delete;
+
+        static size_t indexOf(uint64_t v) noexcept {
+            if (v < SUB_BUCKETS) {
+                return static_cast<size_t>(v);
+            }
+            const unsigned e = static_cast<unsigned>(63 - __builtin_clzll(v)) - (SUB_BITS - 1);
+            return static_cast<size_t>(e * HALF + (v >> e));
+        }
+
+        /** @brief Highest value counted in bucket `index`. */
+        static uint64_t valueOf(size_t index) noexcept {
+            if (index < SUB_BUCKETS) {
+                return index;
+            }
+            const unsigned e = static_cast<unsigned>(index / HALF) - 1;
+            const uint64_t low = (static_cast<uint64_t>(index - e * HALF)) << e;
+            return low + ((1ULL << e) - 1);
+        }
+
+        void record(uint64_t v) noexcept {
+            add(mData->counts[indexOf(v)], 1);
+            add(mData->total, 1);
+            add(mData->sum, v);
+            raise(mData->max, v);
+        }
+
+        /** @brief Adds the counts of `other` (e.g. per-thread histograms into a total). */
+        void merge(const HdrHistogram& other) noexcept {
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                const uint64_t n = load(other.mData->counts[i]);
+                if (n) {
+                    add(mData->counts[i], n);
+                }
+            }
+            add(mData->total, other.count());
+            add(mData->sum, load(other.mData->sum));
+            raise(mData->max, other.max());
+        }
+
+        void reset() noexcept {
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                __atomic_store_n(&mData->counts[i], 0, __ATOMIC_RELAXED);
+            }
+            __atomic_store_n(&mData->total, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&mData->sum, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&mData->max, 0, __ATOMIC_RELAXED);
+        }
+
+        uint64_t count() const noexcept { return load(mData->total); }
+        uint64_t max() const noexcept { return load(mData->max); }
+        uint64_t mean() const noexcept {
+            const uint64_t n = count();
+            return n ? load(mData->sum) / n : 0;
+        }
+
+        /** @brief Smallest bucket value with at least `p` percent of the values at or below it. */
+        uint64_t percentile(double p) const noexcept {
+            const uint64_t total = count();
+            if (total == 0) {
+                return 0;
+            }
+            uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+            rank = rank == 0 ? 1 : (rank > total ? total : rank);
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                seen += load(mData->counts[i]);
+                if (seen >= rank) {
+                    const uint64_t v = valueOf(i);
+                    return v < max() ? v : max();
+                }
+            }
+            return max();
+        }
+    };
+
+} // namespace Exchange::Core
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <string>
+
+#include "Metrics.h"
+#include "messaging.h"
+#include "Logger/Logger.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class LatencyTracer
+     * @brief Per-process latency histograms of the sampled messages (FIELD_TRACE).
+     *
+     * @details
+     * A trace is started by the gateway on one message out of SampleEvery and carried
+     * in the message through the processes; each one stamps its own stages and calls
+     * record() for them. A stage's histogram holds the time from the previous stamped
+     * stage, so a stage that is never stamped (e.g. JOURNAL_DURABLE without a journal)
+     * folds into the next one instead of producing bogus values. The total histogram
+     * holds NIC_READ to the last stage this process stamps.
+     *
+     * The histograms are registered as "latency.<STAGE>" and "latency.TOTAL", so they
+     * are also visible live with exchange-stat. dump() writes the percentiles to the
+     * log, on demand with SIGUSR1 (see installSignal()) and at shutdown.
+     */
+    class LatencyTracer {
+        static constexpr size_t STAGES = static_cast<size_t>(Ipc::Msg::TraceStage::COUNT);
+
+        HdrHistogram* mStages[STAGES]{};        ///> [s] = previous stamped stage -> s
+        HdrHistogram* mTotal;                   ///> NIC_READ -> last stage of this process
+        uint32_t mSampleEvery{0};
+        uint32_t mUntilSample{0};
+
+        static inline std::atomic<bool> sDumpRequested{false};
+
+        static void onSignal(int) {
+            sDumpRequested.store(true, std::memory_order_relaxed);
+        }
+
+        static void dumpOne(const char* name, const HdrHistogram& h) {
+            LOG_INFO("Latency %s n=%lu p50=%luns p90=%luns p99=%luns p99.9=%luns max=%luns mean=%luns",
+                name, h.count(), h.percentile(50.0), h.percentile(90.0), h.percentile(99.0),
+                h.percentile(99.9), h.max(), h.mean());
+        }
+
+        LatencyTracer() {
+            MetricsRegistry& registry = MetricsRegistry::instance();
+            for (size_t s = 1; s < STAGES; ++s) {
+                const std::string name = std::string("latency.") + stageName(static_cast<Ipc::Msg::TraceStage>(s));
+                mStages[s] = &registry.histogram(name.c_str());
+            }
+            mTotal = &registry.histogram("latency.TOTAL");
+        }
+
+    public:
+        LatencyTracer(const LatencyTracer&) = delete;
+        LatencyTracer& operator=(const LatencyTracer&) = delete;
+
+        static LatencyTracer& instance() {
+            static LatencyTracer tracer;
+            return tracer;
+        }
+
+        static const char* stageName(Ipc::Msg::TraceStage stage) {
+            static constexpr const char* NAMES[STAGES] = {
+                "NIC_READ", "DISPATCH", "PARSE_DONE", "IPC_PUBLISH", "SEQUENCER_READ", "JOURNAL_DURABLE", "ENGINE_ACK"
+            };
+            const size_t i = static_cast<size_t>(stage);
+            return i < STAGES ? NAMES[i] : "UNKNOWN";
+        }
+
+        /** @brief Gateway side: trace one message out of `every`, 0 = tracing off. */
+        void setSampleEvery(uint32_t every) {
+            mSampleEvery = every;
+            mUntilSample = 0;
+        }
+
+        bool enabled() const { return mSampleEvery != 0; }
+
+        /** @brief true if the next message should carry a trace (single caller thread). */
+        bool sample() {
+            if (mSampleEvery == 0) {
+                return false;
+            }
+            if (mUntilSample == 0) {
+                mUntilSample = mSampleEvery - 1;
+                return true;
+            }
+            --mUntilSample;
+            return false;
+        }
+
+        /** @brief Records the stages `first`..`last` of `trace` which are stamped. */
+        void record(const Ipc::Msg::LatencyTrace& trace, Ipc::Msg::TraceStage first, Ipc::Msg::TraceStage last) {
+            const size_t from = static_cast<size_t>(first) == 0 ? 1 : static_cast<size_t>(first);
+            const size_t to = static_cast<size_t>(last);
+            for (size_t s = from; s <= to && s < STAGES; ++s) {
+                if (trace.ns[s] == 0) {
+                    continue;
+                }
+                size_t p = s;
+                while (p > 0 && trace.ns[--p] == 0) {
+                }
+                if (trace.ns[p] != 0) {
+                    // Stamps of different processes come from separately calibrated clocks
+                    mStages[s]->record(trace.ns[s] > trace.ns[p] ? trace.ns[s] - trace.ns[p] : 0);
+                }
+            }
+            const uint64_t start = trace.ns[static_cast<size_t>(Ipc::Msg::TraceStage::NIC_READ)];
+            if (to < STAGES && start != 0 && trace.ns[to] != 0) {
+                mTotal->record(trace.ns[to] > start ? trace.ns[to] - start : 0);
+            }
+        }
+
+        const HdrHistogram& stage(Ipc::Msg::TraceStage stage) const { return *mStages[static_cast<size_t>(stage)]; }
+        const HdrHistogram& total() const { return *mTotal; }
+
+        /** @brief Logs the percentiles of every stage which has samples, then the total. */
+        void dump() const {
+            size_t last = 0;
+            for (size_t s = 1; s < STAGES; ++s) {
+                if (mStages[s]->count() > 0) {
+                    dumpOne(stageName(static_cast<Ipc::Msg::TraceStage>(s)), *mStages[s]);
+                    last = s;
+                }
+            }
+            if (mTotal->count() > 0) {
+                LOG_INFO("Latency TOTAL is NIC_READ -> %s", stageName(static_cast<Ipc::Msg::TraceStage>(last)));
+                dumpOne("TOTAL", *mTotal);
+            }
+        }
+
+        /** @brief Makes SIGUSR1 request a dump, served by the next pollDump(). */
+        static void installSignal() {
+            struct sigaction sa{};
+            sa.sa_handler = LatencyTracer::onSignal;
+            sigemptyset(&sa.sa_mask);
+            sa.sa_flags = SA_RESTART;
+            sigaction(SIGUSR1, &sa, nullptr);
+        }
+
+        /** @brief Called from a process main loop: dumps if SIGUSR1 was received. */
+        void pollDump() const {
+            if (sDumpRequested.load(std::memory_order_relaxed) && sDumpRequested.exchange(false)) {
+                dump();
+            }
+        }
+    };
+
+} // namespace Exchange::Core
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+// Linux
+#include <unistd.h>
+
+#include "HdrHistogram.h"
+#include "SharedMemory.h"
+#include "Clock/TscClock.h"
+
+namespace Exchange::Core {
+
+    enum class MetricKind : uint32_t {
+        COUNTER   = 0,  // Monotonic, one cell per thread summed by readers
+        GAUGE     = 1,  // Last value set
+        HISTOGRAM = 2,  // HdrHistogram, values in ns
+    };
+
+    /**
+     * @struct MetricDesc
+     * @brief Name and storage slot of one registered metric.
+     */
+    struct MetricDesc {
+        char name[56];
+        MetricKind kind;
+        uint32_t index;         ///> Index in the storage of its kind
+    };
+
+    /**
+     * @struct MetricsSegment
+     * @brief Layout of the "EXCHANGE_METRICS_<process>" shared memory segment.
+     *
+     * @details
+     * The process is the only writer; observers (exchange-stat) map it read-only.
+     * Descriptors are appended and then published by a release store of metricCount,
+     * so a reader never sees a half written one. Each thread owns a row of counter
+     * cells, a cache line multiple, which it updates with plain relaxed stores: no
+     * locked instruction and no line shared with another writer. Readers sum the rows.
+     */
+    struct MetricsSegment {
+        static constexpr uint32_t MAX_COUNTERS = 128;
+        static constexpr uint32_t MAX_GAUGES = 64;
+        static constexpr uint32_t MAX_HISTOGRAMS = 16;
+        static constexpr uint32_t MAX_METRICS = MAX_COUNTERS + MAX_GAUGES + MAX_HISTOGRAMS;
+        static constexpr uint32_t MAX_THREADS = 64;     // The last row is shared by any extra thread
+
+        struct alignas(Ipc::CACHE_LINE_SIZE) Gauge {
+            int64_t value;
+        };
+
+        char signature[32];
+        char uuid[37];
+        char process[27];
+        uint64_t pid;
+        uint64_t startNs;                       ///> TscClock::now() at creation
+        uint32_t metricCount;                   ///> Published descriptors
+        uint32_t threadCount;                   ///> Counter rows handed out
+        MetricDesc metrics[MAX_METRICS];
+        alignas(Ipc::CACHE_LINE_SIZE) uint64_t counters[MAX_THREADS][MAX_COUNTERS];
+        Gauge gauges[MAX_GAUGES];
+        HdrHistogramData histograms[MAX_HISTOGRAMS];
+    };
+
+    static constexpr const char* METRICS_MAGIC = "EXCHANGE_METRICS_V1";
+    static constexpr const char* METRICS_SEGMENT_PREFIX = "EXCHANGE_METRICS_";
+
+    /**
+     * @class MetricsRegistry
+     * @brief Process-wide registry of counters, gauges and histograms, stored in the
+     * process metrics segment.
+     *
+     * @details
+     * init() creates the segment; it must be called before any metric is registered.
+     * Without it (tests, tools) the metrics live in private memory. Registration takes a
+     * mutex and is meant for start-up: hot paths keep the Counter / Gauge / HdrHistogram
+     * handles. Registering an existing name returns the same metric.
+     */
+    class MetricsRegistry {
+        MetricsSegment* mSegment;
+        std::unique_ptr<MetricsSegment> mPrivate;
+        std::unique_ptr<HdrHistogram> mHistograms[MetricsSegment::MAX_HISTOGRAMS];
+        uint32_t mCount[3]{};                   ///> Slots used, per MetricKind
+        std::mutex mMutex;
+
+        static inline Core::String sProcess;
+        static inline bool sCreated{false};
+
+        MetricsRegistry() {
+            if (sProcess.empty()) {
+                mPrivate = std::make_unique<MetricsSegment>();
+                mSegment = mPrivate.get();
+            }
+            else {
+                const Core::String name = Core::String(METRICS_SEGMENT_PREFIX) + sProcess;
+                size_t size = sizeof(MetricsSegment);
+                int fd;
+                mSegment = static_cast<MetricsSegment*>(Ipc::mapSegment(name, size, true, true, fd));
+                ::close(fd);
+                std::memset(mSegment, 0, sizeof(MetricsSegment));
+                std::strncpy(mSegment->uuid, Ipc::publishSession("/" + name).get(), sizeof(mSegment->uuid) - 1);
+                std::strncpy(mSegment->process, sProcess.get(), sizeof(mSegment->process) - 1);
+            }
+            mSegment->pid = static_cast<uint64_t>(::getpid());
+            mSegment->startNs = TscClock::now();
+            // Signature last: observers reject the segment until it is initialised
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            std::strncpy(mSegment->signature, METRICS_MAGIC, sizeof(mSegment->signature) - 1);
+            sCreated = true;
+        }
+
+        uint32_t add(const char* name, MetricKind kind, uint32_t capacity) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const uint32_t n = mSegment->metricCount;
+            for (uint32_t i = 0; i < n; ++i) {
+                const MetricDesc& d = mSegment->metrics[i];
+                if (d.kind == kind && std::strncmp(d.name, name, sizeof(d.name)) == 0) {
+                    return d.index;
+                }
+            }
+            uint32_t& used = mCount[static_cast<uint32_t>(kind)];
+            if (used >= capacity) {
+                ENG_THROW("Metrics registry full, cannot register '%s'", name);
+            }
+            MetricDesc& d = mSegment->metrics[n];
+            std::strncpy(d.name, name, sizeof(d.name) - 1);
+            d.kind = kind;
+            d.index = used++;
+            __atomic_store_n(&mSegment->metricCount, n + 1, __ATOMIC_RELEASE);
+            return d.index;
+        }
+
+    public:
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        /**
+         * @brief Publishes the metrics of this process as "EXCHANGE_METRICS_<process>".
+         * Throws if metrics were registered before.
+         */
+        static void init(const Core::String& process) {
+            if (sCreated) {
+                ENG_THROW("MetricsRegistry::init() called after metrics were registered");
+            }
+            sProcess = process;
+            instance();
+        }
+
+        static MetricsRegistry& instance() {
+            static MetricsRegistry registry;
+            return registry;
+        }
+
+        const MetricsSegment& segment() const { return *mSegment; }
+
+        /** @brief Counter row of the calling thread; `shared` if it is the overflow row. */
+        uint64_t* threadRow(bool& shared) {
+            const uint32_t slot = __atomic_fetch_add(&mSegment->threadCount, 1, __ATOMIC_RELAXED);
+            shared = slot >= MetricsSegment::MAX_THREADS - 1;
+            return mSegment->counters[shared ? MetricsSegment::MAX_THREADS - 1 : slot];
+        }
+
+        uint32_t counter(const char* name) { return add(name, MetricKind::COUNTER, MetricsSegment::MAX_COUNTERS); }
+
+        int64_t* gauge(const char* name) {
+            return &mSegment->gauges[add(name, MetricKind::GAUGE, MetricsSegment::MAX_GAUGES)].value;
+        }
+
+        HdrHistogram& histogram(const char* name) {
+            const uint32_t i = add(name, MetricKind::HISTOGRAM, MetricsSegment::MAX_HISTOGRAMS);
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mHistograms[i]) {
+                mHistograms[i] = std::make_unique<HdrHistogram>(&mSegment->histograms[i]);
+            }
+            return *mHistograms[i];
+        }
+    };
+
+    /**
+     * @class Counter
+     * @brief Handle of a registered counter. add() touches only the calling thread's
+     * cell: a load and a store, no atomic read-modify-write.
+     */
+    class Counter {
+        uint32_t mIndex;
+
+        struct Row {
+            uint64_t* cells{nullptr};
+            bool shared{false};
+        };
+
+        static Row& row() {
+            static thread_local Row r;
+            if (!r.cells) {
+                r.cells = MetricsRegistry::instance().threadRow(r.shared);
+            }
+            return r;
+        }
+
+    public:
+        explicit Counter(const char* name) : mIndex(MetricsRegistry::instance().counter(name)) {}
+
+        void add(uint64_t n = 1) noexcept {
+            Row& r = row();
+            uint64_t& cell = r.cells[mIndex];
+            if (r.shared) {
+                __atomic_fetch_add(&cell, n, __ATOMIC_RELAXED);
+            }
+            else {
+                __atomic_store_n(&cell, __atomic_load_n(&cell, __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+            }
+        }
+    };
+
+    /**
+     * @class Gauge
+     * @brief Handle of a registered gauge (queue depth, ...): the last set() wins.
+     */
+    class Gauge {
+        int64_t* mValue;
+
+    public:
+        explicit Gauge(const char* name) : mValue(MetricsRegistry::instance().gauge(name)) {}
+
+        void set(int64_t v) noexcept { __atomic_store_n(mValue, v, __ATOMIC_RELAXED); }
+        void add(int64_t d) noexcept { __atomic_fetch_add(mValue, d, __ATOMIC_RELAXED); }
+    };
+
+    /**
+     * @class MetricsReader
+     * @brief Read-only view of the metrics segment of another process.
+     */
+    class MetricsReader {
+        const MetricsSegment* mSegment{nullptr};
+        size_t mSize{0};
+
+    public:
+        /** @brief Maps "EXCHANGE_METRICS_<process>", throws if absent, invalid or stale. */
+        explicit MetricsReader(const Core::String& process) {
+            const Core::String name = Core::String(METRICS_SEGMENT_PREFIX) + process;
+            int fd;
+            void* base = Ipc::mapSegment(name, mSize, false, false, fd);
+            ::close(fd);
+            mSegment = static_cast<const MetricsSegment*>(base);
+            if (mSize < sizeof(MetricsSegment)
+                || std::strncmp(mSegment->signature, METRICS_MAGIC, sizeof(mSegment->signature)) != 0) {
+                ENG_THROW("'%s' is not a metrics segment", name.get());
+            }
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            Ipc::checkSession("/" + name, mSegment->uuid);
+        }
+
+        ~MetricsReader() {
+            ::munmap(const_cast<MetricsSegment*>(mSegment), mSize);
+        }
+
+        MetricsReader(const MetricsReader&) = delete;
+        MetricsReader& operator=(const MetricsReader&) = delete;
+
+        const MetricsSegment& segment() const { return *mSegment; }
+
+        uint32_t size() const { return __atomic_load_n(&mSegment->metricCount, __ATOMIC_ACQUIRE); }
+        const MetricDesc& desc(uint32_t i) const { return mSegment->metrics[i]; }
+
+        /** @brief Sum of the thread cells of counter `index`. */
+        uint64_t counter(uint32_t index) const {
+            uint64_t sum = 0;
+            for (uint32_t t = 0; t < MetricsSegment::MAX_THREADS; ++t) {
+                sum += __atomic_load_n(&mSegment->counters[t][index], __ATOMIC_RELAXED);
+            }
+            return sum;
+        }
+
+        int64_t gauge(uint32_t index) const {
+            return __atomic_load_n(&mSegment->gauges[index].value, __ATOMIC_RELAXED);
+        }
+
+        /** @brief View of histogram `index`; read only, the segment is mapped PROT_READ. */
+        HdrHistogram histogram(uint32_t index) const {
+            return HdrHistogram(const_cast<HdrHistogramData*>(&mSegment->histograms[index]));
+        }
+    };
+
+} // namespace Exchange::Core
@@ -0,0 +1,355 @@
+#pragma once
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "Clock/TscClock.h"
+#include "Worker/Worker.h"
+
+/**
+ * @class FramePool
+ * @brief Allocator of coroutine frames: per-thread free lists by size class, so that
+ * creating and destroying frames in steady state costs no heap allocation.
+ *
+ * @details
+ * Frames are rounded up to GRANULE bytes; frames above CLASSES * GRANULE go to the heap.
+ * A freed frame goes to the free list of the freeing thread, which keeps at most
+ * CACHE_LIMIT frames per class and returns the rest to the heap. The lists are released
+ * when the thread exits.
+ */
+class FramePool
+{
+ static constexpr size_t GRANULE = 64;
+ static constexpr size_t CLASSES = 32;        ///> Pooled frames up to 2 KiB
+ static constexpr uint32_t CACHE_LIMIT = 1024; ///> Frames kept per class and thread
+
+ struct Block
+ {
+  Block* next;
+ };
+
+ struct Cache
+ {
+  Block* head[CLASSES]{};
+  uint32_t count[CLASSES]{};
+
+  ~Cache()
+  {
+   for(Block* b : head)
+   {
+    while(b)
+    {
+     Block* next = b->next;
+     ::operator delete(b);
+     b = next;
+    }
+   }
+  }
+ };
+
+ static Cache& cache() noexcept
+ {
+  static thread_local Cache c;
+  return c;
+ }
+
+public:
+ static void* allocate(size_t size)
+ {
+  const size_t c = (size - 1) / GRANULE;
+  if(c >= CLASSES)
+  {
+   return ::operator new(size);
+  }
+  Cache& k = cache();
+  if(Block* b = k.head[c])
+  {
+   k.head[c] = b->next;
+   --k.count[c];
+   return b;
+  }
+  return ::operator new((c + 1) * GRANULE);
+ }
+
+ static void deallocate(void* p, size_t size) noexcept
+ {
+  const size_t c = (size - 1) / GRANULE;
+  if(c >= CLASSES)
+  {
+   ::operator delete(p);
+   return;
+  }
+  Cache& k = cache();
+  if(k.count[c] >= CACHE_LIMIT)
+  {
+   ::operator delete(p);
+   return;
+  }
+  Block* b = static_cast<Block*>(p);
+  b->next = k.head[c];
+  k.head[c] = b;
+  ++k.count[c];
+ }
+};
+
+/** @brief Part of the Co promise which does not depend on the result type. */
+struct CoPromiseBase
+{
+ std::coroutine_handle<> continuation; ///> Coroutine awaiting this one
+ std::exception_ptr error;
+ bool detached{false};                 ///> Started by spawn(), frees itself when done
+
+ static void* operator new(size_t size) { return FramePool::allocate(size); }
+ static void operator delete(void* p, size_t size) noexcept { FramePool::deallocate(p, size); }
+
+ std::suspend_always initial_suspend() noexcept { return {}; }
+ void unhandled_exception() noexcept { error = std::current_exception(); }
+
+ struct FinalAwaiter
+ {
+  bool await_ready() const noexcept { return false; }
+
+  template<typename P>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+  {
+   CoPromiseBase& p = h.promise();
+   if(p.continuation)
+   {
+    return p.continuation;  // Symmetric transfer, no stack growth along a chain
+   }
+   if(p.detached)
+   {
+    if(p.error)
+    {
+     report(p.error);
+    }
+    h.destroy();
+   }
+   return std::noop_coroutine();
+  }
+
+  void await_resume() const noexcept {}
+ };
+
+ FinalAwaiter final_suspend() noexcept { return {}; }
+
+ static void report(const std::exception_ptr& error) noexcept
+ {
+  try
+  {
+   std::rethrow_exception(error);
+  }
+  catch(const std::exception& e)
+  {
+   std::cerr<<"[Coroutine]: detached coroutine failed: "<<e.what()<<std::endl;
+  }
+  catch(...)
+  {
+   std::cerr<<"[Coroutine]: detached coroutine failed"<<std::endl;
+  }
+ }
+};
+
+template<typename T>
+struct CoPromise : CoPromiseBase
+{
+ std::optional<T> value;
+
+ template<typename U = T>
+ void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+
+ T take()
+ {
+  if(error)
+  {
+   std::rethrow_exception(error);
+  }
+  return std::move(*value);
+ }
+};
+
+template<>
+struct CoPromise<void> : CoPromiseBase
+{
+ void return_void() noexcept {}
+
+ void take()
+ {
+  if(error)
+  {
+   std::rethrow_exception(error);
+  }
+ }
+};
+
+/**
+ * @class Co
+ * @brief Coroutine returning T, for sequential flows (session logon, resend, recovery)
+ * which wait without blocking a worker thread.
+ *
+ * @details
+ * A Co is lazy: it runs when awaited by another coroutine, which it resumes when done,
+ * or when started on a worker by spawn(). Its frame comes from the FramePool. An
+ * exception escaping the coroutine is rethrown to the awaiting coroutine; a spawned
+ * coroutine only logs it.
+ * Coroutines should take their parameters by value: a reference may dangle once the
+ * coroutine is suspended.
+ *
+ * @example
+ * Co<void> session(Scheduler& s, WorkerHandle w) {
+ *     co_await s.schedule(w);                     // Continue on worker w
+ *     co_await sleepFor(std::chrono::seconds(30)); // Heartbeat interval, worker is free meanwhile
+ * }
+ */
+template<typename T = void>
+class [[nodiscard]] Co
+{
+public:
+ struct promise_type : CoPromise<T>
+ {
+  Co get_return_object() noexcept { return Co(std::coroutine_handle<promise_type>::from_promise(*this)); }
+ };
+ using Handle = std::coroutine_handle<promise_type>;
+
+private:
+ Handle mHandle;
+
+public:
+ explicit Co(Handle h) noexcept : mHandle(h) {}
+ Co(Co&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+ Co(const Co&) = delete;
+ Co& operator=(const Co&) = delete;
+ Co& operator=(Co&& other) noexcept
+ {
+  if(this != &other)
+  {
+   if(mHandle) mHandle.destroy();
+   mHandle = std::exchange(other.mHandle, nullptr);
+  }
+  return *this;
+ }
+ ~Co() { if(mHandle) mHandle.destroy(); }
+
+ /** @brief Gives up ownership of the frame. */
+ Handle release() noexcept { return std::exchange(mHandle, nullptr); }
+
+ auto operator co_await() && noexcept
+ {
+  struct Awaiter
+  {
+   Handle h;
+
+   bool await_ready() const noexcept { return false; }
+
+   std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+   {
+    h.promise().continuation = caller;
+    return h;
+   }
+
+   T await_resume() { return h.promise().take(); }
+  };
+  return Awaiter{mHandle};
+ }
+};
+
+/** @brief Starts `co` on `worker`, detached: the frame is freed when it completes. */
+inline void spawn(Worker& worker, Co<void> co)
+{
+ auto h = co.release();
+ h.promise().detached = true;
+ worker.resume(h);
+}
+
+/** @brief The worker running the calling coroutine. @throws std::logic_error outside workers. */
+inline Worker& currentWorker()
+{
+ Worker* w = Worker::current();
+ if(!w)
+ {
+  throw std::logic_error("Coroutine awaits on a thread which is not a Worker");
+ }
+ return *w;
+}
+
+/** @brief Awaiter continuing the coroutine on `worker` (no-op if already there). */
+struct ResumeOn
+{
+ Worker* worker;
+
+ bool await_ready() const noexcept { return Worker::current() == worker; }
+ void await_suspend(std::coroutine_handle<> h) const { worker->resume(h); }
+ void await_resume() const noexcept {}
+};
+
+/** @brief Awaiter letting the tasks queued on the current worker run first. */
+struct Yield
+{
+ bool await_ready() const noexcept { return false; }
+ void await_suspend(std::coroutine_handle<> h) const { currentWorker().resume(h); }
+ void await_resume() const noexcept {}
+};
+
+inline Yield yield() noexcept { return {}; }
+
+/** @brief Awaiter resuming on the current worker once TscClock::now() reaches `deadline`. */
+struct SleepUntil
+{
+ uint64_t deadline;
+
+ bool await_ready() const noexcept { return Exchange::Core::TscClock::now() >= deadline; }
+ void await_suspend(std::coroutine_handle<> h) const { currentWorker().resumeAt(deadline, h); }
+ void await_resume() const noexcept {}
+};
+
+/** @param deadlineNs TscClock nanoseconds since epoch */
+inline SleepUntil sleepUntil(uint64_t deadlineNs) noexcept { return {deadlineNs}; }
+
+inline SleepUntil sleepFor(std::chrono::nanoseconds d) noexcept
+{
+ return {Exchange::Core::TscClock::now() + static_cast<uint64_t>(d.count())};
+}
+
+/// Polls of an empty source before nextMessage() backs off to MESSAGE_POLL_INTERVAL.
+static constexpr int MESSAGE_POLL_SPINS = 64;
+static constexpr std::chrono::microseconds MESSAGE_POLL_INTERVAL{50};
+
+/**
+ * @brief Waits for the next message of `source` (an Ipc::Consumer, or anything with
+ * `uint32_t read(void*, uint32_t)` returning 0 when empty) without blocking the worker.
+ * @details An empty source is polled again after the tasks queued on the worker, then,
+ * after MESSAGE_POLL_SPINS polls, every MESSAGE_POLL_INTERVAL.
+ * @return Size of the message copied to `buffer`.
+ */
+template<typename Source>
+Co<uint32_t> nextMessage(Source& source, void* buffer, uint32_t size)
+{
+ for(int polls = 0;; ++polls)
+ {
+  if(const uint32_t bytes = source.read(buffer, size))
+  {
+   co_return bytes;
+  }
+  if(polls < MESSAGE_POLL_SPINS)
+  {
+   co_await yield();
+  }
+  else
+  {
+   co_await sleepFor(MESSAGE_POLL_INTERVAL);
+  }
+ }
+}
+
+#endif //COROUTINE_H
@@ -0,0 +1,331 @@
+#pragma once
+
+#ifndef FUTURE_H
+#define FUTURE_H
+
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+template<typename T> class Future;
+template<typename T> class Promise;
+
+/**
+ * @class FutureState
+ * @brief Shared state of a Future: the result (value or exception), a reference count
+ * and at most one continuation. Intrusively counted, so a state and what produces it
+ * (see TaskState) are a single allocation.
+ *
+ * @details
+ * `mStatus` goes EMPTY -> READY when the result is set, or EMPTY -> CHAINED -> READY when
+ * a continuation is attached first. Whoever moves it last runs the continuation: the
+ * completing thread if it finds CHAINED, else then() itself, inline. Waiters block on
+ * `mStatus` (futex) only when the result is not there yet.
+ */
+template<typename T>
+class FutureState
+{
+public:
+ using Value = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+ /** @brief Work attached by Future::then(), run once the result is set. */
+ struct Continuation
+ {
+  virtual ~Continuation() = default;
+  virtual void run(FutureState& source) noexcept = 0;
+ };
+
+private:
+ enum : uint32_t { EMPTY = 0, CHAINED = 1, READY = 2 };
+
+ std::atomic<uint32_t> mRefs{1};
+ std::atomic<uint32_t> mStatus{EMPTY};
+ std::optional<Value> mValue;
+ std::exception_ptr mError;
+ Continuation* mNext{nullptr};
+
+ void complete() noexcept
+ {
+  if(mStatus.exchange(READY, std::memory_order_acq_rel) == CHAINED)
+  {
+   mNext->run(*this);
+  }
+  mStatus.notify_all();
+ }
+
+public:
+ FutureState() = default;
+ FutureState(const FutureState&) = delete;
+ FutureState& operator=(const FutureState&) = delete;
+ virtual ~FutureState() = default;
+
+ void retain() noexcept { mRefs.fetch_add(1, std::memory_order_relaxed); }
+ void release() noexcept
+ {
+  if(mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+  {
+   delete this;
+  }
+ }
+
+ template<typename... A>
+ void setValue(A&&... value)
+ {
+  mValue.emplace(std::forward<A>(value)...);
+  complete();
+ }
+
+ void setError(std::exception_ptr error) noexcept
+ {
+  mError = std::move(error);
+  complete();
+ }
+
+ bool ready() const noexcept { return mStatus.load(std::memory_order_acquire) == READY; }
+
+ void wait() const noexcept
+ {
+  uint32_t s;
+  while((s = mStatus.load(std::memory_order_acquire)) != READY)
+  {
+   mStatus.wait(s, std::memory_order_acquire);
+  }
+ }
+
+ /** @brief The value, rethrows the stored exception. Only once ready(). */
+ Value& value()
+ {
+  if(mError)
+  {
+   std::rethrow_exception(mError);
+  }
+  return *mValue;
+ }
+
+ const std::exception_ptr& error() const noexcept { return mError; }
+
+ /**
+  * @brief Attaches `next`, run when the result is set.
+  * @return false if the result is already set: the caller runs `next` itself.
+  */
+ bool chain(Continuation* next) noexcept
+ {
+  mNext = next;
+  uint32_t expected = EMPTY;
+  return mStatus.compare_exchange_strong(expected, CHAINED, std::memory_order_acq_rel);
+ }
+};
+
+/**
+ * @class Future
+ * @brief Move-only handle on the result of an asynchronous computation, lighter than
+ * std::future: one allocation shared with the producer, no mutex, and continuations.
+ */
+template<typename T>
+class Future
+{
+ template<typename> friend class Future;
+ template<typename> friend class Promise;
+
+ FutureState<T>* mState{nullptr};
+
+ template<typename U, typename F>
+ struct ThenState final : FutureState<U>, FutureState<T>::Continuation
+ {
+  F fn;
+
+  explicit ThenState(F&& f) : fn(std::move(f)) {}
+
+  void run(FutureState<T>& source) noexcept override
+  {
+   if(source.error())
+   {
+    this->setError(source.error());
+   }
+   else
+   {
+    try
+    {
+     if constexpr(std::is_void_v<T> && std::is_void_v<U>) { fn(); this->setValue(); }
+     else if constexpr(std::is_void_v<T>) { this->setValue(fn()); }
+     else if constexpr(std::is_void_v<U>) { fn(std::move(source.value())); this->setValue(); }
+     else { this->setValue(fn(std::move(source.value()))); }
+    }
+    catch(...)
+    {
+     this->setError(std::current_exception());
+    }
+   }
+   this->release();  // The reference held on behalf of the source
+  }
+ };
+
+public:
+ Future() noexcept = default;
+ /** @brief Adopts one reference on `state`. */
+ explicit Future(FutureState<T>* state) noexcept : mState(state) {}
+ Future(Future&& other) noexcept : mState(std::exchange(other.mState, nullptr)) {}
+ Future& operator=(Future&& other) noexcept
+ {
+  if(this != &other)
+  {
+   if(mState) mState->release();
+   mState = std::exchange(other.mState, nullptr);
+  }
+  return *this;
+ }
+ Future(const Future&) = delete;
+ Future& operator=(const Future&) = delete;
+ ~Future() { if(mState) mState->release(); }
+
+ bool valid() const noexcept { return mState != nullptr; }
+ bool ready() const noexcept { return mState && mState->ready(); }
+ void wait() const noexcept { mState->wait(); }
+
+ /** @brief Waits for the result and returns it, or rethrows the task's exception. */
+ T get()
+ {
+  mState->wait();
+  if constexpr(std::is_void_v<T>)
+  {
+   mState->value();
+  }
+  else
+  {
+   return std::move(mState->value());
+  }
+ }
+
+ /**
+  * @brief Chains `f`, called with the value (nothing for void) once it is set, on the
+  * thread which sets it, or right away if it is already set. An exception, stored or
+  * thrown by `f`, skips `f` and goes to the returned future. Consumes this future.
+  */
+ template<typename F>
+ auto then(F&& f) &&
+ {
+  using Fn = std::decay_t<F>;
+  using U = std::conditional_t<std::is_void_v<T>, std::invoke_result<Fn&>, std::invoke_result<Fn&, T&&>>;
+  using R = typename U::type;
+
+  auto* next = new ThenState<R, Fn>(std::forward<F>(f));
+  next->retain();  // For the source, released by run()
+  FutureState<T>* source = std::exchange(mState, nullptr);
+  if(!source->chain(next))
+  {
+   next->run(*source);
+  }
+  source->release();
+  return Future<R>(next);
+ }
+};
+
+/**
+ * @class Promise
+ * @brief Producer side of a Future. A promise destroyed without a result breaks its
+ * future (std::runtime_error "Broken promise").
+ */
+template<typename T>
+class Promise
+{
+ FutureState<T>* mState;
+
+public:
+ Promise() : mState(new FutureState<T>()) {}
+ Promise(Promise&& other) noexcept : mState(std::exchange(other.mState, nullptr)) {}
+ Promise(const Promise&) = delete;
+ Promise& operator=(const Promise&) = delete;
+ Promise& operator=(Promise&&) = delete;
+ ~Promise()
+ {
+  if(mState)
+  {
+   if(!mState->ready())
+   {
+    mState->setError(std::make_exception_ptr(std::runtime_error("Broken promise")));
+   }
+   mState->release();
+  }
+ }
+
+ /** @brief The future of this promise, call once. */
+ Future<T> getFuture()
+ {
+  mState->retain();
+  return Future<T>(mState);
+ }
+
+ template<typename... A>
+ void setValue(A&&... value) { mState->setValue(std::forward<A>(value)...); }
+ void setError(std::exception_ptr error) { mState->setError(std::move(error)); }
+};
+
+/**
+ * @class TaskState
+ * @brief Shared state which also stores the callable and its arguments, so a task
+ * returning a Future costs one allocation and the task itself captures one pointer.
+ */
+template<typename R, typename Fn, typename... Args>
+class TaskState final : public FutureState<R>
+{
+ Fn mFn;
+ std::tuple<Args...> mArgs;
+
+public:
+ template<typename F, typename... A>
+ explicit TaskState(F&& f, A&&... args) : mFn(std::forward<F>(f)), mArgs(std::forward<A>(args)...) {}
+
+ /** @brief Runs the callable once and stores its result or exception. */
+ void run() noexcept
+ {
+  try
+  {
+   if constexpr(std::is_void_v<R>)
+   {
+    std::apply(mFn, std::move(mArgs));
+    this->setValue();
+   }
+   else
+   {
+    this->setValue(std::apply(mFn, std::move(mArgs)));
+   }
+  }
+  catch(...)
+  {
+   this->setError(std::current_exception());
+  }
+ }
+
+ /**
+  * @brief Reference held by the task. Released with the task; if the task is cancelled
+  * or dropped without running, the future is broken rather than left waiting forever.
+  */
+ class Ref
+ {
+  TaskState* mState;
+
+ public:
+  explicit Ref(TaskState* state) noexcept : mState(state) {}
+  Ref(Ref&& other) noexcept : mState(std::exchange(other.mState, nullptr)) {}
+  Ref(const Ref&) = delete;
+  ~Ref()
+  {
+   if(mState)
+   {
+    if(!mState->ready())
+    {
+     mState->setError(std::make_exception_ptr(std::runtime_error("Task cancelled or dropped before running")));
+    }
+    mState->release();
+   }
+  }
+  TaskState* operator->() const noexcept { return mState; }
+ };
+};
+
+#endif //FUTURE_H
@@ -13,26 +13,37 @@ Scheduler::~Scheduler()
 }
 
 
-void Scheduler::createWorker(const std::string& id)
+WorkerHandle Scheduler::createWorker(const std::string& id, const WorkerSpec& spec)
 {
     std::unique_lock wlk(mLock);
 
     // Check if worker with id already exists.
-    if(mWorkers.contains(id))
+    if(mHandles.contains(id))
     {
         throw std::runtime_error("Worker: "+id+" already exists");
     }
-    mWorkers.emplace(id, std::make_unique<Worker>(id));
+    const WorkerHandle w = mWorkerCount.load(std::memory_order_relaxed);
+    if(w >= MAX_WORKERS)
+    {
+        throw std::runtime_error("Worker: "+id+" exceeds the maximum number of workers");
+    }
+    mWorkers[w] = std::make_unique<Worker>(id, spec);
+    mHandles.emplace(id, w);
+    // Publish the worker before its handle becomes valid for lock-free lookups
+    mWorkerCount.store(w + 1, std::memory_order_release);
+    return w;
 }
 
 void Scheduler::createWorkers(const std::string& prefix, const size_t cnt)
 {
     {
-        std::shared_lock<std::shared_mutex> rlk(mLock);
-        if(mWorkers.size())
+        std::unique_lock<std::shared_mutex> wlk(mLock);
+        const uint32_t n = mWorkerCount.exchange(0, std::memory_order_acq_rel);
+        for(uint32_t w = 0; w < n; ++w)
         {
-            mWorkers.clear();
+            mWorkers[w].reset();
         }
+        mHandles.clear();
     }
     for(size_t i = 0 ; i < cnt ; i++)
     {
@@ -40,17 +51,44 @@ void Scheduler::createWorkers(const std::string& prefix, const size_t cnt)
     }
 }
 
+WorkStealingPool& Scheduler::createPool(size_t threads, WorkerSpec spec)
+{
+    std::unique_lock wlk(mLock);
+    if(mPool)
+    {
+        throw std::runtime_error("Scheduler pool already exists");
+    }
+    if(spec.cpus.empty())
+    {
+        std::vector<int> reserved;
+        const uint32_t n = mWorkerCount.load(std::memory_order_relaxed);
+        for(uint32_t w = 0; w < n; ++w)
+        {
+            reserved.insert(reserved.end(), mWorkers[w]->mSpec.cpus.begin(), mWorkers[w]->mSpec.cpus.end());
+        }
+        spec.cpus = WorkStealingPool::spareCpus(reserved);
+    }
+    mPool = std::make_unique<WorkStealingPool>(threads ? threads : spec.cpus.size(), std::move(spec));
+    return *mPool;
+}
+
 void Scheduler::start()
 {
     std::unique_lock wlk(mLock);
-    for (auto& [_, worker] : mWorkers)
+    const uint32_t n = mWorkerCount.load(std::memory_order_relaxed);
+    for (uint32_t w = 0; w < n; ++w)
+    {
+        mWorkers[w]->start();
+    }
+    if(mPool)
     {
-        worker->start();
+        mPool->start();
     }
 }
 
 void Scheduler::shutdown()
 {
+    uint32_t n;
     {
         std::unique_lock<std::shared_mutex> wlk(mLock);
         if(mShutdown)
@@ -58,91 +96,57 @@ void Scheduler::shutdown()
             return;
         }
         mShutdown = true;
-        for(auto& [_,worker]:mWorkers)
+        n = mWorkerCount.load(std::memory_order_relaxed);
+        for(uint32_t w = 0; w < n; ++w)
         {
-            worker->postStop();
+            mWorkers[w]->postStop();
         }
     }
-    for(auto& [_,worker]:mWorkers)
+    for(uint32_t w = 0; w < n; ++w)
+    {
+        mWorkers[w]->join();
+    }
+    // After the workers, which may still have submitted background work
+    if(mPool)
     {
-        worker->join();
+        mPool->shutdown();
     }
     std::unique_lock<std::shared_mutex> wlk(mLock);
-    mWorkers.clear();
-}
-
-uint64_t Scheduler::submitTo(const std::string& wId, const TaskFn& func, const std::string& desc)
-{
-    const auto t = makeTask(func,desc);
-    auto* w = getWorker(wId);
-    w->postTask(t);
-    return t.id;
+    mWorkerCount.store(0, std::memory_order_release);
+    for(uint32_t w = 0; w < n; ++w)
+    {
+        mWorkers[w].reset();
+    }
+    mHandles.clear();
 }
 
-Task Scheduler::makeTask(const TaskFn& fn, const std::string& desc)
+Task Scheduler::makeTask(TaskFn fn, const char* desc, CancelToken token)
 {
     Task t;
     t.id = nextTaskId();
-    t.func = fn;
-    t.token = CancelToken();
+    t.func = std::move(fn);
+    t.token = std::move(token);
     t.desc = desc;
     return t;
 }
 
-template <typename F, typename... Args>
-auto Scheduler::submitToWithFuture(const std::string& wid, F&& f, Args&&... args)
-    -> std::future<std::invoke_result_t<F, Args...>>
+WorkerHandle Scheduler::handleOf(const std::string& id) const
 {
-    using R = std::invoke_result_t<F, Args...>; // Result type
-    auto pkg = std::make_shared<std::promise<R>>();
-    auto fut = pkg->get_future();
-
-    auto wrapper = [pkg, fn = std::forward<F>(f), tup = std::make_tuple(std::forward<Args>(args)...)]
-    (const CancelToken& token) mutable
+    std::shared_lock<std::shared_mutex> rlk(mLock); // read only lock
+    const auto it = mHandles.find(id);
+    if(it == mHandles.end())
     {
-        // Optionally check token before running
-        if(token.isCancelled())
-        {
-            // For promise types, set an exception or set_defaults
-            try
-            {
-                throw std::runtime_error("Task cancelled");
-            }
-            catch (...)
-            {
-                pkg->set_exception(std::current_exception());
-            }
-            return;
-        }
-        try
-        {
-            if constexpr (std::is_void_v<R>)
-            {
-                std::apply(fn, tup);
-                pkg->set_value();
-            }
-            else
-            {
-                R r = std::apply(fn, tup);
-                pkg->set_value(std::move(r));
-            }
-        }
-        catch (...)
-        {
-            pkg->set_exceeption(std::current_exception());
-        }
-    };
-    auto t = makeTask(std::move(wrapper),"future_task");
-    getWorker(wid)->postTask(t);
-    return fut;
+        throw std::runtime_error("Worker not found: " + id);
+    }
+    return it->second;
 }
 
 std::vector<std::string> Scheduler::workerIds() const
 {
     std::vector<std::string> ids;
     std::shared_lock<std::shared_mutex> rlk(mLock);
-    ids.reserve(mWorkers.size());
-    for(auto const& [id,_] : mWorkers)
+    ids.reserve(mHandles.size());
+    for(auto const& [id,_] : mHandles)
     {
         ids.push_back(id);
     }
@@ -152,5 +156,5 @@ std::vector<std::string> Scheduler::workerIds() const
 bool Scheduler::hasWorker(const std::string& id) const
 {
     std::shared_lock<std::shared_mutex> rlk(mLock);
-    return mWorkers.count(id) != 0 ;
-}
\ No newline at end of file
+    return mHandles.count(id) != 0 ;
+}
@@ -7,24 +7,19 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
+#include <atomic>
 #include <map>
 #include <shared_mutex>
-#include <future>
-#include <variant>
+#include "Coroutine.h"
+#include "Future.h"
 #include "Worker/Task.h"
 #include "Worker/Worker.h"
+#include "WorkStealingPool.h"
 
 struct Worker;
-class Order;
 
-
-namespace Msg
-{
- struct AddBook {std::string symbol;};
- struct NewOrder {std::string symbol; Order* order;};
- struct ControlStop {};
- using Msg = std::variant<AddBook,NewOrder,ControlStop>;
- }
+/** @brief Index of a worker in its Scheduler, returned by createWorker(). */
+using WorkerHandle = uint32_t;
 
 /**
  * @class Scheduler
@@ -33,16 +28,33 @@ namespace Msg
  *
  * It provides a framework for async task execution across a configurable number of worker threads.
  * Each worker maintains its own task queue and continuously processes task in FIFO order.  Task can
- * be submitted to specific workers using `submitTo()` or with a returnable `std::future` via
+ * be submitted to specific workers using `submitTo()` or with a returnable `Future` via
  * `submitToWithFuture()`.
+ *
+ * @details
+ * Workers are addressed by the WorkerHandle createWorker() returns: submitting by handle is
+ * an array index and a lock-free push, no lock and no map lookup. The string id overloads
+ * resolve the handle first (shared lock + map lookup) and are meant for start-up code.
+ * Workers are created before start() and live until shutdown().
+ *
+ * Next to the named workers, which own the latency critical loops, createPool() adds a
+ * WorkStealingPool for background work: submit() without a worker id and parallelFor().
+ *
+ * Coroutines (Co, see Coroutine.h) run on the named workers: spawn() starts one and
+ * `co_await schedule(w)` moves the calling coroutine to worker w.
  */
 class Scheduler
 {
- // using WorkerMap = std::map<std::string, std::unique_ptr<Worker>>;
+public:
+ static constexpr WorkerHandle MAX_WORKERS = 64;
 
+private:
  // <====== Data Members ======>
- std::map<std::string, std::unique_ptr<Worker>> mWorkers; ///< Holds all the workers currently active by their id
- mutable  std::shared_mutex mLock; ///< Mutex for WorkerMap
+ std::unique_ptr<Worker> mWorkers[MAX_WORKERS]; ///< Workers by handle
+ std::atomic<uint32_t> mWorkerCount{0}; ///< Handles [0, count) are valid
+ std::map<std::string, WorkerHandle> mHandles; ///< Handle of every worker id
+ std::unique_ptr<WorkStealingPool> mPool; ///< Optional pool for background work
+ mutable  std::shared_mutex mLock; ///< Mutex for mHandles and worker creation
  bool mShutdown{false}; ///> Indicates that all workers are shutdown
 
 public:
@@ -71,12 +83,15 @@ public:
  /**
    * @brief  Creates and reserves a single worker with a unique identifier.
    * @param id The string identifier for the worker (e.g., "worker_1")
-   * @throws std::runtime_error If a worker with the same id already exists.
+   * @param spec CPUs, SCHED_FIFO priority and name of the worker thread, applied when it starts.
+   * @return Handle to submit tasks to the worker.
+   * @throws std::runtime_error If a worker with the same id already exists or MAX_WORKERS is reached.
    */
- void createWorker(const std::string& id);
+ WorkerHandle createWorker(const std::string& id, const WorkerSpec& spec = {});
 
  /**
-  * @brief Reserves multiple workers using a naming prefix.
+  * @brief Reserves multiple workers using a naming prefix. Existing workers are discarded,
+  * so it must be called before start().
   * @param prefix The prefix for worker's names.
   * @param cnt The number of workers to create.
   *
@@ -86,51 +101,149 @@ public:
  void createWorkers(const std::string& prefix, size_t cnt);
 
  /**
-  * @brief Submits a fire-and-forget task to a worker
-  * @param wId Unique identified of workers
-  * @param func Callable which the task will call
-  * @param desc
+  * @brief Submits a fire-and-forget task to a worker. Performs no heap allocation.
+  * @param w Handle of the worker
+  * @param func Callable which the task will call, moved into the task
+  * @param desc Static description of the task
+  * @param token Token to cancel the task before it starts (CancelToken::create()), empty by default
   * @return Task Id
   */
- uint64_t submitTo(const std::string& wId, const TaskFn& func, const std::string& desc = "");
+ uint64_t submitTo(WorkerHandle w, TaskFn func, const char* desc = "", CancelToken token = {})
+ {
+  Task t = makeTask(std::move(func), desc, std::move(token));
+  const uint64_t id = t.id;
+  getWorker(w)->postTask(std::move(t));
+  return id;
+ }
+
+ /** @brief submitTo() by worker id, resolves the handle first. */
+ uint64_t submitTo(const std::string& wId, TaskFn func, const char* desc = "", CancelToken token = {})
+ {
+  return submitTo(handleOf(wId), std::move(func), desc, std::move(token));
+ }
 
  /**
   * Helper method to create a task.
   * @param fn Callable which will be called during execution.
   * @param desc Description of task (optional)
+  * @param token Cancel token of the task (optional)
   * @return
   */
- static Task makeTask(const TaskFn& fn, const std::string& desc = "");
+ static Task makeTask(TaskFn fn, const char* desc = "", CancelToken token = {});
+
+ /** @brief Awaitable continuing the calling coroutine on worker `w`. */
+ ResumeOn schedule(WorkerHandle w) const
+ {
+  return ResumeOn{getWorker(w)};
+ }
+
+ /** @brief Starts the coroutine `co` on worker `w`, detached. */
+ void spawn(WorkerHandle w, Co<void> co)
+ {
+  ::spawn(*getWorker(w), std::move(co));
+ }
+
+ /**
+  * @brief Creates the work-stealing pool. Call it after the named workers are created:
+  * by default the pool avoids their CPUs.
+  * @param threads Number of pool threads, 0 = one per spare CPU (see WorkStealingPool::spareCpus()).
+  * @param spec Placement of the pool threads; without CPUs, the spare CPUs.
+  * @throws std::runtime_error If the pool already exists.
+  */
+ WorkStealingPool& createPool(size_t threads = 0, WorkerSpec spec = {});
+
+ /** @brief The pool. @throws std::runtime_error If createPool() was not called. */
+ WorkStealingPool& pool() const
+ {
+  if(!mPool)
+  {
+   throw std::runtime_error("Scheduler has no work-stealing pool");
+  }
+  return *mPool;
+ }
+
+ /** @brief Submits a task to the pool, to whichever pool thread is free first. */
+ uint64_t submit(TaskFn func, const char* desc = "", CancelToken token = {})
+ {
+  return pool().submit(std::move(func), desc, std::move(token));
+ }
+
+ /** @brief See WorkStealingPool::parallelFor(). */
+ template<typename F>
+ void parallelFor(size_t begin, size_t end, size_t grain, F&& body)
+ {
+  pool().parallelFor(begin, end, grain, std::forward<F>(body));
+ }
+
+ /**
+  * @brief Handle of the worker `id`.
+  * @throws std::runtime_error If there is no such worker.
+  */
+ WorkerHandle handleOf(const std::string& id) const;
 
  /**
   * @brief Locates the worker pointer
-  * @param id Identifier of thread needed to be located
-  * @return Worker pointer3
+  * @param w Handle of the worker needed to be located
+  * @return Worker pointer
   */
- Worker* getWorker(const std::string& id)
+ Worker* getWorker(WorkerHandle w) const
  {
-  std::shared_lock<std::shared_mutex> rlk(mLock); // read only lock
-  const auto it = mWorkers.find(id);
-   if(it==mWorkers.end())
-   {
-    throw std::runtime_error("Worker not found: " + id);
-   }
-   return it->second.get();
+  if(w >= mWorkerCount.load(std::memory_order_acquire))
+  {
+   throw std::runtime_error("Worker not found: #" + std::to_string(w));
   }
+  return mWorkers[w].get();
+ }
+
+ Worker* getWorker(const std::string& id) const
+ {
+  return getWorker(handleOf(id));
+ }
 
  /**
-  *
+  * @brief Submits f(args...) to a worker and returns a Future of its result, for
+  * request/response work such as control-plane queries to a worker.
+  * @details The callable, its arguments and the result share one allocation; the task
+  * itself only carries a pointer to it. An exception thrown by f is stored in the
+  * future. A task cancelled through `token` breaks the future (std::runtime_error).
   * @tparam F The callable type (lambda, function, or functor).
-  * @tparam Args The types of arguments to pass to the callable.
-  * @param wid The identifier of the worker thread that should run the task
+  * @tparam Args The types of arguments to pass to the callable, stored by value.
+  * @param w Handle of the worker which runs the task
   * @param f The callable to execute asynchronously.
   * @param args Arguments to pass to the callable.
-  * @return A future that can be used to retrieve the callable's
-  * return value.
+  * @return A future that can be used to retrieve the callable's return value.
   */
- template<typename  F,typename ...Args>
+ template<typename F, typename... Args>
+ auto submitToWithFuture(WorkerHandle w, F&& f, Args&&... args)
+  -> Future<std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>>
+ {
+  return submitToWithFuture(w, CancelToken{}, std::forward<F>(f), std::forward<Args>(args)...);
+ }
+
+ /** @brief submitToWithFuture() with a cancel token. */
+ template<typename F, typename... Args>
+ auto submitToWithFuture(WorkerHandle w, CancelToken token, F&& f, Args&&... args)
+  -> Future<std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>>
+ {
+  using R = std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>;
+  using State = TaskState<R, std::decay_t<F>, std::decay_t<Args>...>;
+
+  Worker* worker = getWorker(w);
+  auto* state = new State(std::forward<F>(f), std::forward<Args>(args)...);
+  Future<R> future(state);
+  state->retain();  // For the task
+  worker->postTask(makeTask([ref = typename State::Ref(state)](const CancelToken&) { ref->run(); },
+                            "future_task", std::move(token)));
+  return future;
+ }
+
+ /** @brief submitToWithFuture() by worker id, resolves the handle first. */
+ template<typename F, typename... Args>
  auto submitToWithFuture(const std::string& wid, F&& f, Args&&... args)
- ->std::future<std::invoke_result_t<F,Args...>>;
+  -> Future<std::invoke_result_t<std::decay_t<F>&, std::decay_t<Args>...>>
+ {
+  return submitToWithFuture(handleOf(wid), std::forward<F>(f), std::forward<Args>(args)...);
+ }
 
  /**
   * @brief Get all active worker's id.
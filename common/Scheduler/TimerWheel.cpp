@@ -0,0 +1,284 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+TimerWheel::TimerWheel(uint64_t tickNs, uint64_t nowNs)
+    : mTickNs(std::max<uint64_t>(tickNs, 1)), mTick(nowNs / mTickNs)
+{
+    std::fill(std::begin(mHeads), std::end(mHeads), NIL);
+}
+
+void TimerWheel::link(uint32_t index)
+{
+    Node& n = mNodes[index];
+    const uint64_t delta = n.due - mTick;
+
+    unsigned level = 0;
+    while(level < LEVELS - 1 && delta >= (1ULL << (SLOT_BITS * (level + 1))))
+    {
+        ++level;
+    }
+    // Beyond the top wheel: park in its last slot, re-placed when it is cascaded
+    const uint64_t due = delta >= (1ULL << (SLOT_BITS * LEVELS)) ? mTick + (MASK << (SLOT_BITS * (LEVELS - 1))) : n.due;
+    const uint32_t idx = static_cast<uint32_t>(due >> (SLOT_BITS * level)) & MASK;
+    const uint32_t slot = level * SLOTS + idx;
+
+    n.slot = static_cast<uint16_t>(slot);
+    n.prev = NIL;
+    n.next = mHeads[slot];
+    if(n.next != NIL)
+    {
+        mNodes[n.next].prev = index;
+    }
+    mHeads[slot] = index;
+    mOccupied[level][idx / 64] |= 1ULL << (idx % 64);
+}
+
+void TimerWheel::unlink(uint32_t index) noexcept
+{
+    Node& n = mNodes[index];
+    if(n.prev != NIL)
+    {
+        mNodes[n.prev].next = n.next;
+    }
+    else
+    {
+        mHeads[n.slot] = n.next;
+    }
+    if(n.next != NIL)
+    {
+        mNodes[n.next].prev = n.prev;
+    }
+    if(mHeads[n.slot] == NIL)
+    {
+        const uint32_t idx = n.slot & MASK;
+        mOccupied[n.slot / SLOTS][idx / 64] &= ~(1ULL << (idx % 64));
+    }
+    n.prev = n.next = NIL;
+}
+
+void TimerWheel::release(uint32_t index) noexcept
+{
+    Node& n = mNodes[index];
+    n.fn = TimerFn();
+    n.state = State::FREE;
+    if(++n.generation == 0)
+    {
+        n.generation = 1;
+    }
+    mFree.push_back(index);
+    --mCount;
+}
+
+TimerId TimerWheel::arm(uint64_t dueTick, uint64_t period, TimerFn&& fn)
+{
+    uint32_t index;
+    if(!mFree.empty())
+    {
+        index = mFree.back();
+        mFree.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(mNodes.size());
+        mNodes.emplace_back();
+    }
+    Node& n = mNodes[index];
+    n.due = std::max(dueTick, mTick + 1);  // The current tick is already processed
+    n.period = period;
+    n.state = State::ARMED;
+    n.cancelled = false;
+    n.fn = std::move(fn);
+    link(index);
+    ++mCount;
+    return (static_cast<uint64_t>(n.generation) << 32) | index;
+}
+
+TimerId TimerWheel::schedule(uint64_t deadlineNs, TimerFn fn)
+{
+    const uint64_t dueTick = deadlineNs / mTickNs + (deadlineNs % mTickNs != 0);
+    return arm(dueTick, 0, std::move(fn));
+}
+
+TimerId TimerWheel::scheduleEvery(uint64_t firstNs, uint64_t periodNs, TimerFn fn)
+{
+    const uint64_t dueTick = firstNs / mTickNs + (firstNs % mTickNs != 0);
+    const uint64_t period = std::max<uint64_t>(periodNs / mTickNs, 1);
+    return arm(dueTick, period, std::move(fn));
+}
+
+bool TimerWheel::cancel(TimerId id) noexcept
+{
+    const uint32_t index = static_cast<uint32_t>(id);
+    if(index >= mNodes.size())
+    {
+        return false;
+    }
+    Node& n = mNodes[index];
+    if(n.generation != static_cast<uint32_t>(id >> 32))
+    {
+        return false;
+    }
+    switch(n.state)
+    {
+        case State::ARMED:
+            unlink(index);
+            release(index);
+            return true;
+        case State::FIRING:
+            // From its own callback: released once the callback returns
+            if(n.period != 0 && !n.cancelled)
+            {
+                n.cancelled = true;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+void TimerWheel::cascade(unsigned level)
+{
+    const uint32_t slot = level * SLOTS + (static_cast<uint32_t>(mTick >> (SLOT_BITS * level)) & MASK);
+    uint32_t index = mHeads[slot];
+    mHeads[slot] = NIL;
+    const uint32_t idx = slot & MASK;
+    mOccupied[level][idx / 64] &= ~(1ULL << (idx % 64));
+
+    while(index != NIL)
+    {
+        const uint32_t next = mNodes[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+size_t TimerWheel::expire(uint32_t idx)
+{
+    size_t fired = 0;
+    uint32_t index;
+    while((index = mHeads[idx]) != NIL)
+    {
+        // Nodes have stable addresses: the callback may schedule (grow mNodes) safely
+        Node& n = mNodes[index];
+        unlink(index);
+        n.state = State::FIRING;
+        try
+        {
+            n.fn();
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr<<"[TimerWheel]: timer callback failed: "<<e.what()<<std::endl;
+        }
+        ++fired;
+
+        if(n.period != 0 && !n.cancelled)
+        {
+            n.due = std::max(n.due + n.period, mTick + 1);
+            n.state = State::ARMED;
+            link(index);
+        }
+        else
+        {
+            release(index);
+        }
+    }
+    return fired;
+}
+
+uint32_t TimerWheel::nextOccupied(uint32_t from) const noexcept
+{
+    for(uint32_t word = from / 64; word < SLOTS / 64; ++word)
+    {
+        uint64_t bits = mOccupied[0][word];
+        if(word == from / 64)
+        {
+            bits &= ~0ULL << (from % 64);
+        }
+        if(bits)
+        {
+            return word * 64 + static_cast<uint32_t>(__builtin_ctzll(bits));
+        }
+    }
+    return SLOTS;
+}
+
+size_t TimerWheel::advance(uint64_t nowNs)
+{
+    const uint64_t target = nowNs / mTickNs;
+    size_t fired = 0;
+    while(mTick < target)
+    {
+        if(mCount == 0)
+        {
+            mTick = target;
+            break;
+        }
+
+        // Next tick worth a visit: the next occupied level 0 slot, else the next cascade
+        const uint64_t windowEnd = (mTick | MASK) + 1;
+        uint64_t next = windowEnd;
+        if(mTick + 1 < windowEnd)
+        {
+            const uint32_t slot = nextOccupied(static_cast<uint32_t>(mTick + 1) & MASK);
+            if(slot < SLOTS)
+            {
+                next = (mTick & ~static_cast<uint64_t>(MASK)) + slot;
+            }
+        }
+        mTick = std::min(next, target);
+
+        if((mTick & MASK) == 0)
+        {
+            for(unsigned level = LEVELS - 1; level > 0; --level)
+            {
+                if((mTick & ((1ULL << (SLOT_BITS * level)) - 1)) == 0)
+                {
+                    cascade(level);
+                }
+            }
+        }
+        fired += expire(static_cast<uint32_t>(mTick) & MASK);
+    }
+    return fired;
+}
+
+uint64_t TimerWheel::nextDeadline() const noexcept
+{
+    if(mCount == 0)
+    {
+        return UINT64_MAX;
+    }
+    const uint64_t base = mTick & ~static_cast<uint64_t>(MASK);
+    const uint32_t cur = static_cast<uint32_t>(mTick) & MASK;
+    const uint64_t windowEnd = base + SLOTS;
+
+    uint64_t tick = UINT64_MAX;
+    uint32_t slot = cur + 1 < SLOTS ? nextOccupied(cur + 1) : SLOTS;
+    if(slot < SLOTS)
+    {
+        tick = base + slot;
+    }
+    else if((slot = nextOccupied(0)) <= cur)
+    {
+        tick = windowEnd + slot;  // Due in the next round of the level 0 wheel
+    }
+
+    bool upper = false;
+    for(unsigned level = 1; level < LEVELS && !upper; ++level)
+    {
+        for(uint64_t bits : mOccupied[level])
+        {
+            upper = upper || bits != 0;
+        }
+    }
+    if(upper)
+    {
+        tick = std::min(tick, windowEnd);
+    }
+    return tick == UINT64_MAX ? UINT64_MAX : tick * mTickNs;
+}
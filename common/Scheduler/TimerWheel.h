@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Worker/InplaceFunction.h"
+
+/** @brief Callback of a timer, stored inline (no allocation per timer). */
+using TimerFn = InplaceFunction<void(), 48>;
+
+/** @brief Handle of a timer: slot index and generation, 0 is never a valid timer. */
+using TimerId = uint64_t;
+
+/**
+ * @class TimerWheel
+ * @brief Hierarchical timing wheel (Varghese & Lauck): O(1) schedule and cancel, for
+ * large numbers of timers which are mostly cancelled before they fire (heartbeats,
+ * logon timeouts, order expiry, periodic flushes).
+ *
+ * @details
+ * Time is counted in ticks of `tickNs`. LEVELS wheels of SLOTS slots each cover
+ * SLOTS^(level+1) ticks; a timer goes to the lowest wheel whose range holds its due
+ * tick, in an intrusive list. Whenever the level 0 wheel wraps, the next slot of the
+ * level above is cascaded: its timers are re-inserted into the lower wheels. A timer
+ * fires at the first advance() at or after its deadline, rounded up to a tick.
+ * Occupancy bitmaps let advance() skip empty slots, so a long idle gap costs one step
+ * per occupied slot or cascade rather than one per tick.
+ *
+ * Timer nodes live in a std::deque (stable addresses) and are recycled through a free
+ * list; a stale TimerId is detected by its generation.
+ *
+ * @note Not thread-safe: one owner thread (a Worker, a reactor loop) schedules, cancels
+ * and advances. Callbacks run inside advance() and may schedule and cancel timers,
+ * including their own.
+ */
+class TimerWheel
+{
+public:
+ static constexpr unsigned LEVELS = 4;
+ static constexpr unsigned SLOT_BITS = 8;
+ static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+
+private:
+ static constexpr uint32_t MASK = SLOTS - 1;
+ static constexpr uint32_t NIL = UINT32_MAX;
+
+ enum class State : uint8_t { FREE, ARMED, FIRING };
+
+ struct Node
+ {
+  uint64_t due{0};       ///> Tick
+  uint64_t period{0};    ///> Ticks, 0 for a one-shot timer
+  uint32_t prev{NIL};
+  uint32_t next{NIL};
+  uint32_t generation{1};
+  uint16_t slot{0};      ///> level * SLOTS + index, while armed
+  State state{State::FREE};
+  bool cancelled{false}; ///> Cancelled by its own callback
+  TimerFn fn;
+ };
+
+ uint64_t mTickNs;
+ uint64_t mTick;                         ///> Last tick processed
+ std::deque<Node> mNodes;
+ std::vector<uint32_t> mFree;
+ uint32_t mHeads[LEVELS * SLOTS];
+ uint64_t mOccupied[LEVELS][SLOTS / 64]{}; ///> Non-empty slots
+ size_t mCount{0};                       ///> Armed timers
+
+ void link(uint32_t index);
+ void unlink(uint32_t index) noexcept;
+ void release(uint32_t index) noexcept;
+ TimerId arm(uint64_t dueTick, uint64_t period, TimerFn&& fn);
+ void cascade(unsigned level);
+ size_t expire(uint32_t idx);
+
+ /** @brief First occupied level 0 slot in [from, SLOTS), SLOTS if none. */
+ uint32_t nextOccupied(uint32_t from) const noexcept;
+
+public:
+ /**
+  * @brief Constructor
+  * @param tickNs Resolution of the wheel, nanoseconds
+  * @param nowNs Current time (TscClock nanoseconds)
+  */
+ explicit TimerWheel(uint64_t tickNs, uint64_t nowNs);
+
+ TimerWheel(const TimerWheel&) = delete;
+ TimerWheel& operator=(const TimerWheel&) = delete;
+
+ /** @brief Calls `fn` once, at the first advance() at or after `deadlineNs`. */
+ TimerId schedule(uint64_t deadlineNs, TimerFn fn);
+
+ /**
+  * @brief Calls `fn` every `periodNs` (at least one tick), first at `firstNs`. Late
+  * calls are not replayed: a timer delayed by several periods fires once.
+  */
+ TimerId scheduleEvery(uint64_t firstNs, uint64_t periodNs, TimerFn fn);
+
+ /**
+  * @brief Cancels a timer, the callback is released at once.
+  * @return false if the timer already fired (one-shot) or was cancelled.
+  */
+ bool cancel(TimerId id) noexcept;
+
+ /**
+  * @brief Fires every timer due at `nowNs`.
+  * @return Number of callbacks called
+  */
+ size_t advance(uint64_t nowNs);
+
+ /**
+  * @brief Lower bound of the next deadline, UINT64_MAX without timers. Exact for timers
+  * due within SLOTS ticks; otherwise the next cascade, after which it is asked again.
+  */
+ uint64_t nextDeadline() const noexcept;
+
+ size_t size() const noexcept { return mCount; }
+ bool empty() const noexcept { return mCount == 0; }
+ uint64_t tickNs() const noexcept { return mTickNs; }
+};
+
+#endif //TIMER_WHEEL_H
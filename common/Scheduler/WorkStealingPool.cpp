@@ -0,0 +1,251 @@
+#include "WorkStealingPool.h"
+
+#include <functional>
+#include <iostream>
+#include <sched.h>
+
+namespace {
+    constexpr int IDLE_SPINS = 64; // Empty searches before sleeping
+
+    // xorshift64, per thread, for victim selection
+    uint64_t nextRandom()
+    {
+        static thread_local uint64_t x = 0x9E3779B97F4A7C15ULL ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    }
+}
+
+WorkStealingPool::WorkStealingPool(size_t threads, WorkerSpec spec) : mSpec(std::move(spec))
+{
+    if(mSpec.name.empty())
+    {
+        mSpec.name = "pool";
+    }
+    threads = std::max<size_t>(threads, 1);
+    for(size_t i = 0; i < threads; ++i)
+    {
+        mThreads.push_back(std::make_unique<PoolThread>());
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    shutdown();
+    // Tasks left queued (pool never started, or submitted while stopping) run here, on the
+    // destroying thread, so none leaks and every future completes
+    while(runOne())
+    {
+    }
+}
+
+void WorkStealingPool::start()
+{
+    if(mStarted)
+    {
+        return;
+    }
+    mStarted = true;
+    for(size_t i = 0; i < mThreads.size(); ++i)
+    {
+        PoolThread* self = mThreads[i].get();
+        const WorkerSpec spec = mSpec.forIndex(i, mThreads.size());
+        self->thread = std::thread([this, self, spec]
+        {
+            spec.apply();
+            loop(self);
+        });
+    }
+}
+
+void WorkStealingPool::shutdown()
+{
+    mStop.store(true, std::memory_order_release);
+    mEpoch.fetch_add(1, std::memory_order_release);
+    mEpoch.notify_all();
+    for(auto& t : mThreads)
+    {
+        if(t->thread.joinable())
+        {
+            t->thread.join();
+        }
+    }
+}
+
+uint64_t WorkStealingPool::submit(TaskFn fn, const char* desc, CancelToken token)
+{
+    Task* t = new Task();
+    t->id = nextTaskId();
+    t->func = std::move(fn);
+    t->token = std::move(token);
+    t->desc = desc;
+    const uint64_t id = t->id;
+
+    if(tPool == this)
+    {
+        tSelf->deque.push(t);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(mInjectedMutex);
+        mInjected.push_back(t);
+        mInjectedCount.fetch_add(1, std::memory_order_release);
+    }
+    wakeOne();
+    return id;
+}
+
+bool WorkStealingPool::runOne()
+{
+    Task* t = findTask(tPool == this ? tSelf : nullptr);
+    if(!t)
+    {
+        return false;
+    }
+    runTask(t);
+    return true;
+}
+
+Task* WorkStealingPool::findTask(PoolThread* self)
+{
+    if(self)
+    {
+        if(auto t = self->deque.pop())
+        {
+            return *t;
+        }
+    }
+
+    if(mInjectedCount.load(std::memory_order_acquire) > 0)
+    {
+        std::lock_guard<std::mutex> lock(mInjectedMutex);
+        if(!mInjected.empty())
+        {
+            Task* t = mInjected.front();
+            mInjected.pop_front();
+            mInjectedCount.fetch_sub(1, std::memory_order_relaxed);
+            return t;
+        }
+    }
+
+    // Steal, starting from a random victim
+    const size_t n = mThreads.size();
+    const uint64_t x = nextRandom();
+    for(size_t i = 0; i < n; ++i)
+    {
+        PoolThread* victim = mThreads[(x + i) % n].get();
+        if(victim == self)
+        {
+            continue;
+        }
+        if(auto t = victim->deque.steal())
+        {
+            return *t;
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingPool::runTask(Task* t) noexcept
+{
+    try
+    {
+        if(!t->token.isCancelled())
+        {
+            (*t)();
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr<<"[WorkStealingPool]: task "<<t->id<<" ("<<t->desc<<") failed: "<<e.what()<<std::endl;
+    }
+    delete t;
+}
+
+void WorkStealingPool::wakeOne() noexcept
+{
+    // Pairs with the fence in loop(): either a sleeper is seen or it sees the task
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(mSleepers.load(std::memory_order_relaxed) > 0)
+    {
+        mEpoch.fetch_add(1, std::memory_order_release);
+        mEpoch.notify_one();
+    }
+}
+
+void WorkStealingPool::loop(PoolThread* self)
+{
+    tPool = this;
+    tSelf = self;
+    int idle = 0;
+    while(true)
+    {
+        if(Task* t = findTask(self))
+        {
+            runTask(t);
+            idle = 0;
+            continue;
+        }
+        if(mStop.load(std::memory_order_acquire))
+        {
+            // Tasks left in other deques are run by their owners
+            break;
+        }
+        if(++idle < IDLE_SPINS)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint32_t epoch = mEpoch.load(std::memory_order_acquire);
+        mSleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(Task* t = findTask(self))
+        {
+            mSleepers.fetch_sub(1, std::memory_order_relaxed);
+            runTask(t);
+            idle = 0;
+            continue;
+        }
+        if(!mStop.load(std::memory_order_acquire))
+        {
+            mEpoch.wait(epoch, std::memory_order_acquire);
+        }
+        mSleepers.fetch_sub(1, std::memory_order_relaxed);
+        idle = 0;
+    }
+    tPool = nullptr;
+    tSelf = nullptr;
+}
+
+std::vector<int> WorkStealingPool::spareCpus(const std::vector<int>& reserved)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) != 0)
+    {
+        return {};
+    }
+    std::vector<int> all;
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if(CPU_ISSET(cpu, &set))
+        {
+            all.push_back(cpu);
+        }
+    }
+
+    const std::vector<int> isolated = WorkerSpec::isolatedCpus();
+    std::vector<int> spare;
+    for(int cpu : all)
+    {
+        if(std::find(reserved.begin(), reserved.end(), cpu) == reserved.end()
+            && !std::binary_search(isolated.begin(), isolated.end(), cpu))
+        {
+            spare.push_back(cpu);
+        }
+    }
+    return spare.empty() ? all : spare;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Worker/Task.h"
+#include "Worker/WorkerSpec.h"
+#include "Lockfree/ChaseLevDeque.h"
+
+/**
+ * @class WorkStealingPool
+ * @brief Pool of interchangeable threads for background work (snapshots, compaction,
+ * reports) which may go to whichever thread is free, unlike the named Scheduler workers.
+ *
+ * @details
+ * Each pool thread owns a Chase-Lev deque. A task submitted from a pool thread (a task
+ * spawning sub-tasks, parallelFor) is pushed on that thread's deque; a task submitted
+ * from outside goes to a shared injection queue. An idle thread pops its own deque,
+ * then the injection queue, then steals the oldest task of randomly chosen victims, so
+ * a burst submitted to one thread spreads over the whole pool.
+ * Threads with nothing to do spin for a few rounds then sleep on an event count; a
+ * submitter only issues a wake-up when some thread sleeps.
+ *
+ * By default the pool runs on the spare CPUs: the CPUs of the process minus those of
+ * pinned workers and isolated CPUs, at normal priority, so it never competes with the
+ * hot threads (see spareCpus()).
+ */
+class WorkStealingPool
+{
+ struct PoolThread
+ {
+  Exchange::Core::ChaseLevDeque<Task*> deque;
+  std::thread thread;
+ };
+
+ std::vector<std::unique_ptr<PoolThread>> mThreads;
+ WorkerSpec mSpec;
+
+ std::mutex mInjectedMutex;
+ std::deque<Task*> mInjected;             ///> Tasks submitted from outside the pool
+ std::atomic<size_t> mInjectedCount{0};   ///> Lets idle threads skip the mutex
+
+ std::atomic<uint32_t> mEpoch{0};         ///> Bumped to wake sleeping threads
+ std::atomic<uint32_t> mSleepers{0};
+ std::atomic<bool> mStop{false};
+ bool mStarted{false};
+
+ static inline thread_local WorkStealingPool* tPool = nullptr;
+ static inline thread_local PoolThread* tSelf = nullptr;
+
+ Task* findTask(PoolThread* self);
+ void runTask(Task* t) noexcept;
+ void wakeOne() noexcept;
+ void loop(PoolThread* self);
+
+ struct ForState
+ {
+  std::atomic<size_t> remaining;
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+ };
+
+ template<typename F>
+ static void runChunk(ForState& state, F& body, size_t lo, size_t hi) noexcept
+ {
+  try
+  {
+   for(size_t i = lo; i < hi; ++i)
+   {
+    body(i);
+   }
+  }
+  catch(...)
+  {
+   if(!state.failed.exchange(true, std::memory_order_acq_rel))
+   {
+    state.error = std::current_exception();
+   }
+  }
+  state.remaining.fetch_sub(1, std::memory_order_acq_rel);
+ }
+
+public:
+ /**
+  * @brief Constructor, the threads are started by start().
+  * @param threads Number of pool threads (at least 1).
+  * @param spec Placement of the pool threads, named "<spec.name>-<i>".
+  */
+ WorkStealingPool(size_t threads, WorkerSpec spec);
+
+ WorkStealingPool(const WorkStealingPool&) = delete;
+ WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+ /** @brief Runs the tasks still queued, then joins the threads. */
+ ~WorkStealingPool();
+
+ void start();
+
+ /** @brief Lets the threads finish every queued task, then joins them. */
+ void shutdown();
+
+ size_t size() const noexcept { return mThreads.size(); }
+
+ /**
+  * @brief Submits a task to whichever pool thread gets to it first.
+  * @return Task Id
+  */
+ uint64_t submit(TaskFn fn, const char* desc = "", CancelToken token = {});
+
+ /**
+  * @brief Runs one queued task on the calling thread, if there is one.
+  * @return false if no task could be found.
+  */
+ bool runOne();
+
+ /**
+  * @brief Calls body(i) for every i in [begin, end), split in chunks of `grain`
+  * indices spread over the pool. The calling thread runs chunks too and returns once
+  * all of them are done; the first exception thrown by body is rethrown.
+  * @details While waiting the caller helps by running queued tasks, which may belong to
+  * other submitters. Works before start() as well: the caller then runs every chunk.
+  */
+ template<typename F>
+ void parallelFor(size_t begin, size_t end, size_t grain, F&& body)
+ {
+  if(begin >= end)
+  {
+   return;
+  }
+  grain = std::max<size_t>(grain, 1);
+  const size_t chunks = (end - begin + grain - 1) / grain;
+  ForState state;
+  state.remaining.store(chunks, std::memory_order_relaxed);
+  auto* fn = &body;
+
+  for(size_t c = 1; c < chunks; ++c)
+  {
+   const size_t lo = begin + c * grain;
+   const size_t hi = std::min(end, lo + grain);
+   submit([&state, fn, lo, hi](const CancelToken&) { runChunk(state, *fn, lo, hi); }, "parallelFor");
+  }
+  runChunk(state, body, begin, std::min(end, begin + grain));
+
+  while(state.remaining.load(std::memory_order_acquire) != 0)
+  {
+   if(!runOne())
+   {
+    std::this_thread::yield();
+   }
+  }
+  if(state.error)
+  {
+   std::rethrow_exception(state.error);
+  }
+ }
+
+ /**
+  * @brief CPUs the process may run on, minus `reserved` (pinned workers) and the
+  * isolated CPUs. If nothing is left, every CPU of the process.
+  */
+ static std::vector<int> spareCpus(const std::vector<int>& reserved);
+};
+
+#endif //WORK_STEALING_POOL_H
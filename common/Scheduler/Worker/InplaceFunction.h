@@ -0,0 +1,110 @@
+#pragma once
+
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, size_t Capacity>
+class InplaceFunction;
+
+/**
+ * @class InplaceFunction
+ * @brief Move-only std::function replacement which stores the callable inline, in
+ * `Capacity` bytes, and never allocates.
+ *
+ * @details
+ * A callable which does not fit (or is over-aligned, or may throw when moved) is
+ * rejected at compile time rather than silently moved to the heap: capture less, or
+ * capture a pointer to the state. The type-erased operations live in one static table
+ * per callable type, so the object is the storage plus one pointer.
+ * As with std::function, operator() is const but invokes the callable as non-const,
+ * which lets mutable lambdas be used.
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+    struct VTable {
+        R (*invoke)(void* target, Args&&... args);
+        void (*move)(void* dst, void* src) noexcept;    ///> Move-constructs dst from src, then destroys src
+        void (*destroy)(void* target) noexcept;
+    };
+
+    template <typename F>
+    static constexpr VTable sVTable{
+        [](void* target, Args&&... args) -> R {
+            return (*static_cast<F*>(target))(std::forward<Args>(args)...);
+        },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* target) noexcept {
+            static_cast<F*>(target)->~F();
+        }
+    };
+
+    alignas(std::max_align_t) mutable unsigned char mStorage[Capacity];
+    const VTable* mVTable{nullptr};
+
+    void reset() noexcept {
+        if (mVTable) {
+            mVTable->destroy(mStorage);
+            mVTable = nullptr;
+        }
+    }
+
+public:
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template <typename F, typename D = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<D, InplaceFunction> && std::is_invocable_r_v<R, D&, Args...>>>
+    InplaceFunction(F&& f) {
+        static_assert(sizeof(D) <= Capacity, "Callable too large for InplaceFunction: capture less or raise Capacity");
+        static_assert(alignof(D) <= alignof(std::max_align_t), "Over-aligned callable");
+        static_assert(std::is_nothrow_move_constructible_v<D>, "Callable must be nothrow move constructible");
+        ::new (static_cast<void*>(mStorage)) D(std::forward<F>(f));
+        mVTable = &sVTable<D>;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept : mVTable(other.mVTable) {
+        if (mVTable) {
+            mVTable->move(mStorage, other.mStorage);
+            other.mVTable = nullptr;
+        }
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.mVTable) {
+                other.mVTable->move(mStorage, other.mStorage);
+                mVTable = other.mVTable;
+                other.mVTable = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { reset(); }
+
+    explicit operator bool() const noexcept { return mVTable != nullptr; }
+
+    /** @brief Calls the target; undefined if empty. */
+    R operator()(Args... args) const {
+        return mVTable->invoke(mStorage, std::forward<Args>(args)...);
+    }
+};
+
+#endif //INPLACE_FUNCTION_H
@@ -7,25 +7,41 @@
 
 #ifndef TASK_H
 #define TASK_H
+#include <atomic>
 #include <cstdint>
-#include <functional>
 #include <memory>
 
+#include "InplaceFunction.h"
+
 // <================================ Cancel Token ================================>
 
+/**
+ * @struct CancelToken
+ * @brief Shared cancellation flag of a task. The default token is empty: it is never
+ * cancelled and costs nothing. Call create() for a task which may be cancelled; the
+ * flag is then shared by every copy of the token.
+ */
 struct CancelToken
 {
-    std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<std::atomic<bool>> cancelled;
+
+    /** @brief A token which can be cancelled (allocates its flag). */
+    static CancelToken create()
+    {
+        return CancelToken{std::make_shared<std::atomic<bool>>(false)};
+    }
+
     bool isCancelled() const noexcept
     {
         return cancelled && cancelled->load(std::memory_order_acquire);
     }
 
+    /** @brief Cancels the task if it has not started; no effect on an empty token. */
     void cancel() const noexcept
     {
         if(cancelled)
         {
-            cancelled->store(true,std::memory_order_relaxed);
+            cancelled->store(true,std::memory_order_release);
         }
     }
 };
@@ -33,20 +49,23 @@ struct CancelToken
 
 // <================================ Task ================================>
 
+/// Inline capacity of a task callable: with the dispatch pointer, one cache line.
+static constexpr size_t TASK_INLINE_SIZE = 56;
 
-using TaskFn = std::function<void(const CancelToken&)>;
+using TaskFn = InplaceFunction<void(const CancelToken&), TASK_INLINE_SIZE>;
 
 /**
  * @struct Task
  * @brief Task is a wrapper of all callable (function, lambda, functor). It is a functor
- * itself.
+ * itself. It is move-only and does not allocate: the callable is stored inline, the
+ * description is a string literal and the cancel token is empty unless asked for.
  */
 struct Task
 {
-    uint64_t id; // unique identification
+    uint64_t id{0}; // unique identification
     TaskFn func;
     CancelToken token;
-    std::string desc;
+    const char* desc{""}; // Static description, for diagnostics
 
     void operator()() const
     {
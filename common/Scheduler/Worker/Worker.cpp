@@ -3,8 +3,22 @@
 //
 
 #include "Worker.h"
+#include "Clock/TscClock.h"
 #include <iostream>
-Worker::Worker(const std::string& id):mId(std::move(id)), mStop(false){}
+
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+    constexpr int IDLE_SPINS = 64; // Empty polls before parking
+}
+
+Worker::Worker(const std::string& id, WorkerSpec spec, size_t capacity)
+    : mId(id), mSpec(std::move(spec)), mQueue(capacity),
+      mTimers(TIMER_TICK_NS, Exchange::Core::TscClock::now()) {}
 
 void Worker::start()
 {
@@ -17,49 +31,57 @@ void Worker::start()
     }
     mThread = std::thread([this]
     {
+        mSpec.apply(mId);
         run();
     });
 }
 
 
-void Worker::shutdown()
-{
-    if(mStop)
-    {
-        return;
-    }
-    mStop = true;
-}
-
 void Worker::run()
 {
+    tCurrent = this;
+    Task t;
+    int idle = 0;
     while(true)
     {
-        Task t;
+        if(!mTimers.empty())
         {
-            std::unique_lock<std::mutex> lock(mQueueMutex);
-
-            // Lock is released until there is task in queue to be processed and thread goes to waiting state
-            // until either queue has a task or stop signal is received.
-            mCv.wait(lock, [this]
-            {
-                return mStop || !mQueue.empty(); // Any one being true means gaining lock again and going forward.
-            });
-
-            // If stop signal is received and there is something to read exit the loop
-            if(mQueue.empty() && mStop)
+            mTimers.advance(Exchange::Core::TscClock::now());
+        }
+        if(!mQueue.tryPop(t))
+        {
+            if(mStop.load(std::memory_order_acquire) && mQueue.empty())
             {
+                tCurrent = nullptr;
                 return;
             }
+            if(++idle < IDLE_SPINS)
+            {
+                std::this_thread::yield();
+                continue;
+            }
 
-            // Checking if queue is empty
-            if(mQueue.empty()) continue;
-
-            // Adding task in queue
-            t = std::move(mQueue.front());
-            mQueue.pop();
-            mRunningTasks.insert(t.id);
+            // Park: announce it, then look again so a task posted meanwhile is not missed
+            mSleeping.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(mQueue.empty() && !mStop.load(std::memory_order_relaxed))
+            {
+                uint64_t timeout = 0;
+                if(!mTimers.empty())
+                {
+                    const uint64_t now = Exchange::Core::TscClock::now();
+                    const uint64_t deadline = mTimers.nextDeadline();
+                    timeout = deadline > now ? deadline - now : 1;
+                }
+                park(timeout);
+            }
+            mSleeping.store(0, std::memory_order_relaxed);
+            idle = 0;
+            continue;
         }
+        idle = 0;
+
+        mCurrentTask.store(t.id, std::memory_order_relaxed);
         try
         {
             if(!t.token.isCancelled())
@@ -73,29 +95,69 @@ void Worker::run()
         }
         catch(const std::exception& e)
         {
-            std::cerr<<"[Worker]: "<<mId<<" "<<std::endl;
+            std::cerr<<"[Worker]: "<<mId<<" task "<<t.id<<" ("<<t.desc<<") failed: "<<e.what()<<std::endl;
         }
+        // Release the callable's captures now rather than when the slot is reused
+        t = Task();
+        mCurrentTask.store(0, std::memory_order_relaxed);
+        mCompleted.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
 
-void Worker::postTask(const Task& t)
+void Worker::postTask(Task&& t)
 {
+    while(!mQueue.tryPush(std::move(t)))
     {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        mQueue.push((t));
-        mPendingTasks.insert((t.id));
+        wake();
+        std::this_thread::yield();
     }
-    mCv.notify_one();
+    wake();
 }
 
 void Worker::postStop()
 {
+    mStop.store(true, std::memory_order_release);
+    wake();
+}
+
+void Worker::wake() noexcept
+{
+    // Pairs with the fence in run(): either we see mSleeping or the worker sees the task
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(mSleeping.load(std::memory_order_relaxed) && mSleeping.exchange(0, std::memory_order_release))
     {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        mStop = true;
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mSleeping), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
     }
-    mCv.notify_one();
+}
+
+void Worker::park(uint64_t timeoutNs) noexcept
+{
+    // Raw futex rather than atomic::wait, which has no timeout
+    timespec ts{static_cast<time_t>(timeoutNs / 1'000'000'000), static_cast<long>(timeoutNs % 1'000'000'000)};
+    while(mSleeping.load(std::memory_order_acquire) == 1)
+    {
+        const long rc = syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mSleeping), FUTEX_WAIT_PRIVATE, 1,
+                                timeoutNs ? &ts : nullptr, nullptr, 0);
+        if(rc != 0 && errno == ETIMEDOUT)
+        {
+            return;
+        }
+    }
+}
+
+void Worker::resume(std::coroutine_handle<> h)
+{
+    Task t;
+    t.id = nextTaskId();
+    t.func = [h](const CancelToken&) { h.resume(); };
+    t.desc = "coroutine";
+    postTask(std::move(t));
+}
+
+void Worker::resumeAt(uint64_t deadlineNs, std::coroutine_handle<> h)
+{
+    mTimers.schedule(deadlineNs, [h] { h.resume(); });
 }
 
 void Worker::join() noexcept
@@ -113,4 +175,4 @@ void Worker::join() noexcept
     {
         local.join();
     }
-}
\ No newline at end of file
+}
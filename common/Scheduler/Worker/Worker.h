@@ -7,12 +7,15 @@
 #ifndef WORKER_H
 #define WORKER_H
 
-#include<queue>
+#include <atomic>
+#include <coroutine>
+#include <mutex>
 #include <thread>
-#include <unordered_set>
 
 #include "Task.h"
-#include "../Scheduler.h"
+#include "WorkerSpec.h"
+#include "Lockfree/MpscRing.h"
+#include "../TimerWheel.h"
 
 struct Task;
 
@@ -22,62 +25,75 @@ struct Task;
  * of thread.
  *
  * Each worker has its own task queue and continuously processes tasks until explicitly
- * stopped. SSynchronization is managed via mutex and conditional variables.
+ * stopped. Tasks are handed over through a bounded lock-free MPSC ring, so posting from
+ * any thread is a CAS and a move, and the worker pops without any lock.
  *
  * @details
  * `threadMutex` protects ownership changes of the std::thread object (start/join/move/destruction).
  * Without this, there can be data races — e.g., one thread calling start() while another calls join().
+ *
+ * An idle worker spins briefly, then parks on `mSleeping` (futex wait). A producer only
+ * issues a wake-up when the worker is parked: the common case, a busy worker, costs the
+ * producer a fence and one load.
+ *
+ * Each worker owns a TimerWheel (timers()), advanced by its loop and touched only by the
+ * worker thread: timed work (heartbeats, timeouts, sleeping coroutines, see Coroutine.h)
+ * runs on the worker which armed it. With timers armed the worker parks no longer than
+ * the next deadline.
  */
 struct Worker {
  using Id = std::string;
- using TokenMap = std::unordered_map<uint64_t, std::shared_ptr<std::atomic<bool>>>;
- using UnorderedTaskIdSet = std::unordered_set<uint64_t>;
+ static constexpr size_t QUEUE_CAPACITY = 1024; ///> Default ring capacity (tasks)
+ static constexpr uint64_t TIMER_TICK_NS = 100'000; ///> Resolution of the worker's timers
+
     std::string mId;
-    std::queue<Task> mQueue;
-    std::mutex mQueueMutex;
+    WorkerSpec mSpec; /// > Placement applied by the thread before its first task.
+    Exchange::Core::MpscRing<Task> mQueue; /// > Tasks posted and not started yet.
     std::mutex mThreadMutex;
-    std::condition_variable mCv;
     std::thread mThread;
-    TokenMap mTokenMap; /// > Tasks which are cancelable, thought a cancel token.
- UnorderedTaskIdSet mPendingTasks; /// > Tasks that are pending (queued but not started).
- UnorderedTaskIdSet mRunningTasks; /// > Tasks that are currently running.
 
+    alignas(Exchange::Ipc::CACHE_LINE_SIZE) std::atomic<uint32_t> mSleeping{0}; /// > 1 while parked in run()
+    std::atomic<bool> mStop{false};
+    std::atomic<uint64_t> mCurrentTask{0}; /// > Id of the task being run, 0 when idle.
+    std::atomic<uint64_t> mCompleted{0};   /// > Tasks run or skipped (cancelled) so far.
+    TimerWheel mTimers; /// > Worker thread only.
 
-    bool mStop;
     /** @brief Constructor */
-    explicit  Worker(const std::string& id);
+    explicit  Worker(const std::string& id, WorkerSpec spec = {}, size_t capacity = QUEUE_CAPACITY);
 
     /**
      * @brief  Responsible for creating and launching work's dedicated thread
      *
      * @details
      * Has a dedicated thread-mutex as multiple threads in the system could
-     * potentially call start()/shutdown() on the same worker concurrently.
+     * potentially call start() on the same worker concurrently. Stopped by postStop().
+     * The thread applies mSpec (affinity, priority, name) before entering run().
      */
     void start();
-    void shutdown();
 
     /**
      * @brief Worker's main loop.
      *
-     * Continuously waits for a task to be enqueued and executes them one by one. The loop exists when
+     * Continuously pops tasks and executes them one by one. The loop exits when
      * `mStop` is set and all pending tasks are processed.
      * @details
-     * Conditional variable is used so thread avoids busy-waiting. Thread sleep until there is task
-     * available to be executed.
-     * Scheduler APIs like postTask(), tryRemoveOrCancel() etc. writes into the worker's queue while run()
-     * reads from it. So queue is used by multiple thread that's why there is need of mQueueMutex.
+     * With nothing to run the thread spins for a few rounds, then announces it is parking
+     * (`mSleeping` = 1), checks the queue once more and waits on `mSleeping`. The seq_cst
+     * fences on both sides guarantee that either the worker sees the new task or the
+     * producer sees the worker parked, never neither. With timers armed the wait times
+     * out at the next deadline.
      */
     void run();
 
  /**
   * @brief  Add new work (task) for the worker thread
   *
-  * Locks the worker's task queue, add a Task object, and then releases the lock and wakes up the
-  * sleeping thread(worker). The worker thread wakes up, pop the new task and runs it.
+  * Moves the task into the worker's ring and wakes the worker if it is parked. When the
+  * ring is full the caller yields until the worker makes room (a task must therefore not
+  * fill its own worker's ring).
   * @param t
   */
- void postTask(const Task& t);
+ void postTask(Task&& t);
 
  /**
   * @brief Signals the worker to exit gracefully.
@@ -86,6 +102,27 @@ struct Worker {
   */
  void postStop();
 
+ /** @brief Approximate number of tasks queued and not started. */
+ size_t pending() const noexcept { return mQueue.size(); }
+
+ /** @brief The worker running the calling thread, nullptr outside workers. */
+ static Worker* current() noexcept { return tCurrent; }
+
+ /** @brief Posts a task resuming `h` on this worker. */
+ void resume(std::coroutine_handle<> h);
+
+ /**
+  * @brief Resumes `h` on this worker once TscClock::now() reaches `deadlineNs`.
+  * @note Worker thread only. Coroutines still sleeping when the worker stops are never resumed.
+  */
+ void resumeAt(uint64_t deadlineNs, std::coroutine_handle<> h);
+
+ /**
+  * @brief Timers of this worker, deadlines in TscClock nanoseconds. Worker thread only:
+  * other threads post a task which arms the timer.
+  */
+ TimerWheel& timers() noexcept { return mTimers; }
+
  /**
   * @brief
   * To optimize it's better to release the lock before actually calling .join() as std::thread::join()
@@ -95,8 +132,17 @@ struct Worker {
   * Other code can now safely call start() or inspect state without deadlock risk.
   */
  void join() noexcept;
+
+private:
+ static inline thread_local Worker* tCurrent = nullptr;
+
+ /** @brief Wakes the worker if it is parked. */
+ void wake() noexcept;
+
+ /** @brief Futex wait while `mSleeping` is 1, at most `timeoutNs` (0 = no limit). */
+ void park(uint64_t timeoutNs) noexcept;
 };
 
 
 
-#endif //WORKER_H
\ No newline at end of file
+#endif //WORKER_H
@@ -0,0 +1,139 @@
+#include "WorkerSpec.h"
+
+#include <algorithm>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+
+#include "Exception.h"
+
+std::vector<int> WorkerSpec::parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos < list.size())
+    {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos)
+        {
+            end = list.size();
+        }
+        const std::string item = list.substr(pos, end - pos);
+        pos = end + 1;
+        if (item.find_first_not_of(" \t\n") == std::string::npos)
+        {
+            continue;
+        }
+
+        int first, last;
+        char trailing;
+        if (std::sscanf(item.c_str(), " %d - %d %c", &first, &last, &trailing) != 2)
+        {
+            if (std::sscanf(item.c_str(), " %d %c", &first, &trailing) != 1)
+            {
+                ENG_THROW("Malformed CPU list '%s'", list.c_str());
+            }
+            last = first;
+        }
+        if (first < 0 || last < first || last >= CPU_SETSIZE)
+        {
+            ENG_THROW("Invalid CPU range '%s' in '%s'", item.c_str(), list.c_str());
+        }
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::vector<int> WorkerSpec::isolatedCpus()
+{
+    std::ifstream in("/sys/devices/system/cpu/isolated");
+    std::string line;
+    if (!in || !std::getline(in, line))
+    {
+        return {};
+    }
+    try
+    {
+        return parseCpuList(line);
+    }
+    catch (const Engine::EngException&)
+    {
+        return {};
+    }
+}
+
+WorkerSpec WorkerSpec::forIndex(size_t i, size_t count) const
+{
+    WorkerSpec spec = *this;
+    if (count > 1 && cpus.size() >= count)
+    {
+        spec.cpus = {cpus[i]};
+    }
+    if (count > 1 && !name.empty())
+    {
+        spec.name = name + "-" + std::to_string(i);
+    }
+    return spec;
+}
+
+void WorkerSpec::apply(const std::string& fallbackName) const
+{
+    const pthread_t self = pthread_self();
+
+    // Linux limits thread names to 15 chars + NUL
+    const std::string threadName = (name.empty() ? fallbackName : name).substr(0, 15);
+    if (!threadName.empty())
+    {
+        pthread_setname_np(self, threadName.c_str());
+    }
+
+    if (!cpus.empty())
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+        {
+            CPU_SET(cpu, &set);
+        }
+        if (const int rc = pthread_setaffinity_np(self, sizeof(set), &set); rc != 0)
+        {
+            LOG_WARN("Thread '%s' cannot be pinned to its CPUs: %s", threadName.c_str(), std::strerror(rc));
+        }
+    }
+
+    if (isolated)
+    {
+        const std::vector<int> isolatedSet = isolatedCpus();
+        for (int cpu : cpus)
+        {
+            if (!std::binary_search(isolatedSet.begin(), isolatedSet.end(), cpu))
+            {
+                LOG_WARN("Thread '%s': CPU %d is not isolated (isolcpus), it is shared with other tasks",
+                    threadName.c_str(), cpu);
+            }
+        }
+        if (cpus.empty())
+        {
+            LOG_WARN("Thread '%s' is marked isolated but has no CPUs", threadName.c_str());
+        }
+    }
+
+    if (priority > 0)
+    {
+        sched_param param{};
+        param.sched_priority = priority;
+        if (const int rc = pthread_setschedparam(self, SCHED_FIFO, &param); rc != 0)
+        {
+            LOG_WARN("Thread '%s' cannot use SCHED_FIFO priority %d: %s", threadName.c_str(), priority,
+                std::strerror(rc));
+        }
+    }
+
+    LOG_INFO("Thread '%s' placed: cpus=%zu priority=%d isolated=%d", threadName.c_str(), cpus.size(), priority,
+        isolated ? 1 : 0);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef WORKER_SPEC_H
+#define WORKER_SPEC_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct WorkerSpec
+ * @brief Placement of a worker thread: the CPUs it may run on, its scheduling policy
+ * and its name.
+ *
+ * @details
+ * A worker applies its spec on its own thread before running any task, so a hot loop
+ * never starts on the wrong core. Threads which are not workers (a process main loop)
+ * call apply() themselves. Each process reads its specs from the <Threads> section of
+ * its config.xml node (see Core::ThreadsConfig); the default spec changes nothing.
+ *
+ * Failing to apply a spec (missing CAP_SYS_NICE, CPU offline) is logged and the thread
+ * keeps running where the OS placed it: a misconfigured host degrades latency, it does
+ * not stop the exchange.
+ */
+struct WorkerSpec {
+    std::vector<int> cpus;      ///> Allowed CPUs, empty = any CPU
+    int priority{0};            ///> SCHED_FIFO priority (1..99), 0 = normal SCHED_OTHER
+    bool isolated{false};       ///> cpus are expected to be isolated from the OS (isolcpus / nohz_full)
+    std::string name;           ///> Thread name shown by top -H / ps, 15 chars max
+
+    /**
+     * @brief Parses a CPU list in the kernel's format ("2", "4-6,9").
+     * @throws EngException on a malformed list or an out of range CPU.
+     */
+    static std::vector<int> parseCpuList(const std::string& list);
+
+    /** @brief CPUs isolated from the scheduler (/sys/devices/system/cpu/isolated). */
+    static std::vector<int> isolatedCpus();
+
+    /** @brief Spec of the i-th thread of a group: the i-th of `cpus` if there is one per thread. */
+    WorkerSpec forIndex(size_t i, size_t count) const;
+
+    /**
+     * @brief Applies the spec to the calling thread.
+     * @param fallbackName Thread name used when `name` is empty (truncated to 15 chars).
+     */
+    void apply(const std::string& fallbackName = "") const;
+};
+
+#endif //WORKER_SPEC_H
@@ -10,7 +10,7 @@ namespace Exchange {
 
         /**
          * @enum Types of message
-         * NONE, NEW ORDER, CANCEL, TRADE, BOOK_DELTA
+         * NONE, NEW ORDER, CANCEL, TRADE, BOOK_DELTA, REPLACE, END_OF_DAY
         **/
         enum class MsgType : uint16_t {
             NONE        = 0,
@@ -18,6 +18,8 @@ namespace Exchange {
             CANCEL      = 2, // Client wants to cancel an existing resting order
             TRADE       = 3, // trade occurred
             BOOK_DELTA  = 4, // incremental change to the order book
+            REPLACE     = 5, // Client wants to amend price/qty of an existing resting order
+            END_OF_DAY  = 6, // Trading day is over, every resting non GTC order expires
         };
 
         /**
@@ -42,6 +44,23 @@ namespace Exchange {
             FIELD_CLIENT_ID     = 5,
             FIELD_ORDER_ID      = 6,
             FIELD_TIF           = 7,
+            FIELD_ORD_TYPE      = 8,  // Order::Type, LIMIT when absent
+            FIELD_TRACE         = 9,  // BYTES, LatencyTrace of a sampled message
+            FIELD_SYMBOL_ID     = 10, // UINT64, id of the symbol in the Ipc::SymbolTable
+        };
+
+        /**
+         * @enum Points of the order path stamped in a LatencyTrace, in path order
+        **/
+        enum class TraceStage : uint8_t {
+            NIC_READ        = 0, // Gateway: bytes read from the socket
+            DISPATCH        = 1, // Gateway: packet popped by the dispatcher
+            PARSE_DONE      = 2, // Gateway: FIX parsed
+            IPC_PUBLISH     = 3, // Gateway: written to the sequencer queue
+            SEQUENCER_READ  = 4, // Sequencer: read from the gateway queue
+            JOURNAL_DURABLE = 5, // Sequencer: appended to the journal
+            ENGINE_ACK      = 6, // Engine: accepted by the owning shard
+            COUNT
         };
 
     } // namespace namespace Ipc::Msg
@@ -59,7 +78,8 @@ namespace Exchange {
         };
 
         /**
-         * @enum Side which order belongs to
+         * @enum Order type (FIX tag 40). A market order carries no price: it trades at
+         * whatever the opposite side offers and never rests.
         **/
         enum class Type : uint8_t {
             MARKET,
@@ -89,6 +109,19 @@ namespace Exchange {
             GOOD_TILL_CANCEL = 4,                               // 110 (4)
             DEFAULT = DAY
         };
+
+        /**
+         * @brief TIF values are bit flags (e.g. GTC | AON). Checks whether all bits of
+         * `flag` are set in `tif`.
+        **/
+        constexpr bool hasFlag(TIF tif, TIF flag) {
+            return flag != TIF::DAY &&
+                   (static_cast<uint8_t>(tif) & static_cast<uint8_t>(flag)) == static_cast<uint8_t>(flag);
+        }
+
+        constexpr TIF operator|(TIF lhs, TIF rhs) {
+            return static_cast<TIF>(static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs));
+        }
     } // namespace Order
 
 } // namespace Engine
\ No newline at end of file
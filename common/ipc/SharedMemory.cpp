@@ -1,15 +1,11 @@
 #include "SharedMemory.h"
+#include <fstream>
+#include <sys/stat.h>
 
 
 namespace Exchange::Ipc {
 
-
-    SharedMemory::SharedMemory(const Core::String& name, uint32_t capacity, bool create)
-            : mName("/" + name), mIsOwner(create) {
-        
-        // Calculate total size
-        mTotalSize = sizeof(SharedHeader) + (capacity * sizeof(Slot));
-
+    void* mapSegment(const Core::String& name, size_t& size, bool create, bool writable, int& fd) {
         if (create) {
             // Producer: Unlink old, Create new
             // shm_unlink removes any previously existing shared memory with the same name.
@@ -28,28 +24,70 @@ namespace Exchange::Ipc {
             // O_RDWR — open read/write.
             // 0666 — permissions: read/write for all users.
             // Returns a file descriptor in shmFd.
-            mFd = shm_open(name.get(), O_CREAT | O_RDWR, 0666);
-            if (mFd == -1) {
+            fd = shm_open(name.get(), O_CREAT | O_RDWR, 0666);
+            if (fd == -1) {
                 ENG_THROW("Producer: shm_open failed (create)");
             }
             // Sets the size of the shared memory object.
             // Newly created shared memory has size 0, so without ftruncate it cannot be mmap'ed properly.
             // ftruncate() sets or changes the size of a file — in this case, a POSIX shared-memory object created with shm_open.
-            if (ftruncate(mFd, mTotalSize) == -1) {
+            if (ftruncate(fd, size) == -1) {
                 ENG_THROW("Producer: ftruncate failed");
             }
         } 
         else {
             // Consumer: Open existing
-            mFd = shm_open(name.get(), O_RDWR, 0666);
-            if (mFd == -1) {
+            fd = shm_open(name.get(), writable ? O_RDWR : O_RDONLY, 0666);
+            if (fd == -1) {
                 ENG_THROW("Consumer: shm_open failed (open existing)");
             }
+            if (size == 0) {
+                struct stat st{};
+                if (fstat(fd, &st) == -1 || st.st_size == 0) {
+                    ENG_THROW("Consumer: shared memory '%s' is empty", name.get());
+                }
+                size = static_cast<size_t>(st.st_size);
+            }
         }
-        mBasePtr = mmap(0, mTotalSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
-        if (mBasePtr == MAP_FAILED) {
+        void* base = mmap(0, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
             ENG_THROW("mmap failed");
         }
+        return base;
+    }
+
+    Core::String publishSession(const Core::String& name) {
+        Core::String sessionUuid = generateUuid();
+
+        const Core::String uuidPath = "/tmp/" + name + ".uuid";
+        std::ofstream f(uuidPath.get(), std::ios::trunc);
+        f << sessionUuid;
+        f.close();
+        return sessionUuid;
+    }
+
+    void checkSession(const Core::String& name, const char* uuid) {
+        const Core::String uuidPath = "/tmp/" + name +".uuid";
+        std::ifstream f(uuidPath.get());
+        if (!f.is_open()) {
+            ENG_THROW("UUID file not found");
+        }
+        char expectedUuid[37] = {};
+        f.getline(expectedUuid, sizeof(expectedUuid));
+        
+        if (std::strncmp(uuid, expectedUuid, 36) != 0) {
+            ENG_THROW("Stale shared memory session");
+        }
+    }
+
+    SharedMemory::SharedMemory(const Core::String& name, uint32_t capacity, bool create)
+            : mName("/" + name), mIsOwner(create) {
+        
+        // Calculate total size
+        mTotalSize = sizeof(SharedHeader) + (capacity * sizeof(Slot));
+
+        mBasePtr = mapSegment(name, mTotalSize, create, true, mFd);
+
         // Calculate offsets
         mHeader = static_cast<SharedHeader*>(mBasePtr);
         
@@ -27,12 +27,30 @@ namespace Exchange::Ipc {
 
         // Align to cache line to prevent false sharing between producer/consumer
         alignas(CACHE_LINE_SIZE) uint32_t writeIdx; // Producer writes here
+
+        // Producer telemetry, on the producer's cache line (written by it only)
+        uint32_t highWater;     // Highest depth seen after a write
+        uint64_t fullEvents;    // Stalls: first write refused because the ring was full
+        uint64_t stallNs;       // Time from a refused write to the next accepted one
+
         alignas(CACHE_LINE_SIZE) uint32_t readIdx;  // Consumer reads here
 
         uint32_t capacity;
         uint32_t maxMsgSize;
     }; // class SharedHeader
 
+    /**
+     * @struct RingStats
+     * @brief Occupancy and backpressure telemetry of a ring (see SharedHeader).
+     */
+    struct RingStats {
+        uint32_t depth;
+        uint32_t capacity;
+        uint32_t highWater;
+        uint64_t fullEvents;
+        uint64_t stallNs;
+    };
+
     // Helper to generate uuid
     inline Core::String generateUuid() {
         static std::random_device rd;
@@ -51,6 +69,22 @@ namespace Exchange::Ipc {
         return uuid;
     }
 
+    /**
+     * @brief Creates (any previous segment of that name is discarded) or opens the POSIX
+     * shared memory object `name` and maps it.
+     * @param size Bytes to map. When opening, 0 maps the whole object; it is set to the
+     * mapped length on return.
+     * @param writable false maps the segment read-only (observers).
+     * @return Base of the mapping, throws on failure. The descriptor is returned in `fd`.
+     */
+    void* mapSegment(const Core::String& name, size_t& size, bool create, bool writable, int& fd);
+
+    /** @brief Producer side: generates a session uuid for `name` and publishes it in /tmp. */
+    Core::String publishSession(const Core::String& name);
+
+    /** @brief Throws unless `uuid` (from a segment header) is the published session of `name`. */
+    void checkSession(const Core::String& name, const char* uuid);
+
     class SharedMemory {
     protected:
         Core::String mName;     ///> Name of the shared memory object
@@ -68,12 +102,30 @@ namespace Exchange::Ipc {
          * POSIX shared memory objects must start with '/'
          */
         SharedMemory(const Core::String& name, uint32_t capacity, bool create);
-            
+
+        /** @brief Messages written and not yet read (two relaxed loads, for metrics). */
+        uint32_t depth() const {
+            return __atomic_load_n(&mHeader->writeIdx, __ATOMIC_RELAXED)
+                - __atomic_load_n(&mHeader->readIdx, __ATOMIC_RELAXED);
+        }
+
+        /** @brief Telemetry snapshot, readable from either side of the ring. */
+        RingStats stats() const {
+            return RingStats{
+                depth(),
+                mHeader->capacity,
+                __atomic_load_n(&mHeader->highWater, __ATOMIC_RELAXED),
+                __atomic_load_n(&mHeader->fullEvents, __ATOMIC_RELAXED),
+                __atomic_load_n(&mHeader->stallNs, __ATOMIC_RELAXED)
+            };
+        }
+
     }; // class SharedMemory
 
 
     class Producer : public SharedMemory {
         ScopedFileLock mLock;   ///> File lock to enforce single producer
+        uint64_t mStallStart{0}; ///> TscClock ns of the first refused write of a stall, 0 if none
     public:
         /**
          * @brief Constructor
@@ -89,6 +141,10 @@ namespace Exchange::Ipc {
          * @param data Pointer to the data to write.
          * @param size Size of the data in bytes.
          * @return true if write succeeded, false if buffer is full or size exceeds max message size.
+         *
+         * The first refused write on a full ring counts a full event and starts a stall, which the
+         * next accepted write closes (adding its duration to stallNs); only that path reads
+         * the clock. An accepted write raises highWater when the depth exceeds it.
          * 
          * @details
          * This is lock free write operation. It uses atomic operations to manage the write and read indices.
@@ -1,5 +1,4 @@
 #include "SharedMemory.h"
-#include <fstream>
 
 namespace Exchange::Ipc {
 
@@ -12,17 +11,7 @@ namespace Exchange::Ipc {
             ENG_THROW("Invalid IPC Header Signature");
         }
 
-        const Core::String uuidPath = "/tmp/" + mName +".uuid";
-        std::ifstream f(uuidPath);
-        if (!f.is_open()) {
-            ENG_THROW("UUID file not found");
-        }
-        char expectedUuid[37] = {};
-        f.getline(expectedUuid, sizeof(expectedUuid));
-        
-        if (std::strncmp(mHeader->uuid, expectedUuid, 36) != 0) {
-            ENG_THROW("Stale shared memory session");
-        }
+        checkSession(mName, mHeader->uuid);
 
         LOG_INFO("Attached. Session: %s",mHeader->uuid);
     }
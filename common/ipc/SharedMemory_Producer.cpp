@@ -1,5 +1,5 @@
 #include "SharedMemory.h"
-#include <fstream>
+#include "Clock/TscClock.h"
 
 namespace Exchange::Ipc {
 
@@ -8,13 +8,8 @@ namespace Exchange::Ipc {
         std::memset(mHeader, 0, sizeof(SharedHeader));
         std::strncpy(mHeader->signature, MAGIC, 32); // Set magic signature
 
-        // Generate and set UUID
-        Core::String sessionUuid = generateUuid();
-
-        const Core::String uuidPath = "/tmp/" + mName + ".uuid";
-        std::ofstream f(uuidPath.get(), std::ios::trunc);
-        f << sessionUuid;
-        f.close();
+        // Generate, publish and set UUID
+        Core::String sessionUuid = publishSession(mName);
 
         std::strncpy(mHeader->uuid, sessionUuid.get(), 37);
         mHeader->capacity = capacity;
@@ -40,6 +35,12 @@ namespace Exchange::Ipc {
         // uint32_t currentRead = readRef.load(std::memory_order_acquire); // acquire to see consumer's updates coz it writes before reading thee
         // Check if full
         if (currentWrite - currentRead >= mHeader->capacity) {
+            // Telemetry fields have a single writer: plain increments, atomic stores for readers.
+            // Retries of the same stall are not counted again.
+            if (mStallStart == 0) {
+                __atomic_store_n(&mHeader->fullEvents, mHeader->fullEvents + 1, __ATOMIC_RELAXED);
+                mStallStart = Core::TscClock::now();
+            }
             return false; 
         }
         // Write Data
@@ -58,6 +59,15 @@ namespace Exchange::Ipc {
         // index updates.
         __atomic_store_n(&mHeader->writeIdx, currentWrite + 1, __ATOMIC_RELEASE);
         // writeRef.store(currentWrite + 1, std::memory_order_release); // cpp 20
+
+        const uint32_t depth = currentWrite + 1 - currentRead;
+        if (depth > mHeader->highWater) {
+            __atomic_store_n(&mHeader->highWater, depth, __ATOMIC_RELAXED);
+        }
+        if (mStallStart != 0) {
+            __atomic_store_n(&mHeader->stallNs, mHeader->stallNs + (Core::TscClock::now() - mStallStart), __ATOMIC_RELAXED);
+            mStallStart = 0;
+        }
         return true;
     }
 
@@ -2,398 +2,609 @@
 
 #include <cstring>
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
+#include <bit>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <ostream>
 #include <istream>
 
 namespace Exchange::Core {
-    
-    class String {
+
+    /** @brief Default allocator of BasicString: the global heap. */
+    struct HeapAllocator {
+        static char* allocate(std::size_t bytes) {
+            return static_cast<char*>(::operator new(bytes));
+        }
+
+        static void deallocate(char* p, std::size_t) noexcept {
+            ::operator delete(p);
+        }
+
+        /** @brief Bytes actually obtained when asking for `bytes`. */
+        static constexpr std::size_t goodSize(std::size_t bytes) noexcept {
+            return bytes;
+        }
+    };
+
+    /**
+     * @class StringArena
+     * @brief Per-thread arena of string buffers: blocks of 32 B to 4 KiB (powers of two),
+     * recycled through thread-local free lists, so strings built and dropped over and
+     * over on one thread stop calling malloc once the lists are warm.
+     *
+     * @details
+     * A block freed by another thread joins that thread's lists. Each thread keeps at most
+     * CACHE_LIMIT blocks per size and returns the rest to the heap, as it does with larger
+     * buffers. The lists are released when the thread exits.
+     */
+    class StringArena {
+        static constexpr std::size_t MIN_BLOCK = 32;
+        static constexpr unsigned CLASSES = 8;          ///> 32 B .. 4 KiB
+        static constexpr uint32_t CACHE_LIMIT = 256;    ///> Blocks kept per size and thread
+
+        struct Block {
+            Block* next;
+        };
+
+        struct Cache {
+            Block* head[CLASSES]{};
+            uint32_t count[CLASSES]{};
+            bool destroyed{false};      ///> Thread exiting: strings freed by later destructors go to the heap
+
+            ~Cache() {
+                for (unsigned c = 0; c < CLASSES; ++c) {
+                    for (Block* b = head[c]; b;) {
+                        Block* next = b->next;
+                        ::operator delete(b);
+                        b = next;
+                    }
+                    head[c] = nullptr;
+                    count[c] = 0;
+                }
+                destroyed = true;
+            }
+        };
+
+        static Cache& cache() noexcept {
+            static thread_local Cache c;
+            return c;
+        }
+
+        static unsigned sizeClass(std::size_t bytes) noexcept {
+            return bytes <= MIN_BLOCK ? 0 : static_cast<unsigned>(std::bit_width((bytes - 1) / MIN_BLOCK));
+        }
+
+    public:
+        static constexpr std::size_t goodSize(std::size_t bytes) noexcept {
+            return bytes > (MIN_BLOCK << (CLASSES - 1)) ? bytes : std::max(MIN_BLOCK, std::bit_ceil(bytes));
+        }
+
+        static char* allocate(std::size_t bytes) {
+            const unsigned c = sizeClass(bytes);
+            if (c < CLASSES) {
+                Cache& k = cache();
+                if (Block* b = k.destroyed ? nullptr : k.head[c]) {
+                    k.head[c] = b->next;
+                    --k.count[c];
+                    return reinterpret_cast<char*>(b);
+                }
+            }
+            return static_cast<char*>(::operator new(goodSize(bytes)));
+        }
+
+        static void deallocate(char* p, std::size_t bytes) noexcept {
+            const unsigned c = sizeClass(bytes);
+            if (c < CLASSES) {
+                Cache& k = cache();
+                if (!k.destroyed && k.count[c] < CACHE_LIMIT) {
+                    Block* b = reinterpret_cast<Block*>(p);
+                    b->next = k.head[c];
+                    k.head[c] = b;
+                    ++k.count[c];
+                    return;
+                }
+            }
+            ::operator delete(p);
+        }
+    };
+
+    /**
+     * @class BasicString
+     * @brief Null-terminated string with a small-string buffer: up to INLINE_CAPACITY (23)
+     * characters are stored inside the 24-byte object, without allocation. That covers
+     * FIX tags such as symbols, sides, message types and client order ids.
+     *
+     * @details
+     * Inline, the last byte holds INLINE_CAPACITY - size, so a full inline string ends with
+     * its own terminator. On the heap the object holds pointer, size and capacity, the top
+     * byte of the capacity carrying HEAP_FLAG, which inline sizes never reach.
+     * Heap buffers come from `Allocator` (static allocate/deallocate/goodSize): the global
+     * heap for String, the per-thread StringArena for ArenaString.
+     */
+    template <typename Allocator>
+    class BasicString {
     public:
         using sizeType = std::size_t;
         static constexpr sizeType npos = static_cast<sizeType>(-1);
+        static constexpr sizeType INLINE_CAPACITY = 23;
 
     private:
-        char* mBuffer;
-        sizeType mSize;
+        static_assert(std::endian::native == std::endian::little, "BasicString layout assumes little endian");
+
+        static constexpr unsigned char HEAP_FLAG = 0x80;
+        static constexpr sizeType CAPACITY_MASK = ~(static_cast<sizeType>(0xFF) << 56);
+
+        struct Heap {
+            char* data;
+            sizeType size;
+            sizeType capacity;    ///> Top byte is HEAP_FLAG
+        };
+
+        union {
+            Heap mHeap;
+            char mInline[INLINE_CAPACITY + 1];
+        };
+
+        bool isHeap() const noexcept {
+            return static_cast<unsigned char>(mInline[INLINE_CAPACITY]) & HEAP_FLAG;
+        }
 
-        static const char& nullChar()
-        {
-            static const char null = '\0';
-            return null;
+        void setEmpty() noexcept {
+            mInline[0] = '\0';
+            mInline[INLINE_CAPACITY] = static_cast<char>(INLINE_CAPACITY);
         }
-    
+
+        void setSize(sizeType n) noexcept {
+            if (isHeap()) {
+                mHeap.size = n;
+            }
+            else {
+                mInline[INLINE_CAPACITY] = static_cast<char>(INLINE_CAPACITY - n);
+            }
+            data()[n] = '\0';
+        }
+
+        /** @brief Switches to a heap buffer for at least `cap` characters, keeping the content. */
+        void grow(sizeType cap) {
+            const sizeType bytes = Allocator::goodSize(cap + 1);
+            char* buffer = Allocator::allocate(bytes);
+            const sizeType n = size();
+            std::memcpy(buffer, data(), n + 1);
+            release();
+            mHeap.data = buffer;
+            mHeap.size = n;
+            mHeap.capacity = (bytes - 1) | (static_cast<sizeType>(HEAP_FLAG) << 56);
+        }
+
+        void release() noexcept {
+            if (isHeap()) {
+                Allocator::deallocate(mHeap.data, capacity() + 1);
+            }
+        }
+
+        void init(const char* str, sizeType len) {
+            setEmpty();
+            if (len > INLINE_CAPACITY) {
+                grow(len);
+            }
+            if (len > 0) {
+                std::memcpy(data(), str, len);
+            }
+            setSize(len);
+        }
+
     public:
 
         // ------------------------------------ <Constructors> ------------------------------------
 
         /** @brief Constructor */
-        String() : mBuffer(nullptr), mSize(0) {}
+        BasicString() noexcept {
+            setEmpty();
+        }
 
         /** @brief Constructor */
-        String(const char* str) {
-            if (str && *str) {
-                mSize = std::strlen(str);
-                mBuffer = new char[mSize + 1];
-                std::memcpy(mBuffer, str, mSize + 1);
-            }
-            else {
-                mBuffer = nullptr;
-                mSize = 0;
-            }
+        BasicString(const char* str) {
+            init(str, str ? std::strlen(str) : 0);
         }
 
         /** @brief Constructor */
-        String(const char* str, sizeType len) {
-            if (str && len > 0) {
-                mSize = len;
-                mBuffer = new char[mSize + 1];
-                std::memcpy(mBuffer, str, mSize);
-                mBuffer[mSize] = nullChar();
-            }
-            else {
-                mBuffer = nullptr;
-                mSize = 0;
-            }
+        BasicString(const char* str, sizeType len) {
+            init(str, str ? len : 0);
         }
 
         /** @brief Constructor */
-        String(const std::string& str) {
-            mSize = std::strlen(str.c_str());
-            if (mSize > 0) {
-                mBuffer = new char[mSize + 1];
-                std::memcpy(mBuffer, str.c_str(), mSize + 1);
-            }
-            else {
-                mBuffer = nullptr;
-            }
+        BasicString(const std::string& str) {
+            init(str.data(), str.size());
+        }
+
+        /** @brief Constructor */
+        BasicString(std::string_view str) {
+            init(str.data(), str.size());
         }
 
         /** @brief Copy constructor */
-        String(const String& other) {
-            if (other.mBuffer) {
-                mSize = other.mSize;
-                mBuffer = new char [mSize + 1];
-                std::memcpy(mBuffer, other.mBuffer, mSize + 1);
-            }
-            else {
-                mBuffer = nullptr;
-                mSize = 0;
-            }
+        BasicString(const BasicString& other) {
+            init(other.data(), other.size());
+        }
+
+        /** @brief From a string of another allocator */
+        template <typename OtherAllocator>
+        explicit BasicString(const BasicString<OtherAllocator>& other) {
+            init(other.data(), other.size());
         }
 
         /** @brief Move constructor */
-        String(String&& other) : mBuffer(other.mBuffer), mSize(other.mSize) {
-            other.mBuffer = nullptr;
-            other.mSize = 0;
+        BasicString(BasicString&& other) noexcept {
+            std::memcpy(static_cast<void*>(this), &other, sizeof(BasicString));
+            other.setEmpty();
         }
 
         /** @brief Fill constructor */
-        String(sizeType count, char ch) {
-            if (count > 0) {
-                mSize = count;
-                mBuffer = new char[mSize + 1];
-                std::memset(mBuffer, ch, mSize);
-                mBuffer[mSize] = '\0';
-            } else {
-                mBuffer = nullptr;
-                mSize = 0;
-            }
+        BasicString(sizeType count, char ch) {
+            setEmpty();
+            reserve(count);
+            std::memset(data(), ch, count);
+            setSize(count);
         }
 
         /** @brief Destructor */
-        ~String() {
-            delete[] mBuffer;
-            mSize = 0;
+        ~BasicString() {
+            release();
         }
 
         // ------------------------------------ <Assignment operators> ------------------------------------
 
-        /** @brief Copy assignment */
-        String& operator=(const String& other) {
+        /** @brief Copy assignment, reuses the buffer when it is large enough */
+        BasicString& operator=(const BasicString& other) {
             if (this != &other) {
-                String temp(other);
-                swap(temp);
+                assign(other.data(), other.size());
             }
             return *this;
         }
 
         /** @brief Move assignment */
-        String& operator=(String&& other) {
+        BasicString& operator=(BasicString&& other) noexcept {
             if (this != &other) {
-                delete[] mBuffer;
-                mBuffer = other.mBuffer;
-                mSize = other.mSize;
-                other.mBuffer = nullptr;
-                other.mSize = 0;
+                release();
+                std::memcpy(static_cast<void*>(this), &other, sizeof(BasicString));
+                other.setEmpty();
             }
             return *this;
         }
 
         /** @brief From C-string */
-        String& operator=(const char* str) {
-            String temp(str);
-            swap(temp);
+        BasicString& operator=(const char* str) {
+            return assign(str, str ? std::strlen(str) : 0);
+        }
+
+        BasicString& operator=(std::string_view str) {
+            return assign(str.data(), str.size());
+        }
+
+        BasicString& operator=(const std::string& str) {
+            return assign(str.data(), str.size());
+        }
+
+        /** @brief Replaces the content, without allocation when it fits the current buffer. */
+        BasicString& assign(const char* str, sizeType len) {
+            if (len > capacity()) {
+                // Not from our own buffer: it is smaller than len
+                setSize(0);
+                grow(len);
+            }
+            if (len > 0) {
+                std::memmove(data(), str, len);
+            }
+            setSize(len);
             return *this;
         }
 
         // ------------------------------------ <Implicit conversions> ------------------------------------
 
-        operator const char*() const {
-            return mBuffer ? mBuffer : "";
+        operator const char*() const noexcept {
+            return data();
+        }
+
+        operator std::string_view() const noexcept {
+            return view();
         }
 
-        const char* get() const {
-            return mBuffer ? mBuffer : "";
+        const char* get() const noexcept {
+            return data();
         }
 
-        char* get() {
-            return mBuffer;
+        char* get() noexcept {
+            return data();
+        }
+
+        const char* data() const noexcept {
+            return isHeap() ? mHeap.data : mInline;
+        }
+
+        char* data() noexcept {
+            return isHeap() ? mHeap.data : mInline;
+        }
+
+        const char* c_str() const noexcept {
+            return data();
+        }
+
+        std::string_view view() const noexcept {
+            return std::string_view(data(), size());
         }
 
         std::string toString() const {
-            return static_cast<std::string>(mBuffer);
+            return std::string(data(), size());
         }
 
         // ------------------------------------ <Capacity> ------------------------------------
 
         sizeType size() const noexcept {
-            return mSize;
+            return isHeap() ? mHeap.size : INLINE_CAPACITY - static_cast<unsigned char>(mInline[INLINE_CAPACITY]);
+        }
+
+        sizeType length() const noexcept {
+            return size();
+        }
+
+        sizeType capacity() const noexcept {
+            return isHeap() ? (mHeap.capacity & CAPACITY_MASK) : INLINE_CAPACITY;
         }
 
         bool empty() const noexcept {
-            return mSize == 0;
+            return size() == 0;
+        }
+
+        void reserve(sizeType cap) {
+            if (cap > capacity()) {
+                grow(cap);
+            }
         }
 
         // ------------------------------------ <Element access> ------------------------------------
 
         char& operator[](sizeType pos) noexcept {
-            return mBuffer[pos];
+            return data()[pos];
         }
 
         const char& operator[](sizeType pos) const noexcept {
-            return mBuffer ? mBuffer[pos] : nullChar();
+            return data()[pos];
         }
 
         char& at(sizeType pos) {
-            if (pos >= mSize) {
+            if (pos >= size()) {
                 throw std::out_of_range("String::at: index out of range");
             }
-            return mBuffer[pos];
+            return data()[pos];
         }
-    
+
         const char& at(sizeType pos) const {
-            if (pos >= mSize) {
+            if (pos >= size()) {
                 throw std::out_of_range("String::at: index out of range");
             }
-            return mBuffer[pos];
+            return data()[pos];
         }
-        
+
         char& front() noexcept {
-            return mBuffer[0];
+            return data()[0];
         }
-        
+
         const char& front() const noexcept {
-            return mBuffer ? mBuffer[0] : nullChar();
+            return data()[0];
         }
-        
+
         char& back() noexcept {
-            return mBuffer[mSize - 1];
+            return data()[empty() ? 0 : size() - 1];
         }
-        
+
         const char& back() const noexcept {
-            return mBuffer && mSize > 0 ? mBuffer[mSize - 1] : nullChar();
+            return data()[empty() ? 0 : size() - 1];
         }
 
+        char* begin() noexcept { return data(); }
+        char* end() noexcept { return data() + size(); }
+        const char* begin() const noexcept { return data(); }
+        const char* end() const noexcept { return data() + size(); }
+
         // ------------------------------------ <Modifiers> ------------------------------------
 
+        /** @brief Empties the string, keeping its buffer. */
         void clear() noexcept {
-            delete[] mBuffer;
-            mBuffer = nullptr;
-            mSize = 0;
-        }
-    
-        String& append(const char* str) {
-            if (str && *str) {
-                sizeType str_len = std::strlen(str);
-                sizeType new_size = mSize + str_len;
-                char* new_buffer = new char[new_size + 1];
-                
-                if (mBuffer) {
-                    std::memcpy(new_buffer, mBuffer, mSize);
-                }
-                std::memcpy(new_buffer + mSize, str, str_len + 1);
-                
-                delete[] mBuffer;
-                mBuffer = new_buffer;
-                mSize = new_size;
-            }
-            return *this;
+            setSize(0);
         }
-        
-        String& append(const String& str) {
-            return append(str.mBuffer);
-        }
-        
-        String& append(char ch) {
-            char temp[2] = {ch, nullChar()};
-            return append(temp);
+
+        BasicString& append(const char* str) {
+            return append(str, str ? std::strlen(str) : 0);
         }
-        
-        String& append(const char* str, sizeType count) {
+
+        BasicString& append(const char* str, sizeType count) {
             if (str && count > 0) {
-                sizeType new_size = mSize + count;
-                char* new_buffer = new char[new_size + 1];
-                
-                if (mBuffer) {
-                    std::memcpy(new_buffer, mBuffer, mSize);
+                const sizeType n = size();
+                if (n + count > capacity()) {
+                    // `str` may point into this string
+                    const std::ptrdiff_t offset = str - data();
+                    const bool inside = offset >= 0 && static_cast<sizeType>(offset) <= n;
+                    grow(std::max(n + count, 2 * capacity()));
+                    if (inside) {
+                        str = data() + offset;
+                    }
                 }
-                std::memcpy(new_buffer + mSize, str, count);
-                new_buffer[new_size] = nullChar();
-                
-                delete[] mBuffer;
-                mBuffer = new_buffer;
-                mSize = new_size;
+                std::memmove(data() + n, str, count);
+                setSize(n + count);
             }
             return *this;
         }
 
-        String& operator+=(const String& str) {
+        BasicString& append(std::string_view str) {
+            return append(str.data(), str.size());
+        }
+
+        BasicString& append(const BasicString& str) {
+            return append(str.data(), str.size());
+        }
+
+        BasicString& append(const std::string& str) {
+            return append(str.data(), str.size());
+        }
+
+        BasicString& append(char ch) {
+            return append(&ch, 1);
+        }
+
+        BasicString& operator+=(const BasicString& str) {
             return append(str);
         }
-        
-        String& operator+=(const char* str) {
+
+        BasicString& operator+=(const char* str) {
             return append(str);
         }
-        
-        String& operator+=(char ch) {
-            return append(ch);
+
+        BasicString& operator+=(const std::string& str) {
+            return append(str);
         }
 
+        BasicString& operator+=(std::string_view str) {
+            return append(str);
+        }
 
+        BasicString& operator+=(char ch) {
+            return append(ch);
+        }
 
-        friend String operator+(const String& lhs, const String& rhs) {
-            String result;
-            result.mSize = lhs.mSize + rhs.mSize;
-            result.mBuffer = new char[result.mSize + 1];
-            
-            if (lhs.mBuffer) {
-                std::memcpy(result.mBuffer, lhs.mBuffer, lhs.mSize);
-            }
-            if (rhs.mBuffer) {
-                std::memcpy(result.mBuffer + lhs.mSize, rhs.mBuffer, rhs.mSize);
-            }
-            result.mBuffer[result.mSize] = '\0';
-            
+        friend BasicString operator+(const BasicString& lhs, const BasicString& rhs) {
+            BasicString result;
+            result.reserve(lhs.size() + rhs.size());
+            result.append(lhs);
+            result.append(rhs);
             return result;
         }
-        
-        friend String operator+(String&& lhs, const String& rhs) {
+
+        friend BasicString operator+(BasicString&& lhs, const BasicString& rhs) {
             lhs.append(rhs);
             return std::move(lhs);
         }
-        
-        friend String operator+(const String& lhs, String&& rhs) {
-            String result(lhs);
+
+        friend BasicString operator+(const BasicString& lhs, BasicString&& rhs) {
+            BasicString result(lhs);
             result.append(rhs);
             return result;
         }
-        
-        friend String operator+(String&& lhs, String&& rhs) {
+
+        friend BasicString operator+(BasicString&& lhs, BasicString&& rhs) {
             lhs.append(rhs);
             return std::move(lhs);
         }
-        
-        friend String operator+(const String& lhs, const char* rhs) {
-            String result(lhs);
-            result.append(rhs);
+
+        friend BasicString operator+(const BasicString& lhs, const char* rhs) {
+            BasicString result(lhs);
+            result += rhs;
             return result;
         }
-        
-        friend String operator+(const char* lhs, const String& rhs) {
-            String result(lhs);
+
+        friend BasicString operator+(const char* lhs, const BasicString& rhs) {
+            BasicString result(lhs);
             result.append(rhs);
             return result;
         }
-        
-        friend String operator+(const String& lhs, char rhs) {
-            String result(lhs);
+
+        friend BasicString operator+(const BasicString& lhs, char rhs) {
+            BasicString result(lhs);
             result.append(rhs);
             return result;
         }
-        
-        friend String operator+(char lhs, const String& rhs) {
-            String result(1, lhs);
+
+        friend BasicString operator+(char lhs, const BasicString& rhs) {
+            BasicString result(1, lhs);
             result.append(rhs);
             return result;
         }
 
-        friend String operator+(String&& lhs, const char* rhs) {
-            lhs.append(rhs);
+        friend BasicString operator+(BasicString&& lhs, const char* rhs) {
+            lhs += rhs;
             return std::move(lhs);
         }
 
-        friend String operator+(String&& lhs, char rhs) {
+        friend BasicString operator+(BasicString&& lhs, char rhs) {
             lhs.append(rhs);
             return std::move(lhs);
         }
 
         // ------------------------------------ <Comparison> ------------------------------------
 
-        int compare(const String& other) const noexcept {
-            if (!mBuffer && !other.mBuffer) return 0;
-            if (!mBuffer) return -1;
-            if (!other.mBuffer) return 1;
-            return std::strcmp(mBuffer, other.mBuffer);
+        int compare(std::string_view other) const noexcept {
+            return view().compare(other);
         }
-        
+
+        int compare(const BasicString& other) const noexcept {
+            return compare(other.view());
+        }
+
+        int compare(const std::string& other) const noexcept {
+            return compare(std::string_view(other));
+        }
+
+        /** @brief nullptr compares as the empty string */
         int compare(const char* str) const noexcept {
-            if (!mBuffer && !str) return 0;
-            if (!mBuffer) return -1;
-            if (!str) return 1;
-            return std::strcmp(mBuffer, str);
+            return compare(std::string_view(str ? str : ""));
         }
 
-        friend bool operator==(const String& lhs, const String& rhs) noexcept {
-            return lhs.compare(rhs) == 0;
+        friend bool operator==(const BasicString& lhs, const BasicString& rhs) noexcept {
+            return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
         }
-        
-        friend bool operator==(const String& lhs, const char* rhs) noexcept {
+
+        friend bool operator==(const BasicString& lhs, const char* rhs) noexcept {
             return lhs.compare(rhs) == 0;
         }
-        
-        friend bool operator==(const char* lhs, const String& rhs) noexcept {
+
+        friend bool operator==(const char* lhs, const BasicString& rhs) noexcept {
             return rhs.compare(lhs) == 0;
         }
 
-
-
         // ------------------------------------ <Search> ------------------------------------
-    
+
         sizeType find(const char* str, sizeType pos = 0) const noexcept {
-            if (!mBuffer || !str || pos >= mSize) {
+            if (!str || pos >= size()) {
                 return npos;
             }
-            const char* result = std::strstr(mBuffer + pos, str);
-            return result ? static_cast<sizeType>(result - mBuffer) : npos;
+            const char* result = std::strstr(data() + pos, str);
+            return result ? static_cast<sizeType>(result - data()) : npos;
         }
-        
+
         sizeType find(char ch, sizeType pos = 0) const noexcept {
-            if (!mBuffer || pos >= mSize) {
+            if (pos >= size()) {
                 return npos;
             }
-            const char* result = std::strchr(mBuffer + pos, ch);
-            return result ? static_cast<sizeType>(result - mBuffer) : npos;
+            const void* result = std::memchr(data() + pos, ch, size() - pos);
+            return result ? static_cast<sizeType>(static_cast<const char*>(result) - data()) : npos;
         }
-        
-        sizeType find(const String& str, sizeType pos = 0) const noexcept {
-            return find(str.mBuffer, pos);
+
+        sizeType find(const BasicString& str, sizeType pos = 0) const noexcept {
+            return find(str.data(), pos);
         }
 
-        void swap(String& other) {
-            std::swap(mBuffer, other.mBuffer);
-            std::swap(mSize, other.mSize);
+        void swap(BasicString& other) noexcept {
+            alignas(BasicString) unsigned char temp[sizeof(BasicString)];
+            std::memcpy(temp, static_cast<void*>(this), sizeof(BasicString));
+            std::memcpy(static_cast<void*>(this), &other, sizeof(BasicString));
+            std::memcpy(static_cast<void*>(&other), temp, sizeof(BasicString));
         }
     };
-}
\ No newline at end of file
+
+    /** @brief String of the global heap, the default string of the code base. */
+    using String = BasicString<HeapAllocator>;
+
+    /** @brief String whose buffers above 23 characters come from the per-thread StringArena. */
+    using ArenaString = BasicString<StringArena>;
+
+    static_assert(sizeof(String) == 24, "String must stay three words");
+
+    template <typename T>
+    inline constexpr bool isBasicString = false;
+
+    template <typename Allocator>
+    inline constexpr bool isBasicString<BasicString<Allocator>> = true;
+}
@@ -0,0 +1,237 @@
+#include "SymbolTable.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Exception.h"
+#include "SharedMemory.h"
+
+namespace Exchange::Ipc {
+
+    // Displacements tried per bucket before the build gives up
+    static constexpr uint32_t MAX_DISPLACEMENT = 1u << 20;
+
+    struct SymbolTableLayout {
+        size_t displacements;   // Offsets from the header, bytes
+        size_t slots;
+        size_t entries;
+        size_t size;
+    };
+
+    static size_t align8(size_t n) {
+        return (n + 7) & ~static_cast<size_t>(7);
+    }
+
+    static SymbolTableLayout layoutOf(uint32_t count, uint32_t buckets, uint32_t slots) {
+        SymbolTableLayout l{};
+        l.displacements = align8(sizeof(SymbolTableHeader));
+        l.slots = l.displacements + align8(buckets * sizeof(uint32_t));
+        l.entries = l.slots + align8(slots * sizeof(uint32_t));
+        l.size = l.entries + count * sizeof(SymbolEntry);
+        return l;
+    }
+
+    void SymbolTable::layout(const std::vector<std::string>& symbols, uint32_t& buckets, uint32_t& slots) {
+        if (symbols.size() >= NONE / 2) {
+            ENG_THROW("Too many symbols: %zu", symbols.size());
+        }
+        const uint32_t n = static_cast<uint32_t>(symbols.size());
+        // ~4 tickers per bucket, load factor at most 1/2: displacements are found in a few tries
+        buckets = std::max<uint32_t>(1, (n + 3) / 4);
+        slots = std::bit_ceil(std::max<uint32_t>(1, 2 * n));
+    }
+
+    void SymbolTable::build(void* base, const std::vector<std::string>& symbols, uint32_t buckets, uint32_t slots) {
+        const uint32_t n = static_cast<uint32_t>(symbols.size());
+        const SymbolTableLayout l = layoutOf(n, buckets, slots);
+        char* bytes = static_cast<char*>(base);
+        auto* header = reinterpret_cast<SymbolTableHeader*>(bytes);
+        auto* displacements = reinterpret_cast<uint32_t*>(bytes + l.displacements);
+        auto* slotIds = reinterpret_cast<uint32_t*>(bytes + l.slots);
+        auto* entries = reinterpret_cast<SymbolEntry*>(bytes + l.entries);
+
+        std::vector<std::string_view> sorted(symbols.begin(), symbols.end());
+        std::sort(sorted.begin(), sorted.end());
+        const auto duplicate = std::adjacent_find(sorted.begin(), sorted.end());
+        if (duplicate != sorted.end()) {
+            ENG_THROW("Duplicate symbol '%s'", std::string(*duplicate).c_str());
+        }
+
+        std::vector<uint64_t> hashes(n);
+        std::vector<std::vector<uint32_t>> members(buckets);
+        for (uint32_t id = 0; id < n; ++id) {
+            const std::string& s = symbols[id];
+            if (s.empty() || s.size() > MAX_SYMBOL_LEN) {
+                ENG_THROW("Invalid symbol '%s', expected 1 to %zu characters", s.c_str(), MAX_SYMBOL_LEN);
+            }
+            std::memcpy(entries[id].name, s.data(), s.size());
+            entries[id].len = static_cast<uint32_t>(s.size());
+            hashes[id] = hash(s);
+            members[static_cast<uint32_t>(hashes[id] >> 32) % buckets].push_back(id);
+        }
+
+        // Largest buckets first, while the table is still empty
+        std::vector<uint32_t> order(buckets);
+        for (uint32_t b = 0; b < buckets; ++b) {
+            order[b] = b;
+        }
+        std::stable_sort(order.begin(), order.end(), [&members](uint32_t a, uint32_t b) {
+            return members[a].size() > members[b].size();
+        });
+
+        std::fill(slotIds, slotIds + slots, NONE);
+        std::vector<uint32_t> taken;
+        for (uint32_t b : order) {
+            if (members[b].empty()) {
+                break;
+            }
+            bool placed = false;
+            for (uint32_t d = 0; d < MAX_DISPLACEMENT && !placed; ++d) {
+                taken.clear();
+                placed = true;
+                for (uint32_t id : members[b]) {
+                    const uint32_t s = slotOf(hashes[id], d, slots - 1);
+                    if (slotIds[s] != NONE || std::find(taken.begin(), taken.end(), s) != taken.end()) {
+                        placed = false;
+                        break;
+                    }
+                    taken.push_back(s);
+                }
+                if (placed) {
+                    for (size_t k = 0; k < taken.size(); ++k) {
+                        slotIds[taken[k]] = members[b][k];
+                    }
+                    displacements[b] = d;
+                }
+            }
+            if (!placed) {
+                ENG_THROW("Cannot build the symbol table perfect hash (%u symbols)", n);
+            }
+        }
+
+        header->count = n;
+        header->bucketCount = buckets;
+        header->slotMask = slots - 1;
+    }
+
+    void SymbolTable::bind(const void* base) noexcept {
+        const char* bytes = static_cast<const char*>(base);
+        mHeader = reinterpret_cast<const SymbolTableHeader*>(bytes);
+        const SymbolTableLayout l = layoutOf(mHeader->count, mHeader->bucketCount, mHeader->slotMask + 1);
+        mDisplacements = reinterpret_cast<const uint32_t*>(bytes + l.displacements);
+        mSlots = reinterpret_cast<const uint32_t*>(bytes + l.slots);
+        mEntries = reinterpret_cast<const SymbolEntry*>(bytes + l.entries);
+    }
+
+    void SymbolTable::reset() noexcept {
+        if (mMappedSize) {
+            ::munmap(const_cast<SymbolTableHeader*>(mHeader), mMappedSize);
+        }
+        mPrivate.reset();
+        mHeader = nullptr;
+        mDisplacements = mSlots = nullptr;
+        mEntries = nullptr;
+        mMappedSize = 0;
+    }
+
+    SymbolTable::SymbolTable(const std::vector<std::string>& symbols) {
+        uint32_t buckets, slots;
+        layout(symbols, buckets, slots);
+        const size_t size = layoutOf(static_cast<uint32_t>(symbols.size()), buckets, slots).size;
+        mPrivate.reset(new uint64_t[(size + 7) / 8]());
+        build(mPrivate.get(), symbols, buckets, slots);
+        bind(mPrivate.get());
+    }
+
+    SymbolTable SymbolTable::publish(const Core::String& name, const std::vector<std::string>& symbols) {
+        uint32_t buckets, slots;
+        layout(symbols, buckets, slots);
+        size_t size = layoutOf(static_cast<uint32_t>(symbols.size()), buckets, slots).size;
+        int fd;
+        void* base = mapSegment(name, size, true, true, fd);
+        ::close(fd);
+        try {
+            build(base, symbols, buckets, slots);
+        } catch (...) {
+            ::munmap(base, size);
+            ::shm_unlink(name.get());
+            throw;
+        }
+
+        auto* header = static_cast<SymbolTableHeader*>(base);
+        std::strncpy(header->uuid, publishSession("/" + name).get(), sizeof(header->uuid) - 1);
+        // Signature last: readers reject the segment until it is complete
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        std::strncpy(header->signature, SYMBOL_TABLE_MAGIC, sizeof(header->signature) - 1);
+        if (::mprotect(base, size, PROT_READ) != 0) {
+            const int err = errno;
+            ::munmap(base, size);
+            ::shm_unlink(name.get());
+            ENG_THROW_ERRNO(err, "mprotect() failed for symbol table '%s'", name.get());
+        }
+
+        SymbolTable table;
+        table.bind(base);
+        table.mMappedSize = size;
+        return table;
+    }
+
+    SymbolTable SymbolTable::open(const Core::String& name) {
+        size_t size = 0;
+        int fd;
+        void* base = mapSegment(name, size, false, false, fd);
+        ::close(fd);
+
+        const auto* header = static_cast<const SymbolTableHeader*>(base);
+        const bool valid = size >= sizeof(SymbolTableHeader)
+            && std::strncmp(header->signature, SYMBOL_TABLE_MAGIC, sizeof(header->signature)) == 0
+            && header->bucketCount > 0 && std::has_single_bit(header->slotMask + 1)
+            && size >= layoutOf(header->count, header->bucketCount, header->slotMask + 1).size;
+        if (!valid) {
+            ::munmap(base, size);
+            ENG_THROW("'%s' is not a symbol table", name.get());
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        try {
+            checkSession("/" + name, header->uuid);
+        } catch (...) {
+            ::munmap(base, size);
+            throw;
+        }
+
+        SymbolTable table;
+        table.bind(base);
+        table.mMappedSize = size;
+        return table;
+    }
+
+    SymbolTable::SymbolTable(SymbolTable&& other) noexcept
+        : mHeader(other.mHeader), mDisplacements(other.mDisplacements), mSlots(other.mSlots),
+          mEntries(other.mEntries), mPrivate(std::move(other.mPrivate)), mMappedSize(other.mMappedSize) {
+        other.mHeader = nullptr;
+        other.mMappedSize = 0;
+    }
+
+    SymbolTable& SymbolTable::operator=(SymbolTable&& other) noexcept {
+        if (this != &other) {
+            reset();
+            mHeader = other.mHeader;
+            mDisplacements = other.mDisplacements;
+            mSlots = other.mSlots;
+            mEntries = other.mEntries;
+            mPrivate = std::move(other.mPrivate);
+            mMappedSize = other.mMappedSize;
+            other.mHeader = nullptr;
+            other.mMappedSize = 0;
+        }
+        return *this;
+    }
+
+    SymbolTable::~SymbolTable() {
+        reset();
+    }
+
+} // namespace Exchange::Ipc
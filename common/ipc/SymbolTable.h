@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "const.h"
+#include "String.h"
+
+namespace Exchange::Ipc {
+
+    static constexpr const char* SYMBOL_TABLE_MAGIC = "EXCHANGE_SYMBOLS_V1";
+    static constexpr const char* SYMBOL_TABLE_SEGMENT = "EXCHANGE_SYMBOLS";
+
+    /** @brief Longest ticker the table accepts. */
+    constexpr size_t MAX_SYMBOL_LEN = 16;
+
+    struct SymbolEntry {
+        char name[MAX_SYMBOL_LEN];  // Not null-terminated when full
+        uint32_t len;
+    };
+
+    // [ SymbolTableHeader ][ displacement per bucket ][ id per slot ][ SymbolEntry per id ]
+    struct SymbolTableHeader {
+        char signature[32];     // Written last, once the table is complete
+        char uuid[37];          // Session of the publisher
+        uint32_t count;         // Symbols, ids are [0, count)
+        uint32_t bucketCount;
+        uint32_t slotMask;      // Slots - 1, a power of two minus one
+    };
+
+    /**
+     * @class SymbolTable
+     * @brief Read-only directory of the traded instruments: ticker <-> dense id, the
+     * position of the ticker in the <Symbols> configuration.
+     *
+     * @details
+     * Lookups use a perfect hash (hash and displace): the ticker hash picks
+     * a bucket, the bucket's displacement picks the one slot the ticker can be in, and a
+     * single comparison tells whether it is there. No probing and no allocation, so the
+     * gateway resolves tag 55 once per order and only the id travels downstream.
+     *
+     * The gateway builds the table from the configuration and publishes it in the
+     * SYMBOL_TABLE_SEGMENT shared memory segment (publish()), sealed read-only; other
+     * processes map it read-only (open()). A table built in process memory (constructor)
+     * from the same list assigns the same ids.
+     */
+    class SymbolTable {
+        const SymbolTableHeader* mHeader{nullptr};
+        const uint32_t* mDisplacements{nullptr};
+        const uint32_t* mSlots{nullptr};
+        const SymbolEntry* mEntries{nullptr};
+        std::unique_ptr<uint64_t[]> mPrivate;   ///> Storage of a table built in process memory
+        size_t mMappedSize{0};                  ///> Size of the shared mapping, 0 if not mapped
+
+        static uint64_t hash(std::string_view symbol) noexcept {
+            uint64_t h = 1469598103934665603ULL;
+            for (char c : symbol) {
+                h ^= static_cast<uint8_t>(c);
+                h *= 1099511628211ULL;
+            }
+            return h;
+        }
+
+        /** @brief Slot of a ticker hash under displacement `d` (splitmix64 finaliser). */
+        static uint32_t slotOf(uint64_t h, uint32_t d, uint32_t mask) noexcept {
+            h ^= (static_cast<uint64_t>(d) + 1) * 0x9E3779B97F4A7C15ULL;
+            h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+            return static_cast<uint32_t>(h ^ (h >> 31)) & mask;
+        }
+
+        static void layout(const std::vector<std::string>& symbols, uint32_t& buckets, uint32_t& slots);
+        static void build(void* base, const std::vector<std::string>& symbols, uint32_t buckets, uint32_t slots);
+        void bind(const void* base) noexcept;
+        void reset() noexcept;
+
+    public:
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        /** @brief Empty table: every lookup fails. */
+        SymbolTable() = default;
+
+        /**
+         * @brief Builds the table in process memory.
+         * @throws EngException On an empty, too long or duplicate ticker.
+         */
+        explicit SymbolTable(const std::vector<std::string>& symbols);
+
+        /** @brief Builds the table in the shared memory segment `name`, then seals it read-only. */
+        static SymbolTable publish(const Core::String& name, const std::vector<std::string>& symbols);
+
+        /** @brief Maps the table published as `name`, throws if absent, invalid or stale. */
+        static SymbolTable open(const Core::String& name);
+
+        SymbolTable(SymbolTable&& other) noexcept;
+        SymbolTable& operator=(SymbolTable&& other) noexcept;
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        ~SymbolTable();
+
+        /** @return Id of `symbol`, NONE if it is not traded. */
+        uint32_t find(std::string_view symbol) const noexcept {
+            if (!mHeader || symbol.size() > MAX_SYMBOL_LEN) {
+                return NONE;
+            }
+            const uint64_t h = hash(symbol);
+            const uint32_t d = mDisplacements[static_cast<uint32_t>(h >> 32) % mHeader->bucketCount];
+            const uint32_t id = mSlots[slotOf(h, d, mHeader->slotMask)];
+            if (id == NONE) {
+                return NONE;
+            }
+            const SymbolEntry& e = mEntries[id];
+            return e.len == symbol.size() && std::memcmp(e.name, symbol.data(), e.len) == 0 ? id : NONE;
+        }
+
+        /** @brief Ticker of `id`, which must be below size(). */
+        std::string_view name(uint32_t id) const noexcept {
+            return std::string_view(mEntries[id].name, mEntries[id].len);
+        }
+
+        uint32_t size() const noexcept { return mHeader ? mHeader->count : 0; }
+        bool empty() const noexcept { return size() == 0; }
+    };
+
+} // namespace Exchange::Ipc
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory_resource>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -8,6 +9,7 @@
 #include <stdexcept>
 #include <optional>
 #include "enum.h"
+#include "Clock/TscClock.h"
 #include <iostream>
 
 // On-wire structs (packed)
@@ -19,11 +21,12 @@
 // [ MsgHeader ][ FieldHeader + value ][ FieldHeader + value ] ...
 // ONE Message contains MANY fields
 // ┌──────────────────────────┐
-// │ MsgHeader                │ 16 bytes
+// │ MsgHeader                │ 24 bytes
 // │  MsgType = NEW_ORDER     │
 // │  fieldCount = 5          │ (after finalize())
 // │  length = XXX            │ (sum of all field sections)
 // │  seqNo = 0               │ (Sequencer sets later)
+// │  timestamp = ns          │ (Gateway receive time)
 // └──────────────────────────┘
 
 // ┌──────────────────────────┐
@@ -57,6 +60,16 @@ namespace Exchange::Ipc::Msg {
         uint16_t fieldCount;  // number of KV fields
         uint32_t length;      // bytes of all fields (not including this header)
         uint64_t seqNo;       // global sequence, -1 if unset
+        uint64_t timestamp;   // ns since epoch (TscClock) the gateway received the request, 0 if unset
+    };
+
+    /**
+     * @struct LatencyTrace
+     * @brief Value of FIELD_TRACE: ns since epoch (TscClock) at which each TraceStage
+     * was reached, 0 for stages not (yet) stamped.
+     */
+    struct LatencyTrace {
+        uint64_t ns[static_cast<size_t>(TraceStage::COUNT)];
     };
 
     struct FieldHeader {
@@ -79,18 +92,37 @@ namespace Exchange::Ipc::Msg {
     * msg.addUint64(FieldId::FIELD_QTY, 100);
     * msg.finalize();
     * ```
+    * The fields live on the heap by default. Messages of a batch can take them from an
+    * arena instead (see Memory/MemoryResource.h): IpcMessage is allocator-aware, so a
+    * std::pmr::vector<IpcMessage> hands its resource to every element.
     */
     class IpcMessage {
 
     public:
+        using allocator_type = std::pmr::polymorphic_allocator<uint8_t>;
 
         MsgHeader header{};
 
-        std::vector<uint8_t> fields; // encoded (FieldHeader + value blobs)
+        std::pmr::vector<uint8_t> fields; // encoded (FieldHeader + value blobs)
         IpcMessage() {
             clear();
         }
 
+        explicit IpcMessage(const allocator_type& alloc) : fields(alloc) {
+            clear();
+        }
+
+        IpcMessage(const IpcMessage&) = default;
+        IpcMessage(IpcMessage&&) = default;
+        IpcMessage& operator=(const IpcMessage&) = default;
+        IpcMessage& operator=(IpcMessage&&) = default;
+
+        IpcMessage(const IpcMessage& other, const allocator_type& alloc)
+            : header(other.header), fields(other.fields, alloc) {}
+
+        IpcMessage(IpcMessage&& other, const allocator_type& alloc)
+            : header(other.header), fields(std::move(other.fields), alloc) {}
+
         void clear() {
             // fills the entire header struct with zeros — byte-by-byte.
             std::memset(&header, 0, sizeof(header)); 
@@ -132,6 +164,36 @@ namespace Exchange::Ipc::Msg {
             appendBytes(data, len);
         }
 
+        /** @brief Adds an empty FIELD_TRACE, making the message a sampled one. */
+        void addTrace() {
+            const LatencyTrace trace{};
+            addBytes(static_cast<uint16_t>(FieldId::FIELD_TRACE), &trace, sizeof(trace));
+        }
+
+        /**
+         * @brief Stamps `stage` in place in the FIELD_TRACE of the message (decoded or
+         * encoded buffers are not touched, re-encode to forward it).
+         * @return false if the message is not traced.
+         */
+        bool markStage(TraceStage stage, uint64_t ns = Core::TscClock::now()) {
+            const uint8_t* val;
+            uint32_t len;
+            if (!findFieldRaw(static_cast<uint16_t>(FieldId::FIELD_TRACE), FieldType::BYTES, &val, &len)
+                || len != sizeof(LatencyTrace)) {
+                return false;
+            }
+            uint8_t* slot = const_cast<uint8_t*>(val) + static_cast<size_t>(stage) * sizeof(uint64_t);
+            std::memcpy(slot, &ns, sizeof(ns));
+            return true;
+        }
+
+        std::optional<LatencyTrace> getTrace() const {
+            LatencyTrace trace;
+            if (findField(static_cast<uint16_t>(FieldId::FIELD_TRACE), FieldType::BYTES, &trace, sizeof(trace)))
+                return trace;
+            return std::nullopt;
+        }
+
         /**
          * @brief Finalizes the message by updating the header with the correct field count and length.
          * This method scans through the added fields to count them and calculate the total length.
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "XMLNode.h"
+#include "Logger/Config.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class LoggingConfig
+     * @brief Optional <Logging> section of a process node: the runtime minimum level of
+     * each module and the appenders. Without <Appenders> the console is kept.
+     *
+     * @code
+     * <Logging>
+     *     <Levels>
+     *         <Gateway>INFO</Gateway>
+     *         <Ipc>WARNING</Ipc>
+     *     </Levels>
+     *     <Appenders>
+     *         <Console><MinLevel>INFO</MinLevel></Console>
+     *         <File>
+     *             <Path>./logs</Path> <Name>gateway</Name>
+     *             <MaxBytes>67108864</MaxBytes> <RotateSeconds>86400</RotateSeconds> <KeepFiles>5</KeepFiles>
+     *         </File>
+     *         <Database><File>./logs/gateway.db</File><Table>logs</Table></Database>
+     *     </Appenders>
+     * </Logging>
+     * @endcode
+     * MinLevel is optional for every appender and adds a LevelFilter.
+     */
+    class LoggingConfig : public XMLNode {
+        static LogLevel parseLevel(const char* text, const char* where) {
+            LogLevel level;
+            if (!text || !LogHelper::levelFromString(text, level)) {
+                ENG_THROW("Invalid log level for <Logging> <%s>", where);
+            }
+            return level;
+        }
+
+        static const char* text(const tinyxml2::XMLElement* e, const char* child, const char* fallback) {
+            const tinyxml2::XMLElement* c = e->FirstChildElement(child);
+            return (c && c->GetText()) ? c->GetText() : fallback;
+        }
+
+        static void addAppender(Config& config, const tinyxml2::XMLElement* e) {
+            const std::string type = e->Name();
+            std::shared_ptr<IAppender> appender;
+            if (type == "Console") {
+                appender = std::make_shared<ConsoleAppender>();
+            }
+            else if (type == "File") {
+                auto file = std::make_shared<FileAppender>(text(e, "Path", "."), text(e, "Name", "exchange"),
+                    std::stoull(text(e, "MaxBytes", "0")), std::stoul(text(e, "RotateSeconds", "0")),
+                    std::stoul(text(e, "KeepFiles", "5")));
+                if (file->error() != 0) {
+                    ENG_THROW_ERRNO(file->error(), "Cannot open log file '%s'", file->file().c_str());
+                }
+                appender = file;
+            }
+            else if (type == "Database") {
+                auto db = std::make_shared<DatabaseAppender>(text(e, "File", "exchange_logs.db"), text(e, "Table", "logs"));
+                if (!db->error().empty()) {
+                    ENG_THROW("Cannot open log database: %s", db->error().c_str());
+                }
+                appender = db;
+            }
+            else {
+                ENG_THROW("Unknown <Logging> appender <%s>", e->Name());
+            }
+
+            std::vector<std::shared_ptr<IFilter>> filters;
+            if (const char* minLevel = text(e, "MinLevel", nullptr)) {
+                filters.push_back(std::make_shared<LevelFilter>(parseLevel(minLevel, e->Name())));
+            }
+            config.addAppender(std::move(appender), std::move(filters));
+        }
+
+    public:
+        explicit LoggingConfig(const tinyxml2::XMLElement* processNode)
+            : XMLNode(processNode ? processNode->FirstChildElement("Logging") : nullptr) {}
+
+        /** @brief Builds the logger configuration, throws on an unknown module, level or appender. */
+        Config config() const {
+            Config config;
+            if (!isValid()) {
+                return config;
+            }
+            if (auto* levels = mElement->FirstChildElement("Levels")) {
+                for (auto* e = levels->FirstChildElement(); e; e = e->NextSiblingElement()) {
+                    LogModule module;
+                    if (!LogHelper::moduleFromString(e->Name(), module)) {
+                        ENG_THROW("Unknown <Logging> module <%s>", e->Name());
+                    }
+                    config.setLevel(module, parseLevel(e->GetText(), e->Name()));
+                }
+            }
+            if (auto* appenders = mElement->FirstChildElement("Appenders")) {
+                for (auto* e = appenders->FirstChildElement(); e; e = e->NextSiblingElement()) {
+                    addAppender(config, e);
+                }
+            }
+            return config;
+        }
+
+        /** @brief Reads the section and applies it to the logger. */
+        static void apply(const tinyxml2::XMLElement* processNode) {
+            LoggingConfig(processNode).config().apply();
+        }
+    };
+} // namespace Exchange::Core
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "XMLNode.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class SymbolsConfig
+     * @brief <Symbols> section of the root node: the traded instruments, shared by every
+     * process. A symbol's id is its position in the list (see Ipc::SymbolTable).
+     *
+     * @code
+     * <Symbols>
+     *     <Symbol>AAPL</Symbol>
+     *     <Symbol>MSFT</Symbol>
+     * </Symbols>
+     * @endcode
+     */
+    class SymbolsConfig : public XMLNode {
+    public:
+        explicit SymbolsConfig(const tinyxml2::XMLElement* symbolsNode) : XMLNode(symbolsNode) {}
+
+        /** @throws EngException On an empty <Symbol> element. */
+        std::vector<std::string> symbols() const {
+            std::vector<std::string> out;
+            if (!isValid()) {
+                return out;
+            }
+            for (const tinyxml2::XMLElement* e = mElement->FirstChildElement("Symbol"); e;
+                 e = e->NextSiblingElement("Symbol")) {
+                if (!e->GetText()) {
+                    ENG_THROW("Empty <Symbol> element in <Symbols>");
+                }
+                out.emplace_back(e->GetText());
+            }
+            return out;
+        }
+    };
+} // namespace Exchange::Core
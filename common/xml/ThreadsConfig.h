@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#include "XMLNode.h"
+#include "Scheduler/Worker/WorkerSpec.h"
+
+namespace Exchange::Core {
+
+    /**
+     * @class ThreadsConfig
+     * @brief Optional <Threads> section of a process node: where each hot thread runs.
+     *
+     * @code
+     * <Threads>
+     *     <Listener>
+     *         <Cpus>2</Cpus>               <!-- kernel list format: "2", "4-5,7" -->
+     *         <Priority>80</Priority>      <!-- SCHED_FIFO 1..99, 0 = normal -->
+     *         <Isolated>true</Isolated>    <!-- warn if the CPUs are not in isolcpus -->
+     *         <Name>gw-listener</Name>
+     *     </Listener>
+     * </Threads>
+     * @endcode
+     * Every element is optional; a thread without an entry keeps the default spec (any
+     * CPU, normal priority) under the name its process gives it.
+     */
+    class ThreadsConfig : public XMLNode {
+        static const char* text(const tinyxml2::XMLElement* e, const char* child) {
+            const tinyxml2::XMLElement* c = e->FirstChildElement(child);
+            return (c && c->GetText()) ? c->GetText() : nullptr;
+        }
+
+    public:
+        explicit ThreadsConfig(const tinyxml2::XMLElement* processNode)
+            : XMLNode(processNode ? processNode->FirstChildElement("Threads") : nullptr) {}
+
+        /**
+         * @brief Spec of the thread `role`.
+         * @param defaultName Thread name used when the entry has no <Name>.
+         * @throws EngException on an invalid CPU list, priority or flag.
+         */
+        WorkerSpec spec(const char* role, const char* defaultName) const {
+            WorkerSpec spec;
+            spec.name = defaultName;
+            const tinyxml2::XMLElement* e = isValid() ? mElement->FirstChildElement(role) : nullptr;
+            if (!e) {
+                return spec;
+            }
+            if (const char* cpus = text(e, "Cpus")) {
+                spec.cpus = WorkerSpec::parseCpuList(cpus);
+            }
+            if (const char* priority = text(e, "Priority")) {
+                char* end;
+                const long value = std::strtol(priority, &end, 10);
+                if (*end != '\0' || value < 0 || value > 99) {
+                    ENG_THROW("Invalid <Threads> <%s> <Priority> '%s', expected 0..99", role, priority);
+                }
+                spec.priority = static_cast<int>(value);
+            }
+            if (const char* isolated = text(e, "Isolated")) {
+                if (std::strcmp(isolated, "true") != 0 && std::strcmp(isolated, "false") != 0) {
+                    ENG_THROW("Invalid <Threads> <%s> <Isolated> '%s', expected true or false", role, isolated);
+                }
+                spec.isolated = std::strcmp(isolated, "true") == 0;
+            }
+            if (const char* name = text(e, "Name")) {
+                spec.name = name;
+            }
+            return spec;
+        }
+    };
+} // namespace Exchange::Core
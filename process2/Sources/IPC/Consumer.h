@@ -1,42 +1,119 @@
 #pragma once
 
+#include <chrono>
+#include <memory_resource>
+#include <thread>
+
 #include "SharedMemory.h"
 #include "Config/Config.h"
 #include "messaging.h"
+#include "Memory/MemoryResource.h"
+#include "Metrics/LatencyTracer.h"
 namespace Exchange::Sequencer::Ipc {
-    
+
     /**
      * @class Consumer
-     * @brief Consumer for reading order messages from the Gateway process via 
-     * shared memory queue.
+     * @brief Sequencer loop: reads order messages from the Gateway process via shared
+     * memory, gives each one the next sequence number and forwards it to the matching
+     * engine's queue.
+     *
+     * @details
+     * Sequence numbers start at 1 and have no gaps: a message is never dropped once
+     * numbered, the loop waits for room in the engine queue instead. Undecodable
+     * messages are counted and dropped before they get a number.
+     *
+     * poll() works by batch: it first drains a burst of the gateway queue, decoding
+     * every message into a batch allocated from an arena, so the gateway gets its slots
+     * back before the slower encode/forward half runs. The arena is reset after each
+     * batch and keeps its memory: the batch costs no malloc once the largest burst has
+     * been seen.
      */
     class Consumer {
 
         // Provides read-only access to the shared memory queue in which gateway
         // process sends messages
         Exchange::Ipc::Consumer mFromGatewayQueue;
+        // Created here: the matching engine attaches to it
+        Exchange::Ipc::Producer mToEngineQueue;
+
+        uint64_t mSeqNo{0};                         ///> Last sequence number assigned
+        std::vector<uint8_t> mBuf = std::vector<uint8_t>(Exchange::Ipc::MAX_MSG_SIZE);
+        Core::ScopedArena mBatchArena;              ///> Decoded messages of the current batch
+        std::vector<uint8_t> mEncoded;              ///> Sequenced message, keeps its capacity
+
+        Core::Counter mReceived{"sequencer.messages"};
+        Core::Counter mUndecodable{"sequencer.decode_errors"};
+        Core::Counter mEngineFull{"sequencer.engine_full"};   ///> Writes retried, engine queue full
+        Core::Gauge mDepth{"sequencer.inbound_depth"};
 
     public:
-        /** @brief Constructor */
-        Consumer(): mFromGatewayQueue(Config::instance().IPC_QUEUE_GATEWAY, 4096) {}
+        /** Read at most this many messages per poll(), so pollDump() is served under load */
+        static constexpr size_t MAX_BATCH = 64;
+
+        /** @brief Constructor, throws if the gateway has not created its queue yet */
+        Consumer():
+            mFromGatewayQueue(Config::instance().IPC_QUEUE_GATEWAY, 4096),
+            mToEngineQueue(Config::instance().IPC_QUEUE_ENGINE, 4096) {}
+
+        /**
+         * @brief Sequences and forwards the messages waiting in the gateway queue.
+         * @return Number of messages forwarded, 0 if the queue was empty.
+         */
+        size_t poll() {
+            auto reset = mBatchArena.scope();
+            std::pmr::vector<Exchange::Ipc::Msg::IpcMessage> batch(mBatchArena.resource());
+            batch.reserve(MAX_BATCH);
+            while (batch.size() < MAX_BATCH) {
+                const uint32_t n = mFromGatewayQueue.read(mBuf.data(), static_cast<uint32_t>(mBuf.size()));
+                if (n == 0) {
+                    break;
+                }
+                mDepth.set(mFromGatewayQueue.depth());
+                if (!Exchange::Ipc::Msg::IpcMessage::decode(mBuf.data(), n, batch.emplace_back())) {
+                    mUndecodable.add();
+                    batch.pop_back();
+                    continue;
+                }
+                mReceived.add();
+            }
+            for (Exchange::Ipc::Msg::IpcMessage& msg : batch) {
+                forward(msg);
+            }
+            return batch.size();
+        }
 
         void run() {
-            std::vector<uint8_t> buf(Exchange::Ipc::MAX_MSG_SIZE);
+            Core::LatencyTracer& tracer = Core::LatencyTracer::instance();
             while (true) {
-                uint32_t n = mFromGatewayQueue.read(buf.data(), static_cast<uint32_t>(buf.size()));
-                if (n == 0) {
+                tracer.pollDump();
+                if (poll() == 0) {
                     // no message -- sleep/yield or continue polling
                     std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                    continue;
                 }
-                Exchange::Ipc::Msg::IpcMessage msg;
-                if (!Exchange::Ipc::Msg::IpcMessage::decode(buf.data(), n, msg)) {
-                    // handle decode error
-                    continue;
+            }
+        }
+
+        uint64_t lastSeqNo() const noexcept { return mSeqNo; }
+
+    private:
+        /** @brief Numbers `msg`, stamps its trace and writes it to the engine queue. */
+        void forward(Exchange::Ipc::Msg::IpcMessage& msg) {
+            const uint64_t now = Core::TscClock::now();
+            LOG_DEBUG("Message received MsgType=%u Transit=%ldns",
+                msg.header.MsgType, static_cast<int64_t>(now - msg.header.timestamp));
+            msg.setSeqNo(++mSeqNo);
+            if (msg.markStage(Exchange::Ipc::Msg::TraceStage::SEQUENCER_READ, now)) {
+                Core::LatencyTracer::instance().record(*msg.getTrace(),
+                    Exchange::Ipc::Msg::TraceStage::SEQUENCER_READ, Exchange::Ipc::Msg::TraceStage::SEQUENCER_READ);
+            }
+            msg.encode(mEncoded);
+            if (!mToEngineQueue.write(mEncoded.data(), static_cast<uint32_t>(mEncoded.size()))) {
+                mEngineFull.add();
+                while (!mToEngineQueue.write(mEncoded.data(), static_cast<uint32_t>(mEncoded.size()))) {
+                    std::this_thread::yield();
                 }
-                std::cout<<"Message received"<<std::endl;
             }
         }
     }; // class Consumer
 
-} // namespace Exchange::Sequencer::Ipc
\ No newline at end of file
+} // namespace Exchange::Sequencer::Ipc
@@ -9,6 +9,8 @@
 #include "Exception.h"
 #include "ipc/SharedMemory.h"
 #include "Config/Config.h"
+#include "LoggingConfig.h"
+#include "ThreadsConfig.h"
 #include "IPC/Consumer.h"
 
 int main(int argc, char* argv[]) {
@@ -20,14 +22,19 @@ int main(int argc, char* argv[]) {
     }
 
     try {
+        Exchange::Core::TscClock::calibrate();
         Exchange::Core::XMLReader reader("../config.xml");
         Exchange::Sequencer::Config::init(reader.getNode("Sequencer"));
+        Exchange::Core::LoggingConfig::apply(reader.getNode("Sequencer"));
+        Exchange::Core::MetricsRegistry::init("Sequencer");
+        Exchange::Core::LatencyTracer::installSignal();
         std::cout<<Exchange::Sequencer::Config::instance().PORT<<std::endl;
         std::cout<<Exchange::Sequencer::Config::instance().BLOCKING_QUEUE_SIZE<<std::endl;
         std::cout<<Exchange::Sequencer::Config::instance().IPC_QUEUE_GATEWAY.toString()<<std::endl;
         std::cout<<Exchange::Sequencer::Config::instance().IPC_QUEUE_ENGINE.toString()<<std::endl;
         std::cout << "[Consumer] Launching consumer... \n";
         Exchange::Sequencer::Ipc::Consumer sequencerConsumer;
+        Exchange::Core::ThreadsConfig(reader.getNode("Sequencer")).spec("Consumer", "seq-consumer").apply();
         sequencerConsumer.run();
         // // Attempt to Connect
         // // This will THROW if the Producer hasn't started yet (shm_open fails)
@@ -6,7 +6,7 @@ OS="$(uname)"
 if [[ "$OS" == "Darwin" ]]; then
   # macOS (Homebrew)
   if command -v brew >/dev/null 2>&1; then
-    brew install tinyxml2
+    brew install tinyxml2 sqlite
   else
     echo "Homebrew not found. Install Homebrew or use CMake FetchContent."
     exit 1
@@ -14,5 +14,5 @@ if [[ "$OS" == "Darwin" ]]; then
 else
   # assume Debian/Ubuntu
   sudo apt-get update
-  sudo apt-get install -y libtinyxml2-dev
+  sudo apt-get install -y libtinyxml2-dev libsqlite3-dev
 fi
\ No newline at end of file
@@ -325,13 +325,69 @@ bool TEST3_producerCrashRecovery() {
     }
 }
 
+/**
+ * @brief Test 4: Ring occupancy and backpressure telemetry
+ * 
+ * GIVEN: A producer on a 64 slot ring that nobody drains
+ * WHEN:  It writes until a write is refused, then the consumer frees one slot
+ *        and the producer writes again
+ * THEN:  
+ *   - highWater reaches the capacity, the refused writes of one stall are one full event
+ *   - The accepted write closes the stall and adds its duration to stallNs
+ *   - The consumer sees the same telemetry as the producer
+ */
+bool TEST4_ringTelemetry() {
+    log("TEST 4", "Testing ring telemetry...", CYAN);
+    
+    const std::string queueName = "test_queue_stats";
+    
+    try {
+        Producer producer(queueName, 64);
+        Consumer consumer(queueName, 64);
+        
+        const uint8_t payload[16] = {};
+        uint32_t written = 0;
+        while (producer.write(payload, sizeof(payload))) {
+            written++;
+        }
+        producer.write(payload, sizeof(payload));
+        
+        RingStats full = producer.stats();
+        if (written != 64 || full.depth != 64 || full.highWater != 64 || full.fullEvents != 1 || full.stallNs != 0) {
+            log("TEST 4", "FAILED - Unexpected stats on a full ring", RED);
+            return false;
+        }
+        
+        uint8_t buffer[4096];
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (consumer.read(buffer, sizeof(buffer)) == 0 || !producer.write(payload, sizeof(payload))) {
+            log("TEST 4", "FAILED - Ring did not accept a write after a read", RED);
+            return false;
+        }
+        
+        RingStats after = consumer.stats();
+        if (after.depth != 64 || after.capacity != 64 || after.fullEvents != 1 || after.stallNs < 1000000) {
+            log("TEST 4", "FAILED - Stall not accounted, stallNs=" + std::to_string(after.stallNs), RED);
+            return false;
+        }
+        
+        log("TEST 4", "PASSED - highWater=" + std::to_string(after.highWater) + " fullEvents="
+            + std::to_string(after.fullEvents) + " stallNs=" + std::to_string(after.stallNs), GREEN);
+        return true;
+        
+    } catch (const std::exception& e) {
+        log("TEST 4", std::string("FAILED - ") + e.what(), RED);
+        return false;
+    }
+}
+
 int main() {
     std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
     std::cout << MAGENTA << "  IPC Queue Connection & Crash Recovery" << RESET << std::endl;
     std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
     
     int passed = 0;
-    int total = 3;
+    int total = 4;
     
     // Test 1: Same queue connection
     if (TEST1_sameQueueConnection()) {
@@ -351,6 +407,12 @@ int main() {
     }
     std::cout << std::endl;
     
+    // Test 4: Ring telemetry
+    if (TEST4_ringTelemetry()) {
+        passed++;
+    }
+    std::cout << std::endl;
+    
     // Summary
     std::cout << MAGENTA << "========================================" << RESET << std::endl;
     std::cout << "Test Results: " << (passed == total ? GREEN : RED) 
@@ -0,0 +1,425 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Config.h"
+#include "Logger.h"
+
+using namespace Exchange;
+using namespace Exchange::Core;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+// Sends the logger output (stdout) to a file for the duration of a test
+class StdoutCapture {
+    int mSaved;
+    std::string mPath;
+public:
+    explicit StdoutCapture(std::string path) : mPath(std::move(path)) {
+        std::cout.flush();
+        std::fflush(stdout);
+        mSaved = dup(STDOUT_FILENO);
+        int fd = open(mPath.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+        dup2(fd, STDOUT_FILENO);
+        close(fd);
+    }
+    ~StdoutCapture() { restore(); }
+    void restore() {
+        if (mSaved < 0) return;
+        Logger::flush();
+        std::fflush(stdout);
+        dup2(mSaved, STDOUT_FILENO);
+        close(mSaved);
+        mSaved = -1;
+    }
+    std::vector<std::string> lines() const {
+        std::vector<std::string> out;
+        std::ifstream in(mPath);
+        for (std::string l; std::getline(in, l);) out.push_back(l);
+        return out;
+    }
+};
+
+/**
+ * @brief Test 1: Deferred formatting
+ *
+ * GIVEN: A record captured with strings, signed/unsigned integers and a double
+ * WHEN:  It is formatted later, after the original string arguments are gone
+ * THEN:
+ *   - The message matches printf output
+ *   - Mismatched length modifiers (%d for 64 bit, %ls for narrow) are rendered correctly
+ */
+bool TEST1_deferredFormatting() {
+    log("TEST 1", "Testing deferred printf formatting...", CYAN);
+
+    static const LogSite site{"Order %s side=%ls qty=%d id=%lu px=%.2f pct=%5.1f%% %x",
+        __FILE__, __func__, __LINE__, LogLevel::INFO, LogSite::nextId()};
+    LogRecord r{};
+    r.site = &site;
+    {
+        std::string symbol = "AAPL";
+        String side("BUY");
+        LogArgWriter w(r);
+        w.add(symbol);
+        w.add(side);
+        w.add(int64_t{-42});
+        w.add(uint64_t{18000000000ULL});
+        w.add(101.256);
+        w.add(12.34f);
+        w.add(255u);
+        w.finish();
+    }
+
+    char out[256];
+    LogFormatter::format(r, out, sizeof(out));
+    const std::string expected = "Order AAPL side=BUY qty=-42 id=18000000000 px=101.26 pct= 12.3% ff";
+    if (expected != out) {
+        log("TEST 1", std::string("FAILED - Got '") + out + "'", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - Deferred formatting matches printf", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Asynchronous multi-threaded logging
+ *
+ * GIVEN: Four threads logging concurrently through LOG_INFO
+ * WHEN:  The logger is flushed
+ * THEN:
+ *   - Every record is written exactly once, as one complete line
+ *   - The calling thread cost per LOG_INFO is reported (target: well under 100 ns)
+ */
+bool TEST2_asyncThreads() {
+    log("TEST 2", "Testing asynchronous logging from several threads...", CYAN);
+
+    constexpr int threads = 4;
+    constexpr int perThread = 1000;
+    double nsPerCall = 0;
+    std::vector<std::string> lines;
+    {
+        StdoutCapture capture("/tmp/test_logger_async.log");
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([t, &nsPerCall] {
+                LOG_INFO("async-test warmup thread=%d", t);    // Registers the thread's ring
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < perThread; ++i) {
+                    LOG_INFO("async-test thread=%d seq=%d value=%.3f", t, i, i * 0.5);
+                }
+                auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                if (t == 0) nsPerCall = ns / perThread;
+            });
+        }
+        for (auto& th : pool) th.join();
+        capture.restore();
+        lines = capture.lines();
+    }
+
+    int seen = 0;
+    for (const auto& l : lines) {
+        if (l.find("async-test thread=") != std::string::npos && l.find(" value=") != std::string::npos) seen++;
+    }
+    if (seen != threads * perThread) {
+        log("TEST 2", "FAILED - " + std::to_string(seen) + " of " + std::to_string(threads * perThread)
+            + " records written", RED);
+        return false;
+    }
+
+    log("TEST 2", "PASSED - " + std::to_string(seen) + " records, "
+        + std::to_string(static_cast<int>(nsPerCall)) + " ns per LOG_INFO on the calling thread", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 3: Binary log round trip
+ *
+ * GIVEN: The backend switched to a binary log file
+ * WHEN:  Records from two call sites are logged, then decoded with BinaryLogReader
+ * THEN:
+ *   - Nothing below WARNING is written as text
+ *   - Every record is decoded in order and renders the same message as the text path
+ *   - Each call site is stored once, so a record costs far less than its text line
+ */
+bool TEST3_binaryRoundTrip() {
+    log("TEST 3", "Testing binary log output and decoding...", CYAN);
+
+    const std::string path = "/tmp/test_logger_binary.blog";
+    constexpr int count = 500;
+    std::vector<std::string> text;
+    {
+        StdoutCapture capture("/tmp/test_logger_binary.log");
+        LogBackend::instance().setBinaryOutput(path);
+        for (int i = 0; i < count; ++i) {
+            LOG_INFO("binary-test order=%lu symbol=%s qty=%d", uint64_t{1000} + i, "AAPL", i);
+        }
+        LOG_WARN("binary-test done count=%d", count);
+        Logger::flush();
+        LogBackend::instance().setBinaryOutput("");
+        capture.restore();
+        text = capture.lines();
+    }
+
+    if (text.size() != 1 || text[0].find("binary-test done count=500") == std::string::npos) {
+        log("TEST 3", "FAILED - Expected only the WARNING as text, got " + std::to_string(text.size()) + " lines", RED);
+        return false;
+    }
+
+    BinaryLogReader reader;
+    if (const char* error = reader.open(path)) {
+        log("TEST 3", std::string("FAILED - Cannot open binary log: ") + error, RED);
+        return false;
+    }
+    LogRecord r{};
+    char msg[256];
+    int decoded = 0;
+    while (reader.next(r)) {
+        LogFormatter::format(r, msg, sizeof(msg));
+        const std::string expected = decoded < count
+            ? "binary-test order=" + std::to_string(1000 + decoded) + " symbol=AAPL qty=" + std::to_string(decoded)
+            : "binary-test done count=500";
+        if (expected != msg) {
+            log("TEST 3", "FAILED - Record " + std::to_string(decoded) + " decoded as '" + msg + "'", RED);
+            return false;
+        }
+        decoded++;
+    }
+    if (decoded != count + 1) {
+        log("TEST 3", "FAILED - Decoded " + std::to_string(decoded) + " records", RED);
+        return false;
+    }
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    const long bytes = static_cast<long>(in.tellg());
+    log("TEST 3", "PASSED - " + std::to_string(decoded) + " records decoded, "
+        + std::to_string(bytes / decoded) + " bytes per record", GREEN);
+    return true;
+}
+
+static int gEvaluated = 0;
+static int evaluated() { return ++gEvaluated; }
+
+/**
+ * @brief Test 4: Compile-time and runtime level filtering
+ *
+ * GIVEN: The CORE module set to WARNING at runtime
+ * WHEN:  LOG_INFO / LOG_DEBUG / LOG_TRACE are called with an argument that has a side effect
+ * THEN:
+ *   - The arguments of filtered calls are never evaluated
+ *   - Other modules keep their own level
+ *   - Raising the level again re-enables the call site
+ */
+bool TEST4_levelFiltering() {
+    log("TEST 4", "Testing compile-time and per-module runtime levels...", CYAN);
+
+    std::vector<std::string> text;
+    {
+        StdoutCapture capture("/tmp/test_logger_levels.log");
+        Logger::setLevel(LogModule::CORE, LogLevel::WARNING);
+        for (int i = 0; i < 3; ++i) {
+            LOG_INFO("level-test filtered %d", evaluated());
+            LOG_DEBUG("level-test filtered %d", evaluated());
+            LOG_TRACE("level-test filtered %d", evaluated());
+        }
+        const bool gatewayEnabled = Logger::enabled(LogModule::GATEWAY, LogLevel::INFO);
+        LOG_WARN("level-test kept %d", evaluated());
+        Logger::setLevel(LogModule::CORE, LogLevel::TRACE);
+        LOG_INFO("level-test kept %d", evaluated());
+        capture.restore();
+        text = capture.lines();
+
+        if (!gatewayEnabled) {
+            log("TEST 4", "FAILED - GATEWAY level changed with CORE", RED);
+            return false;
+        }
+    }
+
+    if (gEvaluated != 2 || text.size() != 2) {
+        log("TEST 4", "FAILED - " + std::to_string(gEvaluated) + " arguments evaluated, "
+            + std::to_string(text.size()) + " lines written", RED);
+        return false;
+    }
+
+    log("TEST 4", "PASSED - Filtered calls skip argument evaluation (LOG_MIN_LEVEL="
+        + std::to_string(LOG_MIN_LEVEL) + ")", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 5: File appender with rotation and a filter chain
+ *
+ * GIVEN: A Core::Config with a FileAppender (4 KiB rotation, 2 kept files) behind an
+ *        INFO LevelFilter, installed with addAppender()/apply()
+ * WHEN:  300 INFO lines and 300 DEBUG lines are logged
+ * THEN:
+ *   - The live file and exactly 2 rotated files exist, none above the size limit
+ *   - DEBUG lines were filtered out, the newest INFO line is in the live file
+ *   - The console appender is back after restoring the default configuration
+ */
+bool TEST5_fileAppenderRotation() {
+    log("TEST 5", "Testing FileAppender rotation and filters...", CYAN);
+
+    const std::string dir = "/tmp/test_logger_files";
+    for (const char* f : {"/app.log", "/app.log.1", "/app.log.2", "/app.log.3"}) {
+        std::remove((dir + f).c_str());
+    }
+
+    auto file = std::make_shared<FileAppender>(dir.c_str(), "app", 4096, 0, 2);
+    if (file->error() != 0) {
+        log("TEST 5", std::string("FAILED - Cannot open log file: ") + std::strerror(file->error()), RED);
+        return false;
+    }
+    Config config;
+    config.addAppender(file, std::make_shared<LevelFilter>(LogLevel::INFO));
+    config.apply();
+    for (int i = 0; i < 300; ++i) {
+        LOG_INFO("rotation-test line=%d", i);
+        LOG_DEBUG("rotation-test debug=%d", i);
+    }
+    Logger::flush();
+    LogBackend::instance().setAppenders({});
+    file.reset();
+
+    auto read = [&](const std::string& f, size_t& bytes, int& debug, bool& last) {
+        std::ifstream in(dir + f);
+        if (!in) return false;
+        for (std::string l; std::getline(in, l);) {
+            bytes += l.size() + 1;
+            if (l.find("rotation-test debug=") != std::string::npos) debug++;
+            if (l.find("rotation-test line=299") != std::string::npos) last = true;
+        }
+        return true;
+    };
+    int debug = 0;
+    bool last = false, lastRotated = false;
+    size_t live = 0, r1 = 0, r2 = 0, r3 = 0;
+    const bool ok = read("/app.log", live, debug, last) && read("/app.log.1", r1, debug, lastRotated)
+        && read("/app.log.2", r2, debug, lastRotated) && !read("/app.log.3", r3, debug, lastRotated);
+    if (!ok || debug != 0 || !last || live > 4096 || r1 > 4096 || r2 > 4096) {
+        log("TEST 5", "FAILED - files ok=" + std::to_string(ok) + " debug=" + std::to_string(debug)
+            + " last=" + std::to_string(last) + " sizes=" + std::to_string(live) + "/" + std::to_string(r1)
+            + "/" + std::to_string(r2), RED);
+        return false;
+    }
+
+    std::vector<std::string> console;
+    {
+        StdoutCapture capture("/tmp/test_logger_console.log");
+        LOG_INFO("rotation-test console");
+        capture.restore();
+        console = capture.lines();
+    }
+    if (console.size() != 1) {
+        log("TEST 5", "FAILED - Console appender not restored", RED);
+        return false;
+    }
+
+    log("TEST 5", "PASSED - Rotated at 4 KiB, 2 files kept, DEBUG filtered", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 6: TSC clock and cached date prefix
+ *
+ * GIVEN: The calibrated TscClock
+ * WHEN:  It is compared with CLOCK_REALTIME and read in a tight loop
+ * THEN:
+ *   - It stays within 1 ms of CLOCK_REALTIME and never goes backwards
+ *   - DateCache renders the same date as strftime and only changes on a new second
+ */
+bool TEST6_tscClock() {
+    log("TEST 6", "Testing TscClock against CLOCK_REALTIME...", CYAN);
+
+    const TscClock& clock = TscClock::instance();
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    const int64_t real = static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    const int64_t skew = static_cast<int64_t>(TscClock::now()) - real;
+    if (skew < -1000000 || skew > 1000000) {
+        log("TEST 6", "FAILED - Skew " + std::to_string(skew) + " ns", RED);
+        return false;
+    }
+
+    constexpr int reads = 1000000;
+    uint64_t prev = TscClock::now();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; ++i) {
+        const uint64_t t = TscClock::now();
+        if (t < prev) {
+            log("TEST 6", "FAILED - Clock went backwards", RED);
+            return false;
+        }
+        prev = t;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / reads;
+
+    DateCache dates;
+    const uint64_t t = 1700000000ULL * 1000000000ULL;
+    const std::string a = dates.format(t);
+    const char* b = dates.format(t + 999999999ULL);
+    time_t sec = 1700000000;
+    std::tm tm{};
+    localtime_r(&sec, &tm);
+    char expected[32];
+    std::strftime(expected, sizeof(expected), "%Y-%m-%d %H:%M:%S", &tm);
+    if (a != expected || a != b || a == dates.format(t + 1000000000ULL)) {
+        log("TEST 6", "FAILED - DateCache rendered '" + a + "'", RED);
+        return false;
+    }
+
+    log("TEST 6", std::string("PASSED - ") + (clock.usesTsc() ? "TSC" : "clock_gettime fallback") + ", skew "
+        + std::to_string(skew) + " ns, " + std::to_string(ns).substr(0, 5) + " ns per now()", GREEN);
+    return true;
+}
+
+int main() {
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "            Logger Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 6;
+
+    if (TEST1_deferredFormatting()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_asyncThreads()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_binaryRoundTrip()) passed++;
+    std::cout << std::endl;
+
+    if (TEST4_levelFiltering()) passed++;
+    std::cout << std::endl;
+
+    if (TEST5_fileAppenderRotation()) passed++;
+    std::cout << std::endl;
+
+    if (TEST6_tscClock()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,624 @@
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineCore.h"
+#include "Shard/ShardRouter.h"
+#include "Snapshot/Snapshot.h"
+#include "Scheduler/EngineScheduler.h"
+
+using namespace Exchange;
+using namespace Exchange::Matching;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+static uint64_t gSeq = 1;
+
+OrderRequest makeOrder(uint64_t clientId, uint64_t orderId, Order::Side side, int64_t price, uint64_t qty,
+                       Order::TIF tif = Order::TIF::DAY) {
+    return OrderRequest{gSeq++, clientId, orderId, side, tif, price, qty};
+}
+
+size_t countOf(const Executions& out, ExecType type) {
+    size_t n = 0;
+    for (const auto& e : out) {
+        if (e.type == type) n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Test 1: Price-time priority matching
+ *
+ * GIVEN: Two resting asks at the same price from different clients, and a better ask
+ * WHEN:  An aggressive buy crosses all of them
+ * THEN:
+ *   - The better price trades first, then the older order at the next level
+ *   - The remainder rests on the bid side
+ */
+bool TEST1_priceTimePriority() {
+    log("TEST 1", "Testing price-time priority matching...", CYAN);
+
+    EngineCore core(1024);
+    Executions out;
+
+    core.onNewOrder("AAPL", makeOrder(1, 1, Order::Side::SELL, 1010000, 100), out);
+    core.onNewOrder("AAPL", makeOrder(2, 1, Order::Side::SELL, 1010000, 100), out);
+    core.onNewOrder("AAPL", makeOrder(3, 1, Order::Side::SELL, 1005000, 50), out);
+    out.clear();
+
+    core.onNewOrder("AAPL", makeOrder(9, 1, Order::Side::BUY, 1010000, 200), out);
+
+    std::vector<const Execution*> trades;
+    for (const auto& e : out) {
+        if (e.type == ExecType::TRADE) trades.push_back(&e);
+    }
+    if (trades.size() != 3
+        || trades[0]->contraClientId != 3 || trades[0]->price != 1005000 || trades[0]->qty != 50
+        || trades[1]->contraClientId != 1 || trades[1]->qty != 100
+        || trades[2]->contraClientId != 2 || trades[2]->qty != 50) {
+        log("TEST 1", "FAILED - Unexpected fill sequence", RED);
+        return false;
+    }
+
+    OrderBook* book = core.findBook("AAPL");
+    if (!book->hasAsk() || book->bestAsk() != 1010000 || book->levelQty(Order::Side::SELL, 1010000) != 50) {
+        log("TEST 1", "FAILED - Ask side not left with 50 @ 101.0", RED);
+        return false;
+    }
+    if (book->hasBid()) {
+        log("TEST 1", "FAILED - Fully filled buy should not rest", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - Fills follow price then time priority", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Cancel through the order-id index
+ *
+ * GIVEN: Several resting orders on multiple levels and books
+ * WHEN:  Orders are cancelled by (clientId, orderId) only
+ * THEN:
+ *   - The right order is removed and level quantities are updated
+ *   - Empty levels disappear from the book
+ *   - Cancelling an unknown or already cancelled order is rejected
+ */
+bool TEST2_cancelByIndex() {
+    log("TEST 2", "Testing O(1) cancel through order-id index...", CYAN);
+
+    EngineCore core(1024);
+    Executions out;
+
+    core.onNewOrder("MSFT", makeOrder(1, 10, Order::Side::BUY, 3000000, 100), out);
+    core.onNewOrder("MSFT", makeOrder(1, 11, Order::Side::BUY, 3000000, 200), out);
+    core.onNewOrder("MSFT", makeOrder(1, 12, Order::Side::BUY, 2990000, 300), out);
+    core.onNewOrder("TSLA", makeOrder(1, 13, Order::Side::SELL, 2500000, 10), out);
+    out.clear();
+
+    core.onCancel(gSeq++, 1, 10, out);
+    OrderBook* msft = core.findBook("MSFT");
+    if (countOf(out, ExecType::CANCELLED) != 1 || msft->levelQty(Order::Side::BUY, 3000000) != 200) {
+        log("TEST 2", "FAILED - Cancel did not update level quantity", RED);
+        return false;
+    }
+
+    core.onCancel(gSeq++, 1, 12, out);
+    if (msft->depth(Order::Side::BUY) != 1 || msft->bestBid() != 3000000) {
+        log("TEST 2", "FAILED - Empty level not removed", RED);
+        return false;
+    }
+
+    core.onCancel(gSeq++, 1, 13, out);
+    if (core.findBook("TSLA")->hasAsk()) {
+        log("TEST 2", "FAILED - Cancel routed to the wrong book", RED);
+        return false;
+    }
+
+    out.clear();
+    core.onCancel(gSeq++, 1, 10, out);
+    core.onCancel(gSeq++, 2, 11, out);
+    if (countOf(out, ExecType::REJECTED) != 2 || out[0].reason != RejectReason::UNKNOWN_ORDER) {
+        log("TEST 2", "FAILED - Unknown cancels must be rejected", RED);
+        return false;
+    }
+
+    if (core.context().orders.used() != 1 || core.context().index.size() != 1) {
+        log("TEST 2", "FAILED - Pool/index not released", RED);
+        return false;
+    }
+
+    log("TEST 2", "PASSED - Cancels resolved in O(1) and books kept consistent", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 3: Cancel-replace priority rules
+ *
+ * GIVEN: Two bids resting at the same price (A older than B)
+ * WHEN:  A reduces its quantity, then later increases it
+ * THEN:
+ *   - After the reduction A still trades before B
+ *   - After the increase A has lost priority and trades after B
+ */
+bool TEST3_replacePriority() {
+    log("TEST 3", "Testing cancel-replace priority...", CYAN);
+
+    EngineCore core(1024);
+    Executions out;
+
+    core.onNewOrder("IBM", makeOrder(1, 1, Order::Side::BUY, 1500000, 100), out); // A
+    core.onNewOrder("IBM", makeOrder(2, 1, Order::Side::BUY, 1500000, 100), out); // B
+
+    core.onReplace(gSeq++, 1, 1, 1500000, 40, out);
+    if (core.findBook("IBM")->levelQty(Order::Side::BUY, 1500000) != 140) {
+        log("TEST 3", "FAILED - Level quantity not reduced", RED);
+        return false;
+    }
+
+    out.clear();
+    core.onNewOrder("IBM", makeOrder(5, 1, Order::Side::SELL, 1500000, 10), out);
+    if (countOf(out, ExecType::TRADE) != 1 || out.back().contraClientId != 1) {
+        log("TEST 3", "FAILED - Qty-down replace lost priority", RED);
+        return false;
+    }
+
+    core.onReplace(gSeq++, 1, 1, 1500000, 500, out);
+    out.clear();
+    core.onNewOrder("IBM", makeOrder(5, 2, Order::Side::SELL, 1500000, 10), out);
+    if (countOf(out, ExecType::TRADE) != 1 || out.back().contraClientId != 2) {
+        log("TEST 3", "FAILED - Qty-up replace kept priority", RED);
+        return false;
+    }
+
+    // Price move which crosses trades immediately
+    core.onNewOrder("IBM", makeOrder(6, 1, Order::Side::SELL, 1510000, 30), out);
+    out.clear();
+    core.onReplace(gSeq++, 2, 1, 1510000, 90, out);
+    if (countOf(out, ExecType::TRADE) != 1 || out.back().qty != 30) {
+        log("TEST 3", "FAILED - Aggressive replace did not trade", RED);
+        return false;
+    }
+
+    log("TEST 3", "PASSED - Replace keeps priority only on qty reduction", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 4: Open-addressing index consistency under churn
+ *
+ * GIVEN: An index sized for 4096 orders
+ * WHEN:  A long random sequence of inserts and erases is applied
+ * THEN:
+ *   - Every lookup agrees with a reference std::unordered_map
+ *   - Backward-shift deletion never loses a displaced key
+ */
+bool TEST4_indexChurn() {
+    log("TEST 4", "Testing order-id index under insert/erase churn...", CYAN);
+
+    OrderIndex index(4096);
+    std::unordered_map<uint64_t, Handle> reference;
+    std::mt19937_64 rng(42);
+
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t client = rng() % 8;
+        uint64_t order = rng() % 2048;
+        uint64_t key = (client << 32) | order;
+        if (reference.count(key)) {
+            if (!index.erase(client, order)) {
+                log("TEST 4", "FAILED - Existing key not erased", RED);
+                return false;
+            }
+            reference.erase(key);
+        }
+        else if (reference.size() < 4096) {
+            Handle h = static_cast<Handle>(i);
+            index.insert(client, order, h);
+            reference[key] = h;
+        }
+    }
+
+    for (const auto& [key, h] : reference) {
+        if (index.find(key >> 32, key & 0xffffffff) != h) {
+            log("TEST 4", "FAILED - Lookup mismatch", RED);
+            return false;
+        }
+    }
+    if (index.size() != reference.size()) {
+        log("TEST 4", "FAILED - Size mismatch", RED);
+        return false;
+    }
+
+    log("TEST 4", "PASSED - Index consistent after 200000 operations", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 5: Sharded matching is deterministic and sequence ordered
+ *
+ * GIVEN: A random stream of new orders, cancels and replaces over 16 symbols
+ * WHEN:  The stream is applied once to a single EngineCore and through a ShardRouter
+ *        with 4 shards running on Scheduler workers, once with symbol names and once
+ *        with SymbolTable ids
+ * THEN:
+ *   - Both merged sharded outputs are identical to the single core output
+ *   - Executions come out in non-decreasing sequence order
+ */
+bool TEST5_shardedDeterminism() {
+    log("TEST 5", "Testing symbol-sharded matching against a single core...", CYAN);
+
+    struct Collector : IExecutionSink {
+        Executions all;
+        void onExecution(const Execution& e) override { all.push_back(e); }
+    };
+
+    std::mt19937_64 rng(7);
+    const char* symbols[16] = {"AAPL", "MSFT", "TSLA", "IBM", "AMZN", "NFLX", "GOOG", "META",
+                               "ORCL", "INTC", "AMD", "NVDA", "CSCO", "ADBE", "CRM", "QCOM"};
+
+    const Ipc::SymbolTable table(std::vector<std::string>(symbols, symbols + 16));
+
+    std::vector<Ipc::Msg::IpcMessage> stream;
+    std::vector<Ipc::Msg::IpcMessage> streamById;
+    for (uint64_t seq = 1; seq <= 20000; ++seq) {
+        Ipc::Msg::IpcMessage msg;
+        Ipc::Msg::IpcMessage byId;
+        uint64_t roll = rng() % 10;
+        uint64_t symbolIdx = rng() % 16;
+        const char* symbol = symbols[symbolIdx];
+        uint64_t client = rng() % 4;
+        // Order ids are unique per symbol, as cancels are routed by symbol
+        uint64_t order = symbolIdx * 1000 + rng() % 500;
+        const auto type = roll < 6 ? Ipc::Msg::MsgType::NEW_ORDER
+                        : roll < 9 ? Ipc::Msg::MsgType::CANCEL : Ipc::Msg::MsgType::REPLACE;
+        const uint64_t side = rng() % 2;
+        const int64_t price = 1000000 + static_cast<int64_t>(rng() % 20) * 100;
+        const uint64_t qty = 1 + rng() % 100;
+        for (Ipc::Msg::IpcMessage* m : {&msg, &byId}) {
+            m->setMsgType(type);
+            m->setSeqNo(seq);
+            if (m == &msg) {
+                m->addString(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL), symbol);
+            } else {
+                m->addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL_ID), table.find(symbol));
+            }
+            m->addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SIDE), side);
+            m->addInt64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_PRICE), price);
+            m->addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_QTY), qty);
+            m->addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_CLIENT_ID), client);
+            m->addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_ORDER_ID), order);
+            m->finalize();
+        }
+        stream.push_back(std::move(msg));
+        streamById.push_back(std::move(byId));
+    }
+
+    EngineCore reference(1 << 16);
+    Executions expected;
+    for (const auto& msg : stream) {
+        reference.apply(msg, expected);
+    }
+
+    auto runSharded = [](const std::vector<Ipc::Msg::IpcMessage>& input, const Ipc::SymbolTable* symbolTable) {
+        Collector collector;
+        ShardRouter router(4, 1 << 16, 0, 64, -1, collector, symbolTable);
+        EngineScheduler scheduler("test_engine", 4);
+        scheduler.start(router);
+        for (const auto& msg : input) {
+            router.route(msg);
+            router.drain();
+        }
+        scheduler.shutdown(router);
+        return std::move(collector.all);
+    };
+
+    for (const Executions& all : {runSharded(stream, nullptr), runSharded(streamById, &table)}) {
+        if (all.size() != expected.size()) {
+            log("TEST 5", "FAILED - Output size " + std::to_string(all.size())
+                + " != " + std::to_string(expected.size()), RED);
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const auto& a = all[i];
+            const auto& b = expected[i];
+            if (a.type != b.type || a.seqNo != b.seqNo || a.orderId != b.orderId || a.clientId != b.clientId
+                || a.qty != b.qty || a.price != b.price || a.contraOrderId != b.contraOrderId) {
+                log("TEST 5", "FAILED - Divergence at execution " + std::to_string(i), RED);
+                return false;
+            }
+            if (i > 0 && a.seqNo < all[i - 1].seqNo) {
+                log("TEST 5", "FAILED - Output out of sequence order", RED);
+                return false;
+            }
+        }
+    }
+
+    log("TEST 5", "PASSED - " + std::to_string(expected.size()) + " executions identical across 4 shards, by name and by id", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 6: Time in force
+ *
+ * GIVEN: Resting asks, one of them all-or-none
+ * WHEN:  IOC, FOK and AON orders come in, then the day rolls
+ * THEN:
+ *   - IOC trades what crosses and its remainder is cancelled, never rests
+ *   - FOK is killed without any trade when the book cannot fill it completely
+ *   - A resting AON order is skipped by an order too small to take all of it
+ *   - At end of day DAY orders expire while GTC orders keep resting
+ */
+bool TEST6_timeInForce() {
+    log("TEST 6", "Testing IOC / FOK / AON / GTC semantics...", CYAN);
+
+    EngineCore core(1024);
+    Executions out;
+
+    core.onNewOrder("NVDA", makeOrder(1, 1, Order::Side::SELL, 1000000, 50, Order::TIF::ALL_OR_NONE), out);
+    core.onNewOrder("NVDA", makeOrder(2, 1, Order::Side::SELL, 1000000, 30), out);
+    core.onNewOrder("NVDA", makeOrder(3, 1, Order::Side::SELL, 1010000, 40, Order::TIF::GOOD_TILL_CANCEL), out);
+    out.clear();
+
+    // FOK 80 @ 101: only 70 can be taken partially (the AON 50 cannot), nothing trades
+    core.onNewOrder("NVDA", makeOrder(9, 1, Order::Side::BUY, 1010000, 80, Order::TIF::FILL_OR_KILL), out);
+    if (countOf(out, ExecType::TRADE) != 0 || countOf(out, ExecType::CANCELLED) != 1
+        || core.findBook("NVDA")->levelQty(Order::Side::SELL, 1000000) != 80) {
+        log("TEST 6", "FAILED - FOK should be killed with the book untouched", RED);
+        return false;
+    }
+    out.clear();
+
+    // IOC 20 @ 100: skips the AON 50, takes 20 from client 2, nothing left to cancel
+    core.onNewOrder("NVDA", makeOrder(9, 2, Order::Side::BUY, 1000000, 20, Order::TIF::IMMEDIATE_OR_CANCEL), out);
+    if (countOf(out, ExecType::TRADE) != 1 || out[1].contraClientId != 2 || countOf(out, ExecType::CANCELLED) != 0) {
+        log("TEST 6", "FAILED - IOC should skip the resting AON order", RED);
+        return false;
+    }
+    out.clear();
+
+    // IOC 100 @ 100: AON 50 + 10 left from client 2, 40 cancelled
+    core.onNewOrder("NVDA", makeOrder(9, 3, Order::Side::BUY, 1000000, 100, Order::TIF::IMMEDIATE_OR_CANCEL), out);
+    OrderBook* book = core.findBook("NVDA");
+    if (countOf(out, ExecType::TRADE) != 2 || out.back().type != ExecType::CANCELLED || out.back().qty != 40
+        || book->hasBid() || book->depth(Order::Side::SELL) != 1) {
+        log("TEST 6", "FAILED - IOC remainder should be cancelled, not rest", RED);
+        return false;
+    }
+    out.clear();
+
+    // AON buy that cannot be filled rests without trading, then the day rolls
+    core.onNewOrder("NVDA", makeOrder(9, 4, Order::Side::BUY, 1010000, 60, Order::TIF::ALL_OR_NONE), out);
+    if (countOf(out, ExecType::TRADE) != 0 || book->levelQty(Order::Side::BUY, 1010000) != 60) {
+        log("TEST 6", "FAILED - Unfillable AON should rest untouched", RED);
+        return false;
+    }
+    out.clear();
+
+    core.onEndOfDay(gSeq++, out);
+    if (countOf(out, ExecType::EXPIRED) != 1 || book->hasBid()
+        || !book->hasAsk() || book->levelQty(Order::Side::SELL, 1010000) != 40) {
+        log("TEST 6", "FAILED - Only the GTC order should survive the day roll", RED);
+        return false;
+    }
+
+    log("TEST 6", "PASSED - TIF semantics applied without touching unfillable books", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 7: Market order sweep bounded by the protection band
+ *
+ * GIVEN: A book with four ask levels and a band of three levels
+ * WHEN:  A large market buy, then a market sell on an empty bid side
+ * THEN:
+ *   - The buy sweeps exactly three contiguous levels, best first
+ *   - Its remainder is cancelled with PROTECTION_BAND and never rests
+ *   - A market order finding no liquidity is cancelled in full
+ */
+bool TEST7_marketSweepBand() {
+    log("TEST 7", "Testing market order sweep with protection band...", CYAN);
+
+    EngineCore core(1024, 3);
+    Executions out;
+
+    for (int64_t lvl = 0; lvl < 4; ++lvl) {
+        core.onNewOrder("AMD", makeOrder(1, 1 + lvl, Order::Side::SELL, 1000000 + lvl * 100, 10), out);
+    }
+    out.clear();
+
+    OrderRequest sweep = makeOrder(2, 1, Order::Side::BUY, 0, 100);
+    sweep.type = Order::Type::MARKET;
+    core.onNewOrder("AMD", sweep, out);
+
+    OrderBook* book = core.findBook("AMD");
+    if (countOf(out, ExecType::TRADE) != 3 || out[1].price != 1000000 || out[3].price != 1000200
+        || out.back().type != ExecType::CANCELLED || out.back().reason != RejectReason::PROTECTION_BAND
+        || out.back().qty != 70) {
+        log("TEST 7", "FAILED - Sweep should stop after 3 levels and cancel 70", RED);
+        return false;
+    }
+    if (book->hasBid() || book->depth(Order::Side::SELL) != 1 || book->bestAsk() != 1000300) {
+        log("TEST 7", "FAILED - Book not left with the 4th level only", RED);
+        return false;
+    }
+    out.clear();
+
+    OrderRequest dry = makeOrder(3, 1, Order::Side::SELL, 0, 10);
+    dry.type = Order::Type::MARKET;
+    core.onNewOrder("AMD", dry, out);
+    if (out.size() != 2 || out[1].type != ExecType::CANCELLED || out[1].reason != RejectReason::NONE
+        || out[1].qty != 10 || book->hasBid()) {
+        log("TEST 7", "FAILED - Market order without liquidity should be cancelled", RED);
+        return false;
+    }
+
+    log("TEST 7", "PASSED - Sweep bounded to the protection band", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 8: Snapshot and restart
+ *
+ * GIVEN: Engines loaded with random flow over several books
+ * WHEN:  The state is snapshotted (directly, and by forked shard writers through the
+ *        router), loaded into fresh engines, and the rest of the flow is replayed
+ * THEN:
+ *   - The restored engine produces exactly the executions of the original one
+ *   - The router skips messages already contained in the shard snapshots
+ */
+bool TEST8_snapshotRestore() {
+    log("TEST 8", "Testing snapshot / restore of books and order index...", CYAN);
+
+    struct Collector : IExecutionSink {
+        Executions all;
+        void onExecution(const Execution& e) override { all.push_back(e); }
+    };
+
+    std::mt19937_64 rng(11);
+    const char* symbols[4] = {"AAPL", "MSFT", "TSLA", "IBM"};
+    std::vector<Ipc::Msg::IpcMessage> stream;
+    for (uint64_t seq = 1; seq <= 4000; ++seq) {
+        Ipc::Msg::IpcMessage msg;
+        uint64_t roll = rng() % 10;
+        uint64_t symbolIdx = rng() % 4;
+        msg.setMsgType(roll < 7 ? Ipc::Msg::MsgType::NEW_ORDER : Ipc::Msg::MsgType::CANCEL);
+        msg.setSeqNo(seq);
+        msg.addString(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL), symbols[symbolIdx]);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SIDE), rng() % 2);
+        msg.addInt64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_PRICE), 1000000 + static_cast<int64_t>(rng() % 20) * 100);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_QTY), 1 + rng() % 100);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_CLIENT_ID), rng() % 4);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_ORDER_ID), symbolIdx * 1000 + rng() % 300);
+        msg.finalize();
+        stream.push_back(std::move(msg));
+    }
+    const size_t cut = 2500;
+
+    // Direct: save at `cut`, load into a fresh core, both replay the tail
+    EngineCore original(4096);
+    Executions ignored;
+    for (size_t i = 0; i < cut; ++i) {
+        original.apply(stream[i], ignored);
+    }
+    const std::string path = "/tmp/test_matching_engine.snap";
+    Snapshot::save(original, cut, path);
+
+    EngineCore restored(4096);
+    if (Snapshot::load(path, restored) != cut || restored.bookCount() != original.bookCount()
+        || restored.context().index.size() != original.context().index.size()) {
+        log("TEST 8", "FAILED - Restored state header mismatch", RED);
+        return false;
+    }
+
+    Executions expected, actual;
+    for (size_t i = cut; i < stream.size(); ++i) {
+        original.apply(stream[i], expected);
+        restored.apply(stream[i], actual);
+    }
+    if (expected.size() != actual.size()) {
+        log("TEST 8", "FAILED - Restored engine diverged", RED);
+        return false;
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (expected[i].type != actual[i].type || expected[i].orderId != actual[i].orderId
+            || expected[i].qty != actual[i].qty || expected[i].contraOrderId != actual[i].contraOrderId) {
+            log("TEST 8", "FAILED - Restored engine diverged at execution " + std::to_string(i), RED);
+            return false;
+        }
+    }
+
+    // Sharded: forked writers, then a new router replays the whole stream
+    const std::string dir = "/tmp";
+    {
+        Collector sink;
+        ShardRouter router(2, 4096, 0, 64, -1, sink);
+        EngineScheduler scheduler("test_snap", 2);
+        scheduler.start(router);
+        for (size_t i = 0; i < cut; ++i) {
+            router.route(stream[i]);
+            router.drain();
+        }
+        router.snapshot(dir);
+        scheduler.shutdown(router);     // waits for the snapshot writers
+    }
+
+    Collector sink;
+    ShardRouter router(2, 4096, 0, 64, -1, sink);
+    if (router.restore(dir) != cut) {
+        log("TEST 8", "FAILED - Shard snapshots not tagged with the last routed SeqNo", RED);
+        return false;
+    }
+    EngineScheduler scheduler("test_snap", 2);
+    scheduler.start(router);
+    for (const auto& msg : stream) {
+        router.route(msg);
+        router.drain();
+    }
+    scheduler.shutdown(router);
+    std::remove("/tmp/shard_0.snap");
+    std::remove("/tmp/shard_1.snap");
+    std::remove(path.c_str());
+
+    if (sink.all.size() != expected.size() || (!sink.all.empty() && sink.all.front().seqNo <= cut)) {
+        log("TEST 8", "FAILED - Replay after sharded restore produced "
+            + std::to_string(sink.all.size()) + " executions, expected " + std::to_string(expected.size()), RED);
+        return false;
+    }
+
+    log("TEST 8", "PASSED - Restart from snapshot + tail replay matches the live engine", GREEN);
+    return true;
+}
+
+int main() {
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "     Matching Engine Order Book Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 8;
+
+    if (TEST1_priceTimePriority()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_cancelByIndex()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_replacePriority()) passed++;
+    std::cout << std::endl;
+
+    if (TEST4_indexChurn()) passed++;
+    std::cout << std::endl;
+
+    if (TEST5_shardedDeterminism()) passed++;
+    std::cout << std::endl;
+
+    if (TEST6_timeInForce()) passed++;
+    std::cout << std::endl;
+
+    if (TEST7_marketSweepBand()) passed++;
+    std::cout << std::endl;
+
+    if (TEST8_snapshotRestore()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
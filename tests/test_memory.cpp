@@ -0,0 +1,718 @@
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Logger.h"
+#include "BlockingQueue/MutexBlockingQueue.h"
+#include "Memory/Arena.h"
+#include "Memory/MemoryResource.h"
+#include "Memory/ObjectPool.h"
+#include "messaging.h"
+#include "Network/FIX.h"
+#include "Network/PacketPool.h"
+#include "Network/TcpEpollListener.h"
+#include "FixMessageDispatcher.h"
+#include "IPC/Consumer.h"
+#include "Shard/ShardRouter.h"
+#include "XMLReader.h"
+
+#include "AllocationCounter.h"
+
+using namespace Exchange;
+using namespace Exchange::Core;
+using Gateway::Network::Fix;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+/**
+ * @brief Test 1: Object pool shared by threads
+ *
+ * GIVEN: A pool of 64 objects and 4 threads
+ * WHEN:  Each thread repeatedly takes up to 16 objects, stamps them and gives them back
+ * THEN:
+ *   - No object is handed to two holders at once (stamps are intact when released)
+ *   - Exhaustion returns nullptr, every slot is free again at the end
+ *   - The steady state makes no heap allocation
+ */
+bool TEST1_objectPool() {
+    log("TEST 1", "Testing ObjectPool across threads...", CYAN);
+
+    struct Item {
+        uint64_t owner;
+        explicit Item(uint64_t o) : owner(o) {}
+    };
+
+    ObjectPool<Item> pool(64);
+    {
+        std::vector<Item*> all;
+        while (Item* item = pool.acquire(0)) {
+            all.push_back(item);
+        }
+        if (all.size() != 64 || pool.available() != 0 || !pool.owns(all[0])) {
+            log("TEST 1", "FAILED - exhaustion", RED);
+            return false;
+        }
+        for (Item* item : all) {
+            pool.release(item);
+        }
+    }
+
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 20000;
+    std::atomic<bool> corrupted{false};
+    std::atomic<size_t> allocations{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            Item* held[16];
+            const size_t before = tAllocations;
+            for (int r = 0; r < ROUNDS; ++r) {
+                int n = 0;
+                for (; n < 1 + (r + t) % 16; ++n) {
+                    const uint64_t stamp = (static_cast<uint64_t>(t) << 32) | static_cast<uint32_t>(r * 16 + n);
+                    held[n] = pool.acquire(stamp);
+                    if (!held[n]) {
+                        break;
+                    }
+                }
+                for (int i = 0; i < n; ++i) {
+                    if (held[i]->owner != ((static_cast<uint64_t>(t) << 32) | static_cast<uint32_t>(r * 16 + i))) {
+                        corrupted.store(true);
+                    }
+                    pool.release(held[i]);
+                }
+            }
+            allocations.fetch_add(tAllocations - before);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    if (corrupted.load()) {
+        log("TEST 1", "FAILED - an object was handed out twice", RED);
+        return false;
+    }
+    if (pool.available() != pool.capacity() || allocations.load() != 0) {
+        log("TEST 1", "FAILED - " + std::to_string(pool.available()) + " free, "
+            + std::to_string(allocations.load()) + " allocations", RED);
+        return false;
+    }
+
+    {
+        auto item = pool.make(7);
+        if (pool.available() != 63 || item->owner != 7) {
+            log("TEST 1", "FAILED - make()", RED);
+            return false;
+        }
+    }
+    if (pool.available() != 64) {
+        log("TEST 1", "FAILED - Ptr did not release", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - 4 threads, no double hand-out, no allocation", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Pooled packet buffers
+ *
+ * GIVEN: A packet pool of 4 buffers
+ * WHEN:  Bytes are written into acquired buffers, references are copied, moved and
+ *        dropped, and more buffers than the pool holds are taken
+ * THEN:
+ *   - A buffer returns to the pool only when its last reference goes
+ *   - A FIX order is parsed straight from the buffer
+ *   - An exhausted pool hands out heap buffers (pooled() false), freed on release
+ *   - Cycling pooled buffers makes no heap allocation
+ */
+bool TEST2_packetPool() {
+    log("TEST 2", "Testing PacketPool / PacketRef...", CYAN);
+
+    using Gateway::Network::PacketPool;
+    using Gateway::Network::PacketRef;
+
+    PacketPool pool(4);
+    const std::string order = "35=D\x01" "11=ORD-1\x01" "55=MSFT\x01" "54=2\x01" "38=40\x01" "44=410.5\x01";
+    {
+        PacketRef ref = pool.acquire();
+        std::memcpy(ref.data(), order.data(), order.size());
+        PacketRef shared = ref;
+        PacketRef moved = std::move(ref);
+        if (ref || !shared.pooled() || pool.available() != 3) {
+            log("TEST 2", "FAILED - acquire / move", RED);
+            return false;
+        }
+        moved = PacketRef();
+        if (pool.available() != 3) {
+            log("TEST 2", "FAILED - buffer released while still referenced", RED);
+            return false;
+        }
+        const Fix::FixMsg fix = Fix::parseFix(std::string_view(shared.data(), order.size()));
+        if (!fix.isValid || fix.symbol != "MSFT" || fix.quantity != 40 || fix.price != 410.5) {
+            log("TEST 2", "FAILED - parse from the buffer", RED);
+            return false;
+        }
+    }
+    if (pool.available() != 4) {
+        log("TEST 2", "FAILED - buffer not returned", RED);
+        return false;
+    }
+
+    {
+        std::vector<PacketRef> held;
+        for (int i = 0; i < 6; ++i) {
+            held.push_back(pool.acquire());
+        }
+        if (pool.available() != 0 || !held[3].pooled() || held[4].pooled() || held[5].pooled()) {
+            log("TEST 2", "FAILED - heap fallback", RED);
+            return false;
+        }
+    }
+
+    const size_t before = tAllocations;
+    for (int i = 0; i < 10000; ++i) {
+        PacketRef a = pool.acquire();
+        PacketRef b = pool.acquire();
+        PacketRef c = a;
+        a.data()[0] = static_cast<char>(i);
+    }
+    if (tAllocations != before || pool.available() != 4) {
+        log("TEST 2", "FAILED - steady state allocated or leaked", RED);
+        return false;
+    }
+
+    log("TEST 2", "PASSED - buffers shared, parsed in place and recycled", GREEN);
+    return true;
+}
+
+/**
+ * @brief A FixMessageDispatcher on a private configuration and symbol table, and the
+ * sequencer side of its queue. Built once: the gateway configuration is a singleton.
+ */
+class DispatcherHarness {
+public:
+    using PacketPool = Gateway::Network::PacketPool;
+    using RawPacket = Gateway::Network::RawPacket;
+
+    static DispatcherHarness& instance() {
+        static DispatcherHarness harness;
+        return harness;
+    }
+
+    /** @brief Builds "<prefix><n><middle>[<orig>]<suffix>" in a pooled buffer and dispatches it. */
+    void send(std::string_view prefix, int n, std::string_view middle, int orig, std::string_view suffix) {
+        RawPacket packet;
+        packet.clientSocket = 7;
+        packet.buffer = mPackets.acquire();
+        char* p = packet.buffer.data();
+        char* const end = p + packet.buffer.capacity();
+        std::memcpy(p, prefix.data(), prefix.size());
+        p = std::to_chars(p + prefix.size(), end, n).ptr;
+        std::memcpy(p, middle.data(), middle.size());
+        p += middle.size();
+        if (orig >= 0) {
+            p = std::to_chars(p, end, orig).ptr;
+        }
+        std::memcpy(p, suffix.data(), suffix.size());
+        packet.length = static_cast<uint32_t>(p + suffix.size() - packet.buffer.data());
+        mDispatcher.dispatch(packet, 0);
+    }
+
+    /** @brief Dispatches one complete FIX message. */
+    void send(std::string_view fix) {
+        RawPacket packet;
+        packet.clientSocket = 7;
+        packet.buffer = mPackets.acquire();
+        std::memcpy(packet.buffer.data(), fix.data(), fix.size());
+        packet.length = static_cast<uint32_t>(fix.size());
+        mDispatcher.dispatch(packet, 0);
+    }
+
+    /** @return The next message the dispatcher published, decoded; nullptr if none. */
+    const Ipc::Msg::IpcMessage* next() {
+        const uint32_t n = mSequencer.read(mBuf.data(), static_cast<uint32_t>(mBuf.size()));
+        if (n == 0 || !Ipc::Msg::IpcMessage::decode(mBuf.data(), n, mDecoded)) {
+            return nullptr;
+        }
+        return &mDecoded;
+    }
+
+    /** @return Order id of the next published message, 0 if none or not of `type`. */
+    uint64_t received(Ipc::Msg::MsgType type) {
+        const Ipc::Msg::IpcMessage* msg = next();
+        if (!msg || msg->header.MsgType != static_cast<uint16_t>(type)) {
+            return 0;
+        }
+        return msg->getUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_ORDER_ID)).value_or(0);
+    }
+
+private:
+    Ipc::SymbolTable mSymbols{{"AAPL", "MSFT"}};
+    Gateway::FixMessageDispatcher mDispatcher;
+    Ipc::Consumer mSequencer{"test_memory_dispatcher", 4096};
+    PacketPool mPackets{4};
+    std::vector<uint8_t> mBuf = std::vector<uint8_t>(Ipc::MAX_MSG_SIZE);
+    Ipc::Msg::IpcMessage mDecoded;
+
+    DispatcherHarness() : mDispatcher((initConfig(), std::make_shared<MutexBlockingQueue<RawPacket>>(16)), mSymbols) {}
+
+    static void initConfig() {
+        const char* configFile = "/tmp/test_memory_config.xml";
+        std::ofstream(configFile)
+            << "<Exchange><Gateway><Port>0</Port><BlockingQueue><Size>16</Size></BlockingQueue>"
+            << "<Fix><MaxEventSize>100</MaxEventSize><BacklogSize>100</BacklogSize></Fix>"
+            << "<Ipc><SchedulerQueue>test_memory_dispatcher</SchedulerQueue></Ipc>"
+            << "<Orders><InstanceId>3</InstanceId><ExpectedOrders>16384</ExpectedOrders></Orders>"
+            << "</Gateway></Exchange>";
+        XMLReader reader(configFile);
+        Gateway::Config::init(reader.getNode("Gateway"));
+    }
+};
+
+/**
+ * @brief Test 3: Steady state of the gateway dispatcher
+ *
+ * GIVEN: The dispatcher harness
+ * WHEN:  3000 rounds of NewOrderSingle, Cancel/Replace and Cancel packets from pooled
+ *        buffers go through dispatch(); each IPC message is read back and decoded as the
+ *        sequencer does
+ * THEN:
+ *   - The sequencer sees NEW_ORDER, REPLACE, CANCEL for the same exchange order id
+ *   - No round after the first allocates: parsing, ClOrdID mapping, encoding, publishing
+ *     and decoding all reuse their storage
+ */
+bool TEST3_dispatcherSteadyState() {
+    log("TEST 3", "Testing FixMessageDispatcher::dispatch -> sequencer decode...", CYAN);
+
+    DispatcherHarness& h = DispatcherHarness::instance();
+    size_t before = 0;
+    for (int i = 0; i < 3000; ++i) {
+        if (i == 1) {
+            before = tAllocations;
+        }
+        h.send("8=FIX.4.4\x01" "35=D\x01" "49=FIRM-A\x01" "11=N", i, "\x01", -1,
+               "55=AAPL\x01" "54=1\x01" "38=250\x01" "44=187.25\x01" "40=2\x01" "59=0\x01" "10=042\x01");
+        const uint64_t orderId = h.received(Ipc::Msg::MsgType::NEW_ORDER);
+        h.send("8=FIX.4.4\x01" "35=G\x01" "49=FIRM-A\x01" "11=R", i, "\x01" "41=N", i,
+               "\x01" "55=AAPL\x01" "54=1\x01" "38=200\x01" "44=187.5\x01" "40=2\x01" "10=042\x01");
+        const uint64_t replaced = h.received(Ipc::Msg::MsgType::REPLACE);
+        h.send("8=FIX.4.4\x01" "35=F\x01" "49=FIRM-A\x01" "11=C", i, "\x01" "41=R", i,
+               "\x01" "55=AAPL\x01" "54=1\x01" "10=042\x01");
+        const uint64_t cancelled = h.received(Ipc::Msg::MsgType::CANCEL);
+        if (orderId == 0 || replaced != orderId || cancelled != orderId) {
+            log("TEST 3", "FAILED - round " + std::to_string(i) + " ids " + std::to_string(orderId) + "/"
+                + std::to_string(replaced) + "/" + std::to_string(cancelled), RED);
+            return false;
+        }
+    }
+    if (tAllocations != before) {
+        log("TEST 3", "FAILED - " + std::to_string(tAllocations - before) + " allocations in steady state", RED);
+        return false;
+    }
+
+    log("TEST 3", "PASSED - 8997 requests dispatched, published and decoded without malloc", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 4: Prices and quantities of new orders and replaces
+ *
+ * GIVEN: The dispatcher harness and a resting order
+ * WHEN:  Orders and replaces with prices which are not exact doubles are dispatched,
+ *        then replaces without a price or without a quantity
+ * THEN:
+ *   - Prices are rounded to the nearest 1/10000, not truncated
+ *   - A replace missing its price or quantity is rejected, nothing reaches the sequencer
+ */
+bool TEST4_replacePrices() {
+    log("TEST 4", "Testing price conversion and incomplete replaces...", CYAN);
+
+    DispatcherHarness& h = DispatcherHarness::instance();
+    const auto price = [](const Ipc::Msg::IpcMessage* msg) {
+        return msg ? msg->getInt64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_PRICE)).value_or(-1) : -1;
+    };
+
+    h.send("8=FIX.4.4\x01" "35=D\x01" "49=FIRM-B\x01" "11=P1\x01" "55=MSFT\x01" "54=2\x01"
+           "38=100\x01" "44=101.23\x01" "40=2\x01" "10=042\x01");
+    if (const int64_t p = price(h.next()); p != 1012300) {
+        log("TEST 4", "FAILED - NEW_ORDER price " + std::to_string(p), RED);
+        return false;
+    }
+    h.send("8=FIX.4.4\x01" "35=G\x01" "49=FIRM-B\x01" "11=P2\x01" "41=P1\x01" "55=MSFT\x01" "54=2\x01"
+           "38=100\x01" "44=0.29\x01" "40=2\x01" "10=042\x01");
+    if (const int64_t p = price(h.next()); p != 2900) {
+        log("TEST 4", "FAILED - REPLACE price " + std::to_string(p), RED);
+        return false;
+    }
+
+    h.send("8=FIX.4.4\x01" "35=G\x01" "49=FIRM-B\x01" "11=P3\x01" "41=P2\x01" "55=MSFT\x01" "54=2\x01"
+           "38=100\x01" "40=2\x01" "10=042\x01");
+    h.send("8=FIX.4.4\x01" "35=G\x01" "49=FIRM-B\x01" "11=P4\x01" "41=P2\x01" "55=MSFT\x01" "54=2\x01"
+           "44=101.5\x01" "40=2\x01" "10=042\x01");
+    if (h.next()) {
+        log("TEST 4", "FAILED - incomplete replace forwarded", RED);
+        return false;
+    }
+
+    log("TEST 4", "PASSED - prices rounded, incomplete replaces rejected", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 5: ClOrdIDs are released by cancels and replaces
+ *
+ * GIVEN: The dispatcher harness
+ * WHEN:  An order is cancelled and its ClOrdID reused; another is replaced and its
+ *        OrigClOrdID reused
+ * THEN:
+ *   - The reused ClOrdID is accepted and names a new exchange order
+ *   - A cancel or replace of a released ClOrdID is rejected as unknown
+ *   - The replacement ClOrdID still names the replaced order
+ */
+bool TEST5_clOrdIdReuse() {
+    log("TEST 5", "Testing ClOrdID reuse after cancel and replace...", CYAN);
+
+    DispatcherHarness& h = DispatcherHarness::instance();
+    using Ipc::Msg::MsgType;
+    const auto order = [&](std::string_view clOrdId) {
+        h.send("8=FIX.4.4\x01" "35=D\x01" "49=FIRM-C\x01" "11=" + std::string(clOrdId) + "\x01"
+               "55=AAPL\x01" "54=1\x01" "38=10\x01" "44=50\x01" "40=2\x01" "10=042\x01");
+        return h.received(MsgType::NEW_ORDER);
+    };
+    const auto amend = [&](std::string_view type, std::string_view clOrdId, std::string_view orig) {
+        h.send("8=FIX.4.4\x01" "35=" + std::string(type) + "\x01" "49=FIRM-C\x01"
+               "11=" + std::string(clOrdId) + "\x01" "41=" + std::string(orig) + "\x01"
+               "55=AAPL\x01" "54=1\x01" "38=20\x01" "44=51\x01" "40=2\x01" "10=042\x01");
+        return h.received(type == "F" ? MsgType::CANCEL : MsgType::REPLACE);
+    };
+
+    const uint64_t first = order("A1");
+    const bool cancelled = first != 0 && amend("F", "A2", "A1") == first;
+    const uint64_t second = order("A1");
+    if (!cancelled || second == 0 || second == first || amend("F", "A3", "A1") != second
+        || amend("F", "A4", "A1") != 0) {
+        log("TEST 5", "FAILED - ClOrdID not released by the cancel", RED);
+        return false;
+    }
+
+    const uint64_t replaced = order("B1");
+    if (replaced == 0 || amend("G", "B2", "B1") != replaced || amend("F", "B3", "B1") != 0) {
+        log("TEST 5", "FAILED - OrigClOrdID still live after the replace", RED);
+        return false;
+    }
+    const uint64_t reused = order("B1");
+    if (reused == 0 || reused == replaced || amend("F", "B4", "B2") != replaced) {
+        log("TEST 5", "FAILED - OrigClOrdID not reusable after the replace", RED);
+        return false;
+    }
+
+    log("TEST 5", "PASSED - cancelled and replaced ClOrdIDs reused", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 6: Bump arena
+ *
+ * GIVEN: An arena with 4 KiB chunks
+ * WHEN:  Batches of mixed size and alignment allocations, one larger than a chunk, are
+ *        made and the arena is reset after each
+ * THEN:
+ *   - Every pointer has the requested alignment and allocations do not overlap
+ *   - After the first batch no chunk is added and the heap is not called
+ */
+bool TEST6_arena() {
+    log("TEST 6", "Testing Arena allocate() / reset()...", CYAN);
+
+    Arena arena(4096);
+    size_t reserved = 0;
+    for (int batch = 0; batch < 100; ++batch) {
+        const size_t before = tAllocations;
+        char* last = nullptr;
+        for (int i = 0; i < 200; ++i) {
+            const size_t align = size_t{1} << (i % 7);
+            const size_t bytes = (i == 100) ? 10000 : 1 + (i * 37) % 120;
+            auto* p = static_cast<char*>(arena.allocate(bytes, align));
+            if (reinterpret_cast<uintptr_t>(p) % align != 0) {
+                log("TEST 6", "FAILED - misaligned allocation", RED);
+                return false;
+            }
+            std::memset(p, i, bytes);
+            if (last && last[0] != static_cast<char>(i - 1)) {
+                log("TEST 6", "FAILED - allocations overlap", RED);
+                return false;
+            }
+            last = p;
+        }
+        arena.reset();
+        if (batch == 0) {
+            reserved = arena.reserved();
+        }
+        else if (tAllocations != before || arena.reserved() != reserved) {
+            log("TEST 6", "FAILED - batch " + std::to_string(batch) + " allocated", RED);
+            return false;
+        }
+    }
+
+    log("TEST 6", "PASSED - " + std::to_string(reserved) + " bytes reserved once, reused by 99 batches", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 7: std::pmr adaptor
+ *
+ * GIVEN: A ScopedArena
+ * WHEN:  Every batch builds a std::pmr::vector of IpcMessage in the arena and decodes
+ *        encoded orders into it
+ * THEN:
+ *   - The messages, and their fields, take the arena's memory
+ *   - The contents are right and batches after the first do not touch the heap
+ */
+bool TEST7_pmrAdaptor() {
+    log("TEST 7", "Testing ArenaResource with a batch of IpcMessage...", CYAN);
+
+    Ipc::Msg::IpcMessage order;
+    order.setMsgType(Ipc::Msg::MsgType::NEW_ORDER);
+    order.addString(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL), "AAPL");
+    order.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_QTY), 100);
+    order.finalize();
+    std::vector<uint8_t> encoded;
+    order.encode(encoded);
+
+    ScopedArena batch(16 * 1024);
+    for (int b = 0; b < 50; ++b) {
+        const size_t before = tAllocations;
+        {
+            auto reset = batch.scope();
+            std::pmr::vector<Ipc::Msg::IpcMessage> messages(batch.resource());
+            for (int i = 0; i < 100; ++i) {
+                if (!Ipc::Msg::IpcMessage::decode(encoded.data(), encoded.size(), messages.emplace_back())) {
+                    log("TEST 7", "FAILED - decode", RED);
+                    return false;
+                }
+            }
+            if (messages[42].getString(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL)) != "AAPL"
+                || messages[42].fields.get_allocator().resource() != batch.resource()) {
+                log("TEST 7", "FAILED - wrong contents or resource", RED);
+                return false;
+            }
+        }
+        if (b > 0 && tAllocations != before) {
+            log("TEST 7", "FAILED - batch " + std::to_string(b) + " allocated", RED);
+            return false;
+        }
+    }
+
+    log("TEST 7", "PASSED - messages decoded every batch into the same chunks", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 8: Steady state of the sequencer
+ *
+ * GIVEN: A sequencer on private gateway and engine queues
+ * WHEN:  Bursts of 1 to 64 gateway messages are written and poll() decodes, numbers and
+ *        forwards each burst as one batch
+ * THEN:
+ *   - The engine side reads every message once, numbered without gaps
+ *   - No burst after the first (the largest) allocates: the batch lives in the arena
+ */
+bool TEST8_sequencerSteadyState() {
+    log("TEST 8", "Testing Sequencer poll() decode -> forward...", CYAN);
+
+    const char* configFile = "/tmp/test_memory_sequencer.xml";
+    std::ofstream(configFile)
+        << "<Exchange><Sequencer><Port>0</Port><BlockingQueue><Size>16</Size></BlockingQueue>"
+        << "<Ipc><SequencerQueue>test_memory_seq_in</SequencerQueue>"
+        << "<MatchingEngineQueue>test_memory_seq_out</MatchingEngineQueue></Ipc></Sequencer></Exchange>";
+    XMLReader reader(configFile);
+    Sequencer::Config::init(reader.getNode("Sequencer"));
+
+    Ipc::Producer gateway("test_memory_seq_in", 4096);
+    Sequencer::Ipc::Consumer sequencer;
+    Ipc::Consumer engine("test_memory_seq_out", 4096);
+
+    Ipc::Msg::IpcMessage order;
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> buf(Ipc::MAX_MSG_SIZE);
+    Ipc::Msg::IpcMessage decoded;
+    uint64_t expectedSeqNo = 1;
+
+    size_t before = 0;
+    for (int round = 0; round < 500; ++round) {
+        if (round == 1) {
+            before = tAllocations;
+        }
+        const size_t burst = round == 0 ? Sequencer::Ipc::Consumer::MAX_BATCH : 1 + round % 64;
+        for (size_t i = 0; i < burst; ++i) {
+            order.clear();
+            order.setMsgType(Ipc::Msg::MsgType::NEW_ORDER);
+            order.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL_ID), 0);
+            order.addInt64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_PRICE), 1872500);
+            order.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_QTY), 250);
+            order.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_ORDER_ID), round * 100 + i);
+            order.finalize();
+            order.encode(encoded);
+            gateway.write(encoded.data(), static_cast<uint32_t>(encoded.size()));
+        }
+        if (sequencer.poll() != burst) {
+            log("TEST 8", "FAILED - round " + std::to_string(round) + " not forwarded as one batch", RED);
+            return false;
+        }
+        for (size_t i = 0; i < burst; ++i) {
+            const uint32_t n = engine.read(buf.data(), static_cast<uint32_t>(buf.size()));
+            if (n == 0 || !Ipc::Msg::IpcMessage::decode(buf.data(), n, decoded)
+                || decoded.header.seqNo != expectedSeqNo++
+                || decoded.getUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_ORDER_ID)) != round * 100 + i) {
+                log("TEST 8", "FAILED - round " + std::to_string(round) + " message " + std::to_string(i), RED);
+                return false;
+            }
+        }
+    }
+    if (tAllocations != before) {
+        log("TEST 8", "FAILED - " + std::to_string(tAllocations - before) + " allocations in steady state", RED);
+        return false;
+    }
+
+    log("TEST 8", "PASSED - " + std::to_string(expectedSeqNo - 1) + " messages sequenced in batches without malloc", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 9: Steady state of the engine, router to shard
+ *
+ * GIVEN: A ShardRouter with one shard, whose commands are executed on the test thread
+ *        with EngineShard::poll()
+ * WHEN:  3000 rounds of a resting buy, a crossing sell and a cancel of the remainder
+ *        are routed, executed and drained
+ * THEN:
+ *   - Every round produces its accept, accept + trade and cancel
+ *   - No round after the first allocates: routing, matching, the shard rings and the
+ *     merge reuse their storage
+ */
+bool TEST9_routerToShard() {
+    log("TEST 9", "Testing ShardRouter -> EngineShard -> drain...", CYAN);
+
+    using Matching::Execution;
+    using Matching::ExecType;
+    struct Counter : Matching::IExecutionSink {
+        size_t executions = 0;
+        size_t trades = 0;
+        void onExecution(const Execution& e) override {
+            ++executions;
+            trades += e.type == ExecType::TRADE;
+        }
+    } sink;
+
+    const Ipc::SymbolTable symbols({"AAPL", "MSFT"});
+    Matching::ShardRouter router(1, 4096, 0, 256, -1, sink, &symbols);
+    Matching::EngineShard& shard = router.shard(0);
+    Ipc::Msg::IpcMessage msg;
+    uint64_t seqNo = 0;
+    const auto route = [&](Ipc::Msg::MsgType type, uint64_t clientId, uint64_t orderId, Order::Side side,
+                           uint64_t qty) {
+        msg.clear();
+        msg.setMsgType(type);
+        msg.setSeqNo(++seqNo);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL_ID), 1);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_CLIENT_ID), clientId);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_ORDER_ID), orderId);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SIDE), static_cast<uint64_t>(side));
+        msg.addInt64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_PRICE), 4100000);
+        msg.addUint64(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_QTY), qty);
+        msg.finalize();
+        router.accept(msg);
+        while (shard.poll()) {
+        }
+        router.drain();
+    };
+
+    size_t before = 0;
+    for (uint64_t i = 0; i < 3000; ++i) {
+        if (i == 1) {
+            before = tAllocations;
+        }
+        route(Ipc::Msg::MsgType::NEW_ORDER, 1, 2 * i + 1, Order::Side::BUY, 100);
+        route(Ipc::Msg::MsgType::NEW_ORDER, 2, 2 * i + 2, Order::Side::SELL, 40);
+        route(Ipc::Msg::MsgType::CANCEL, 1, 2 * i + 1, Order::Side::BUY, 0);
+    }
+    const size_t allocations = tAllocations - before;
+    if (sink.executions != 3000 * 4 || sink.trades != 3000) {
+        log("TEST 9", "FAILED - " + std::to_string(sink.executions) + " executions, "
+            + std::to_string(sink.trades) + " trades", RED);
+        return false;
+    }
+    if (allocations != 0) {
+        log("TEST 9", "FAILED - " + std::to_string(allocations) + " allocations in steady state", RED);
+        return false;
+    }
+
+    log("TEST 9", "PASSED - 8997 requests routed, matched and merged without malloc", GREEN);
+    return true;
+}
+
+int main() {
+    // TRACE output of parseFix() would allocate in debug builds
+    Logger::setLevel(LogModule::GATEWAY, LogLevel::INFO);
+
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "            Memory Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 9;
+
+    if (TEST1_objectPool()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_packetPool()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_dispatcherSteadyState()) passed++;
+    std::cout << std::endl;
+
+    if (TEST4_replacePrices()) passed++;
+    std::cout << std::endl;
+
+    if (TEST5_clOrdIdReuse()) passed++;
+    std::cout << std::endl;
+
+    if (TEST6_arena()) passed++;
+    std::cout << std::endl;
+
+    if (TEST7_pmrAdaptor()) passed++;
+    std::cout << std::endl;
+
+    if (TEST8_sequencerSteadyState()) passed++;
+    std::cout << std::endl;
+
+    if (TEST9_routerToShard()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+
+#include "Metrics/HdrHistogram.h"
+#include "Metrics/LatencyTracer.h"
+#include "Metrics/Metrics.h"
+#include "messaging.h"
+
+using namespace Exchange;
+using namespace Exchange::Core;
+using Ipc::Msg::TraceStage;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+/**
+ * @brief Test 1: HDR histogram precision
+ *
+ * GIVEN: 100000 log-uniform values between 10 ns and 10 s
+ * WHEN:  They are recorded and the percentiles are read back
+ * THEN:
+ *   - Every percentile is within 1.6% of the exact (sorted) value
+ *   - count, max and merge() are exact
+ */
+bool TEST1_hdrHistogram() {
+    log("TEST 1", "Testing HdrHistogram percentiles...", CYAN);
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> exponent(1.0, 10.0);
+    std::vector<uint64_t> values;
+    HdrHistogram h;
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t v = static_cast<uint64_t>(std::pow(10.0, exponent(rng)));
+        values.push_back(v);
+        h.record(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    for (double p : {50.0, 90.0, 99.0, 99.9}) {
+        const uint64_t exact = values[static_cast<size_t>(p / 100.0 * values.size() + 0.5) - 1];
+        const double error = std::abs(static_cast<double>(h.percentile(p)) - exact) / exact;
+        if (error > 0.016) {
+            log("TEST 1", "FAILED - p" + std::to_string(p) + " off by " + std::to_string(error * 100) + "%", RED);
+            return false;
+        }
+    }
+    if (h.count() != values.size() || h.max() != values.back() || h.percentile(100.0) != values.back()) {
+        log("TEST 1", "FAILED - count/max mismatch", RED);
+        return false;
+    }
+
+    HdrHistogram merged;
+    merged.record(5);
+    merged.merge(h);
+    if (merged.count() != values.size() + 1 || merged.percentile(0.0) != 5 || merged.max() != h.max()) {
+        log("TEST 1", "FAILED - merge() mismatch", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - p50/p90/p99/p99.9 within 1.6%", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Trace carried in an IPC message
+ *
+ * GIVEN: A traced NEW_ORDER stamped by the gateway stages
+ * WHEN:  It is encoded, decoded and stamped by the sequencer and the engine
+ * THEN:
+ *   - The stamps survive the round trip, untraced messages cannot be stamped
+ *   - Each stage histogram holds the gap to the previous stamped stage
+ *     (JOURNAL_DURABLE is skipped), the total holds NIC_READ -> ENGINE_ACK
+ */
+bool TEST2_traceRoundTrip() {
+    log("TEST 2", "Testing LatencyTrace through encode/decode...", CYAN);
+
+    Ipc::Msg::IpcMessage order;
+    order.setMsgType(Ipc::Msg::MsgType::NEW_ORDER);
+    order.addString(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL), "AAPL");
+    order.addTrace();
+    order.finalize();
+    order.markStage(TraceStage::NIC_READ, 1000);
+    order.markStage(TraceStage::DISPATCH, 1100);
+    order.markStage(TraceStage::PARSE_DONE, 1300);
+    order.markStage(TraceStage::IPC_PUBLISH, 1600);
+
+    std::vector<uint8_t> buf;
+    order.encode(buf);
+    Ipc::Msg::IpcMessage received;
+    if (!Ipc::Msg::IpcMessage::decode(buf.data(), buf.size(), received)) {
+        log("TEST 2", "FAILED - decode()", RED);
+        return false;
+    }
+    received.markStage(TraceStage::SEQUENCER_READ, 2600);
+    received.markStage(TraceStage::ENGINE_ACK, 5600);
+
+    Ipc::Msg::IpcMessage plain;
+    plain.addString(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL), "AAPL");
+    if (plain.markStage(TraceStage::NIC_READ, 1) || plain.getTrace()) {
+        log("TEST 2", "FAILED - untraced message was stamped", RED);
+        return false;
+    }
+
+    auto trace = received.getTrace();
+    if (!trace || trace->ns[0] != 1000 || trace->ns[3] != 1600
+        || received.getString(static_cast<uint16_t>(Ipc::Msg::FieldId::FIELD_SYMBOL)) != "AAPL") {
+        log("TEST 2", "FAILED - trace lost in encode/decode", RED);
+        return false;
+    }
+
+    LatencyTracer& tracer = LatencyTracer::instance();
+    tracer.record(*trace, TraceStage::NIC_READ, TraceStage::ENGINE_ACK);
+    const struct { TraceStage stage; uint64_t ns; } expected[] = {
+        {TraceStage::DISPATCH, 100}, {TraceStage::PARSE_DONE, 200}, {TraceStage::IPC_PUBLISH, 300},
+        {TraceStage::SEQUENCER_READ, 1000}, {TraceStage::ENGINE_ACK, 3000},
+    };
+    for (const auto& e : expected) {
+        if (tracer.stage(e.stage).count() != 1 || tracer.stage(e.stage).max() != e.ns) {
+            log("TEST 2", std::string("FAILED - ") + LatencyTracer::stageName(e.stage) + " histogram", RED);
+            return false;
+        }
+    }
+    if (tracer.stage(TraceStage::JOURNAL_DURABLE).count() != 0 || tracer.total().max() != 4600) {
+        log("TEST 2", "FAILED - JOURNAL_DURABLE or total histogram", RED);
+        return false;
+    }
+
+    tracer.setSampleEvery(3);
+    int sampled = 0;
+    for (int i = 0; i < 9; ++i) {
+        sampled += tracer.sample() ? 1 : 0;
+    }
+    tracer.setSampleEvery(0);
+    if (sampled != 3 || tracer.sample()) {
+        log("TEST 2", "FAILED - Sampled " + std::to_string(sampled) + " of 9 with SampleEvery=3", RED);
+        return false;
+    }
+
+    log("TEST 2", "PASSED - Stamps carried across encode/decode, per-stage gaps recorded", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 3: Metrics registry exported over shared memory
+ *
+ * GIVEN: The registry of this process published as "EXCHANGE_METRICS_test_metrics"
+ * WHEN:  4 threads bump the same counter, a gauge is set and a histogram recorded
+ * THEN:
+ *   - A MetricsReader (read-only mapping, as exchange-stat) sees every metric by name
+ *   - The counter is the exact sum of the per-thread cells
+ *   - Registering an existing name returns the same metric
+ */
+bool TEST3_sharedRegistry() {
+    log("TEST 3", "Testing MetricsRegistry through a read-only mapping...", CYAN);
+
+    Counter orders("test.orders");
+    Gauge depth("test.depth");
+    HdrHistogram& latency = MetricsRegistry::instance().histogram("test.latency");
+
+    constexpr int threads = 4;
+    constexpr int perThread = 100000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&orders] {
+            for (int i = 0; i < perThread; ++i) {
+                orders.add();
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    Counter("test.orders").add(5);
+    depth.set(-42);
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        latency.record(v * 1000);
+    }
+
+    MetricsReader reader("test_metrics");
+    bool sawCounter = false, sawGauge = false, sawHistogram = false;
+    for (uint32_t i = 0; i < reader.size(); ++i) {
+        const MetricDesc& d = reader.desc(i);
+        const std::string name = d.name;
+        if (name == "test.orders" && d.kind == MetricKind::COUNTER) {
+            sawCounter = reader.counter(d.index) == threads * perThread + 5;
+        }
+        else if (name == "test.depth" && d.kind == MetricKind::GAUGE) {
+            sawGauge = reader.gauge(d.index) == -42;
+        }
+        else if (name == "test.latency" && d.kind == MetricKind::HISTOGRAM) {
+            const HdrHistogram h = reader.histogram(d.index);
+            const uint64_t p50 = h.percentile(50.0);
+            sawHistogram = h.count() == 1000 && h.max() == 1000000 && p50 >= 500000 && p50 <= 508000;
+        }
+    }
+    if (!sawCounter || !sawGauge || !sawHistogram) {
+        log("TEST 3", std::string("FAILED - counter ") + (sawCounter ? "ok" : "wrong") + ", gauge "
+            + (sawGauge ? "ok" : "wrong") + ", histogram " + (sawHistogram ? "ok" : "wrong"), RED);
+        return false;
+    }
+
+    log("TEST 3", "PASSED - " + std::to_string(reader.size()) + " metrics read back, "
+        + std::to_string(threads * perThread + 5) + " counts summed over threads", GREEN);
+    return true;
+}
+
+int main() {
+    MetricsRegistry::init("test_metrics");
+
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "            Metrics Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 3;
+
+    if (TEST1_hdrHistogram()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_traceRoundTrip()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_sharedRegistry()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Orders/ClOrdIdMap.h"
+#include "Orders/OrderIdAllocator.h"
+
+#include "AllocationCounter.h"
+
+using namespace Exchange;
+using Gateway::Orders::ClOrdIdMap;
+using Gateway::Orders::OrderIdAllocator;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+/**
+ * @brief Test 1: Order id layout and uniqueness
+ *
+ * GIVEN: Allocators of 2 gateway instances x 3 reactors, and one restarted with a later epoch
+ * WHEN:  Each issues 20000 ids, one allocator's counter wraps, and one is restarted 2 ms later
+ * THEN:
+ *   - Every id is non-zero, unique, and decodes to its instance, reactor and epoch
+ *   - The wrap moves the epoch on instead of reissuing ids
+ *   - The restarted allocator numbers above the first one, also within the same second
+ *   - An out of range instance or reactor throws
+ */
+bool TEST1_allocator() {
+    log("TEST 1", "Testing OrderIdAllocator...", CYAN);
+
+    std::unordered_set<uint64_t> seen;
+    const uint32_t epoch = 12345;
+    for (uint32_t instance = 0; instance < 2; ++instance) {
+        for (uint32_t reactor = 0; reactor < 3; ++reactor) {
+            for (uint32_t e : {epoch, epoch + 1}) {
+                OrderIdAllocator ids(instance, reactor, e);
+                for (int i = 0; i < 20000; ++i) {
+                    const uint64_t id = ids.next();
+                    if (id == 0 || !seen.insert(id).second || OrderIdAllocator::instanceOf(id) != instance
+                        || OrderIdAllocator::reactorOf(id) != reactor || OrderIdAllocator::epochOf(id) != e) {
+                        log("TEST 1", "FAILED - bad or duplicate id " + std::to_string(id), RED);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    OrderIdAllocator wrapping(OrderIdAllocator::MAX_INSTANCE, OrderIdAllocator::MAX_REACTOR,
+                              OrderIdAllocator::EPOCH_MASK, UINT32_MAX - 1);
+    const uint64_t beforeWrap = wrapping.next();
+    const uint64_t last = wrapping.next();
+    if (OrderIdAllocator::counterOf(beforeWrap) != UINT32_MAX
+        || OrderIdAllocator::epochOf(last) != 0 || OrderIdAllocator::counterOf(last) != 1
+        || OrderIdAllocator::instanceOf(last) != OrderIdAllocator::MAX_INSTANCE) {
+        log("TEST 1", "FAILED - counter wrap", RED);
+        return false;
+    }
+
+    const uint64_t firstRun = OrderIdAllocator(1, 2).next();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    const uint64_t secondRun = OrderIdAllocator(1, 2).next();
+    if (OrderIdAllocator::epochOf(firstRun) == OrderIdAllocator::epochOf(secondRun)
+        && OrderIdAllocator::counterOf(secondRun) <= OrderIdAllocator::counterOf(firstRun)) {
+        log("TEST 1", "FAILED - restart within the second reissues ids", RED);
+        return false;
+    }
+
+    int threw = 0;
+    try { OrderIdAllocator(256, 0); } catch (const Engine::EngException&) { ++threw; }
+    try { OrderIdAllocator(0, 16); } catch (const Engine::EngException&) { ++threw; }
+    if (threw != 2) {
+        log("TEST 1", "FAILED - out of range prefix accepted", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - 240000 ids unique, prefix decoded, wrap handled", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: ClOrdID map against std::unordered_map
+ *
+ * GIVEN: A ClOrdIdMap sized for 64 entries and a reference std::unordered_map
+ * WHEN:  50000 pseudo-random inserts, lookups and erases over 3 sessions are applied to both
+ * THEN:
+ *   - Every operation gives the same answer while the table grows and entries are erased
+ *   - The same ClOrdID in two sessions maps to two orders
+ */
+bool TEST2_mapMatchesReference() {
+    log("TEST 2", "Testing ClOrdIdMap against std::unordered_map...", CYAN);
+
+    ClOrdIdMap map(64);     // Doubles several times
+    std::unordered_map<std::string, uint64_t> reference;
+    const char* sessions[] = {"BUYER", "SELLER", "#12"};
+    uint64_t rng = 88172645463325252ULL;
+    for (int i = 0; i < 50000; ++i) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        const std::string session = sessions[rng % 3];
+        const std::string clOrdId = "ORD-" + std::to_string((rng >> 8) % 5000);
+        const std::string key = session + '\x01' + clOrdId;
+        switch ((rng >> 40) % 3) {
+        case 0: {
+            const bool added = map.insert(session, clOrdId, static_cast<uint64_t>(i));
+            if (added != reference.emplace(key, static_cast<uint64_t>(i)).second) {
+                log("TEST 2", "FAILED - insert of " + key, RED);
+                return false;
+            }
+            break;
+        }
+        case 1: {
+            const uint64_t* v = map.find(session, clOrdId);
+            const auto it = reference.find(key);
+            if ((v == nullptr) != (it == reference.end()) || (v && *v != it->second)) {
+                log("TEST 2", "FAILED - lookup of " + key, RED);
+                return false;
+            }
+            break;
+        }
+        default:
+            if (map.erase(session, clOrdId) != (reference.erase(key) == 1)) {
+                log("TEST 2", "FAILED - erase of " + key, RED);
+                return false;
+            }
+            break;
+        }
+        if (map.size() != reference.size()) {
+            log("TEST 2", "FAILED - size", RED);
+            return false;
+        }
+    }
+
+    ClOrdIdMap sessionsMap;
+    sessionsMap.insert("BUYER", "1", 10);
+    sessionsMap.insert("SELLER", "1", 20);
+    if (*sessionsMap.find("BUYER", "1") != 10 || *sessionsMap.find("SELLER", "1") != 20
+        || sessionsMap.find("BUYE", "R1") || sessionsMap.find("BUYER", "")) {
+        log("TEST 2", "FAILED - sessions not kept apart", RED);
+        return false;
+    }
+
+    log("TEST 2", "PASSED - " + std::to_string(reference.size()) + " live entries, identical answers", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 3: Lookups and reused slots do not allocate
+ *
+ * GIVEN: A map holding 1000 orders with short ClOrdIDs
+ * WHEN:  Orders are looked up, erased and new ones inserted in their place
+ * THEN:  No heap allocation is made
+ */
+bool TEST3_noAllocation() {
+    log("TEST 3", "Testing ClOrdIdMap steady state...", CYAN);
+
+    ClOrdIdMap map(4096);
+    char id[16];
+    auto clOrdId = [&id](int n) {
+        const auto [end, ec] = std::to_chars(id, id + sizeof(id), n);
+        return std::string_view(id, static_cast<size_t>(end - id));
+    };
+    for (int n = 0; n < 1000; ++n) {
+        map.insert("CLIENT-FIRM-A", clOrdId(n), static_cast<uint64_t>(n));
+    }
+
+    const size_t before = tAllocations;
+    for (int n = 1000; n < 100000; ++n) {
+        if (!map.find("CLIENT-FIRM-A", clOrdId(n - 1000)) || !map.erase("CLIENT-FIRM-A", clOrdId(n - 1000))
+            || !map.insert("CLIENT-FIRM-A", clOrdId(n), static_cast<uint64_t>(n))) {
+            log("TEST 3", "FAILED - order " + std::to_string(n), RED);
+            return false;
+        }
+    }
+    if (tAllocations != before || map.size() != 1000) {
+        log("TEST 3", "FAILED - " + std::to_string(tAllocations - before) + " allocations", RED);
+        return false;
+    }
+
+    log("TEST 3", "PASSED - 99000 lookup / erase / insert rounds without malloc", GREEN);
+    return true;
+}
+
+int main() {
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "            Order Id Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 3;
+
+    if (TEST1_allocator()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_mapMatchesReference()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_noAllocation()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
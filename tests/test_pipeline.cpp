@@ -0,0 +1,257 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Logger.h"
+#include "BlockingQueue/MutexBlockingQueue.h"
+#include "messaging.h"
+#include "Network/FIX.h"
+#include "Network/PacketPool.h"
+#include "Network/TcpEpollListener.h"
+#include "FixMessageDispatcher.h"
+#include "IPC/Consumer.h"
+#include "Shard/ShardRouter.h"
+#include "Scheduler/EngineScheduler.h"
+#include "XMLReader.h"
+#include "Metrics/LatencyTracer.h"
+
+using namespace Exchange;
+using namespace Exchange::Core;
+using namespace Exchange::Matching;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+/**
+ * @brief The three processes of the order path in one: the gateway dispatcher, the
+ * sequencer and the engine side (reader + shards), joined by their shared memory
+ * queues under private names. Built once: the configurations are singletons.
+ */
+class Pipeline : public IExecutionSink {
+public:
+    using RawPacket = Gateway::Network::RawPacket;
+
+    Executions executions;              ///> Merged engine output
+    std::vector<uint64_t> seqNos;       ///> Sequence numbers read by the engine, in order
+    std::optional<Ipc::Msg::LatencyTrace> lastTrace;    ///> Of the last message accepted by the engine
+
+    static Pipeline& instance() {
+        static Pipeline pipeline;
+        return pipeline;
+    }
+
+    ~Pipeline() override {
+        mScheduler.shutdown(mRouter);
+    }
+
+    /**
+     * @brief Dispatches one FIX message, then runs the sequencer and the engine until both are idle.
+     * @param traced Dispatch as the gateway does with tracing on (every message is sampled).
+     */
+    void send(std::string_view fix, bool traced = false) {
+        RawPacket packet;
+        packet.clientSocket = 7;
+        packet.recvTime = TscClock::now();
+        packet.buffer = mPackets.acquire();
+        std::memcpy(packet.buffer.data(), fix.data(), fix.size());
+        packet.length = static_cast<uint32_t>(fix.size());
+        mDispatcher.dispatch(packet, traced ? TscClock::now() : 0);
+
+        mSequencer.poll();
+        while (const uint32_t n = mInbound.read(mBuf.data(), static_cast<uint32_t>(mBuf.size()))) {
+            if (Ipc::Msg::IpcMessage::decode(mBuf.data(), n, mMsg)) {
+                seqNos.push_back(mMsg.getHeader().seqNo);
+                mRouter.accept(mMsg);
+                lastTrace = mMsg.getTrace();
+            }
+        }
+        mRouter.flush();
+    }
+
+    void onExecution(const Execution& exec) override { executions.push_back(exec); }
+
+private:
+    Ipc::SymbolTable mSymbols{{"AAPL", "MSFT"}};
+    Gateway::FixMessageDispatcher mDispatcher;
+    Sequencer::Ipc::Consumer mSequencer;
+    Ipc::Consumer mInbound{"test_pipeline_engine", 4096};
+    ShardRouter mRouter{2, 4096, 0, 64, -1, *this, &mSymbols};
+    EngineScheduler mScheduler{"test_pipeline", 2};
+    Gateway::Network::PacketPool mPackets{4};
+    std::vector<uint8_t> mBuf = std::vector<uint8_t>(Ipc::MAX_MSG_SIZE);
+    Ipc::Msg::IpcMessage mMsg;
+
+    Pipeline() : mDispatcher((initConfig(), std::make_shared<MutexBlockingQueue<RawPacket>>(16)), mSymbols) {
+        mScheduler.start(mRouter);
+    }
+
+    static void initConfig() {
+        const char* configFile = "/tmp/test_pipeline_config.xml";
+        std::ofstream(configFile)
+            << "<Exchange><Gateway><Port>0</Port><BlockingQueue><Size>16</Size></BlockingQueue>"
+            << "<Fix><MaxEventSize>100</MaxEventSize><BacklogSize>100</BacklogSize></Fix>"
+            << "<Ipc><SchedulerQueue>test_pipeline_gateway</SchedulerQueue></Ipc>"
+            << "<LatencyTrace><SampleEvery>1</SampleEvery></LatencyTrace>"
+            << "</Gateway><Sequencer><Port>0</Port><BlockingQueue><Size>16</Size></BlockingQueue>"
+            << "<Ipc><SequencerQueue>test_pipeline_gateway</SequencerQueue>"
+            << "<MatchingEngineQueue>test_pipeline_engine</MatchingEngineQueue></Ipc>"
+            << "</Sequencer></Exchange>";
+        XMLReader reader(configFile);
+        Gateway::Config::init(reader.getNode("Gateway"));
+        Sequencer::Config::init(reader.getNode("Sequencer"));
+        LatencyTracer::instance().setSampleEvery(Gateway::Config::instance().traceSampleEvery());
+    }
+};
+
+/**
+ * @brief Test 1: Gateway -> sequencer -> engine
+ *
+ * GIVEN: The pipeline, two symbols on two shards
+ * WHEN:  FIX orders, a cancel and a replace of two firms are dispatched
+ * THEN:
+ *   - The engine reads every request once, numbered 1, 2, 3... by the sequencer
+ *   - The orders cross, the cancel and the replace reach the resting orders: the
+ *     executions are those of a single book fed the same requests
+ */
+bool TEST1_sequencedToEngine() {
+    log("TEST 1", "Testing FIX dispatch -> sequencer -> shards...", CYAN);
+
+    Pipeline& p = Pipeline::instance();
+    p.send("8=FIX.4.4\x01" "35=D\x01" "49=FIRM-A\x01" "11=A1\x01" "55=AAPL\x01" "54=1\x01"
+           "38=100\x01" "44=50\x01" "40=2\x01" "10=042\x01");
+    p.send("8=FIX.4.4\x01" "35=D\x01" "49=FIRM-B\x01" "11=B1\x01" "55=AAPL\x01" "54=2\x01"
+           "38=40\x01" "44=50\x01" "40=2\x01" "10=042\x01");
+    p.send("8=FIX.4.4\x01" "35=D\x01" "49=FIRM-B\x01" "11=B2\x01" "55=MSFT\x01" "54=2\x01"
+           "38=10\x01" "44=300.25\x01" "40=2\x01" "10=042\x01");
+    p.send("8=FIX.4.4\x01" "35=F\x01" "49=FIRM-A\x01" "11=A2\x01" "41=A1\x01" "55=AAPL\x01" "54=1\x01"
+           "10=042\x01");
+    p.send("8=FIX.4.4\x01" "35=G\x01" "49=FIRM-B\x01" "11=B3\x01" "41=B2\x01" "55=MSFT\x01" "54=2\x01"
+           "38=20\x01" "44=301\x01" "40=2\x01" "10=042\x01");
+
+    if (p.seqNos != std::vector<uint64_t>{1, 2, 3, 4, 5}) {
+        log("TEST 1", "FAILED - engine read " + std::to_string(p.seqNos.size()) + " messages out of sequence", RED);
+        return false;
+    }
+
+    struct Expected {
+        ExecType type;
+        uint64_t seqNo;
+        int64_t price;
+        uint64_t qty;
+        uint64_t leavesQty;
+    };
+    const std::vector<Expected> expected = {
+        {ExecType::ACCEPTED, 1, 500000, 100, 100},
+        {ExecType::ACCEPTED, 2, 500000, 40, 40},
+        {ExecType::TRADE, 2, 500000, 40, 0},
+        {ExecType::ACCEPTED, 3, 3002500, 10, 10},
+        {ExecType::CANCELLED, 4, 500000, 60, 0},
+        {ExecType::REPLACED, 5, 3010000, 20, 20},
+    };
+    const Executions& got = p.executions;
+    bool ok = got.size() == expected.size();
+    for (size_t i = 0; ok && i < expected.size(); ++i) {
+        ok = got[i].type == expected[i].type && got[i].seqNo == expected[i].seqNo
+            && got[i].price == expected[i].price && got[i].qty == expected[i].qty
+            && got[i].leavesQty == expected[i].leavesQty;
+    }
+    if (!ok) {
+        log("TEST 1", "FAILED - " + std::to_string(got.size()) + " executions, not the expected ones", RED);
+        for (const Execution& e : got) {
+            log("TEST 1", "  type=" + std::to_string(static_cast<int>(e.type)) + " seq=" + std::to_string(e.seqNo)
+                + " price=" + std::to_string(e.price) + " qty=" + std::to_string(e.qty)
+                + " leaves=" + std::to_string(e.leavesQty), YELLOW);
+        }
+        return false;
+    }
+
+    log("TEST 1", "PASSED - 5 requests sequenced 1..5, 6 executions in order", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Latency trace of a sampled order
+ *
+ * GIVEN: The pipeline, the gateway tracing every message
+ * WHEN:  A traced NewOrderSingle goes through the gateway, the sequencer and the engine
+ * THEN:
+ *   - The trace reaches the engine with every stage of the path stamped, in order;
+ *     JOURNAL_DURABLE stays empty as there is no journal
+ *   - The engine records its stage and the end-to-end total
+ */
+bool TEST2_traceReachesEngine() {
+    log("TEST 2", "Testing latency trace gateway -> sequencer -> engine...", CYAN);
+
+    using Ipc::Msg::TraceStage;
+    Pipeline& p = Pipeline::instance();
+    LatencyTracer& tracer = LatencyTracer::instance();
+    const uint64_t acks = tracer.stage(TraceStage::ENGINE_ACK).count();
+    p.send("8=FIX.4.4\x01" "35=D\x01" "49=FIRM-A\x01" "11=T1\x01" "55=MSFT\x01" "54=1\x01"
+           "38=5\x01" "44=290\x01" "40=2\x01" "10=042\x01", true);
+
+    if (!p.lastTrace) {
+        log("TEST 2", "FAILED - no trace at the engine", RED);
+        return false;
+    }
+    uint64_t previous = 0;
+    for (TraceStage s : {TraceStage::NIC_READ, TraceStage::DISPATCH, TraceStage::PARSE_DONE, TraceStage::IPC_PUBLISH,
+                         TraceStage::SEQUENCER_READ, TraceStage::ENGINE_ACK}) {
+        const uint64_t ns = p.lastTrace->ns[static_cast<size_t>(s)];
+        if (ns == 0 || ns < previous) {
+            log("TEST 2", std::string("FAILED - stage ") + LatencyTracer::stageName(s) + " not stamped in order", RED);
+            return false;
+        }
+        previous = ns;
+    }
+    if (p.lastTrace->ns[static_cast<size_t>(TraceStage::JOURNAL_DURABLE)] != 0) {
+        log("TEST 2", "FAILED - JOURNAL_DURABLE stamped without a journal", RED);
+        return false;
+    }
+    if (tracer.stage(TraceStage::ENGINE_ACK).count() != acks + 1 || tracer.total().count() == 0) {
+        log("TEST 2", "FAILED - engine stage not recorded", RED);
+        return false;
+    }
+
+    log("TEST 2", "PASSED - NIC_READ..ENGINE_ACK stamped and recorded", GREEN);
+    return true;
+}
+
+int main() {
+    TscClock::calibrate();
+
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "            Pipeline Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 2;
+
+    if (TEST1_sequencedToEngine()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_traceReachesEngine()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,689 @@
+#include <chrono>
+#include <iostream>
+#include <future>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <set>
+#include <stdexcept>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "Exception.h"
+#include "Scheduler.h"
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+// Heap allocations made by the calling thread, to check allocation-free paths
+static thread_local uint64_t tAllocations = 0;
+
+void* operator new(std::size_t size) {
+    ++tAllocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+/**
+ * @brief Test 1: Worker placement from a WorkerSpec
+ *
+ * GIVEN: CPU lists in the kernel format and a worker created with a spec
+ *        (CPU 0, name "spec-worker-long-name")
+ * WHEN:  The lists are parsed and a task runs on the worker
+ * THEN:
+ *   - "0-2, 5,5" parses to {0,1,2,5}, malformed lists throw
+ *   - forIndex() gives shard i the i-th CPU when there is one CPU per shard
+ *   - The task sees its thread pinned to CPU 0 and named with the first 15 chars
+ */
+bool TEST1_workerSpec() {
+    log("TEST 1", "Testing worker placement...", CYAN);
+
+    if (WorkerSpec::parseCpuList("0-2, 5,5") != std::vector<int>{0, 1, 2, 5}) {
+        log("TEST 1", "FAILED - CPU list parsed wrong", RED);
+        return false;
+    }
+    for (const char* bad : {"1-", "a", "3-1", "2x"}) {
+        try {
+            WorkerSpec::parseCpuList(bad);
+            log("TEST 1", std::string("FAILED - '") + bad + "' accepted", RED);
+            return false;
+        }
+        catch (const Engine::EngException&) {}
+    }
+
+    WorkerSpec shards;
+    shards.cpus = {4, 5};
+    shards.name = "me-shard";
+    if (shards.forIndex(1, 2).cpus != std::vector<int>{5} || shards.forIndex(1, 2).name != "me-shard-1"
+        || shards.forIndex(1, 3).cpus != shards.cpus) {
+        log("TEST 1", "FAILED - forIndex()", RED);
+        return false;
+    }
+
+    WorkerSpec spec;
+    spec.cpus = {0};
+    spec.name = "spec-worker-long-name";
+    Scheduler scheduler;
+    scheduler.createWorker("placed", spec);
+    scheduler.start();
+
+    std::promise<std::pair<std::string, int>> seen;
+    scheduler.submitTo("placed", [&seen](const CancelToken&) {
+        char name[16] = {};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        seen.set_value({name, CPU_ISSET(0, &set) ? CPU_COUNT(&set) : -1});
+    });
+    const auto [name, cpus] = seen.get_future().get();
+    scheduler.shutdown();
+
+    if (name != "spec-worker-lon" || cpus != 1) {
+        log("TEST 1", "FAILED - Thread '" + name + "' allowed on " + std::to_string(cpus) + " CPUs", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - Worker '" + name + "' pinned to CPU 0", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Lock-free submission by handle
+ *
+ * GIVEN: One worker and 4 producer threads holding its WorkerHandle
+ * WHEN:  Each producer submits 50000 tasks, more than the ring holds, then the
+ *        worker is left idle long enough to park and one more task is submitted
+ * THEN:
+ *   - Every task runs exactly once, in submission order per producer
+ *   - The parked worker is woken by the late submission
+ *   - The worker bookkeeping is bounded: nothing pending, all tasks completed
+ */
+bool TEST2_mpscSubmission() {
+    log("TEST 2", "Testing MPSC submission...", CYAN);
+
+    constexpr int producers = 4;
+    constexpr uint64_t perProducer = 50000;
+    Scheduler scheduler;
+    const WorkerHandle w = scheduler.createWorker("mpsc");
+    scheduler.start();
+
+    // Only the worker thread touches these
+    uint64_t next[producers] = {};
+    bool ordered = true;
+
+    std::vector<std::thread> threads;
+    std::vector<double> nsPerSubmit(producers);
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            const auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                scheduler.submitTo(w, [&next, &ordered, p, i](const CancelToken&) {
+                    ordered = ordered && next[p] == i;
+                    next[p] = i + 1;
+                });
+            }
+            nsPerSubmit[p] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                / perProducer;
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::promise<void> woken;
+    scheduler.submitTo(w, [&woken](const CancelToken&) { woken.set_value(); });
+    const bool wakeUp = woken.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+
+    // mCompleted is bumped right after the task returns
+    Worker* worker = scheduler.getWorker(w);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (worker->mCompleted.load() != producers * perProducer + 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    const uint64_t completed = worker->mCompleted.load();
+    const size_t pending = worker->pending();
+    scheduler.shutdown();
+
+    bool all = true;
+    for (int p = 0; p < producers; ++p) {
+        all = all && next[p] == perProducer;
+    }
+    if (!all || !ordered || !wakeUp || completed != producers * perProducer + 1 || pending != 0) {
+        log("TEST 2", std::string("FAILED - all=") + (all ? "yes" : "no") + " ordered=" + (ordered ? "yes" : "no")
+            + " woken=" + (wakeUp ? "yes" : "no") + " completed=" + std::to_string(completed), RED);
+        return false;
+    }
+
+    double avg = 0;
+    for (double ns : nsPerSubmit) {
+        avg += ns / producers;
+    }
+    log("TEST 2", "PASSED - " + std::to_string(producers * perProducer) + " tasks in order, "
+        + std::to_string(static_cast<int>(avg)) + " ns per submit (incl. waits on a full ring)", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 3: Allocation-free tasks and lazy cancel tokens
+ *
+ * GIVEN: A worker which is not started yet, so the tasks stay queued
+ * WHEN:  1000 fire-and-forget tasks capturing 48 bytes are submitted by handle,
+ *        then one more with a cancel token which is cancelled before start()
+ * THEN:
+ *   - The 1000 submissions perform no heap allocation
+ *   - Only the cancellable task allocates its token, and it never runs
+ *   - Every other task runs with its captures intact
+ */
+bool TEST3_allocationFree() {
+    log("TEST 3", "Testing allocation-free submission...", CYAN);
+
+    Scheduler scheduler;
+    const WorkerHandle w = scheduler.createWorker("inplace");
+
+    struct Payload { uint64_t v[6]; };
+    uint64_t sum = 0;
+    const uint64_t before = tAllocations;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        Payload p{{i, i, i, i, i, i}};
+        scheduler.submitTo(w, [&sum, p](const CancelToken&) { sum += p.v[0] + p.v[5]; }, "sum");
+    }
+    const uint64_t submitAllocations = tAllocations - before;
+
+    bool ran = false;
+    CancelToken token = CancelToken::create();
+    const uint64_t tokenAllocations = tAllocations - before - submitAllocations;
+    scheduler.submitTo(w, [&ran](const CancelToken&) { ran = true; }, "cancelled", token);
+    token.cancel();
+
+    scheduler.start();
+    scheduler.shutdown();
+
+    if (submitAllocations != 0 || tokenAllocations != 1 || ran || sum != 999 * 1000) {
+        log("TEST 3", "FAILED - allocations=" + std::to_string(submitAllocations) + " token="
+            + std::to_string(tokenAllocations) + " cancelled ran=" + (ran ? "yes" : "no")
+            + " sum=" + std::to_string(sum), RED);
+        return false;
+    }
+
+    log("TEST 3", "PASSED - 1000 submissions, 0 allocations, sizeof(Task)=" + std::to_string(sizeof(Task)), GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 4: Work-stealing pool
+ *
+ * GIVEN: A scheduler with a pinned worker on CPU 0 and a 4 thread pool
+ * WHEN:  1000 tasks are submitted from outside, each spawning 10 sub-tasks on its
+ *        own deque, then a parallelFor covers 1000000 indices and another throws
+ * THEN:
+ *   - The pool avoids the pinned worker's CPU when the process has others
+ *   - Every task and sub-task runs exactly once, spread over the pool threads
+ *   - parallelFor visits every index once and rethrows the body's exception
+ */
+bool TEST4_workStealingPool() {
+    log("TEST 4", "Testing work-stealing pool...", CYAN);
+
+    WorkerSpec pinned;
+    pinned.cpus = {0};
+    Scheduler scheduler;
+    scheduler.createWorker("hot", pinned);
+    WorkStealingPool& pool = scheduler.createPool(4);
+    const std::vector<int> spare = WorkStealingPool::spareCpus({0});
+    scheduler.start();
+
+    std::atomic<uint64_t> tasks{0};
+    std::atomic<uint64_t> subTasks{0};
+    std::mutex threadsMutex;
+    std::set<std::thread::id> threads;
+    for (int i = 0; i < 1000; ++i) {
+        scheduler.submit([&](const CancelToken&) {
+            tasks.fetch_add(1);
+            for (int j = 0; j < 10; ++j) {
+                scheduler.submit([&](const CancelToken&) {
+                    subTasks.fetch_add(1);
+                    std::lock_guard<std::mutex> lock(threadsMutex);
+                    threads.insert(std::this_thread::get_id());
+                });
+            }
+        });
+    }
+
+    std::vector<uint8_t> visits(1000000, 0);
+    scheduler.parallelFor(0, visits.size(), 4096, [&visits](size_t i) { visits[i]++; });
+    bool rethrown = false;
+    try {
+        scheduler.parallelFor(0, 100, 10, [](size_t i) {
+            if (i == 57) {
+                throw std::runtime_error("body failed");
+            }
+        });
+    }
+    catch (const std::runtime_error&) {
+        rethrown = true;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (subTasks.load() != 10000 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    scheduler.shutdown();
+
+    const bool avoided = spare == std::vector<int>{0} || std::find(spare.begin(), spare.end(), 0) == spare.end();
+    const bool once = std::all_of(visits.begin(), visits.end(), [](uint8_t v) { return v == 1; });
+    if (pool.size() != 4 || !avoided || tasks.load() != 1000 || subTasks.load() != 10000 || !once || !rethrown) {
+        log("TEST 4", "FAILED - tasks=" + std::to_string(tasks.load()) + " subTasks=" + std::to_string(subTasks.load())
+            + " parallelFor=" + (once ? "ok" : "wrong") + " rethrown=" + (rethrown ? "yes" : "no")
+            + " spare=" + (avoided ? "ok" : "wrong"), RED);
+        return false;
+    }
+
+    log("TEST 4", "PASSED - 11000 tasks on " + std::to_string(threads.size()) + " threads (pool + helping caller), "
+        + std::to_string(visits.size()) + " indices visited once", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 5: Futures of worker tasks
+ *
+ * GIVEN: A started worker "control"
+ * WHEN:  Tasks are submitted with submitToWithFuture(): one computing a value from
+ *        its arguments, one throwing, one cancelled before start, and continuations
+ *        are chained with then() before and after the results are set
+ * THEN:
+ *   - get() returns the value; a submission performs a single allocation
+ *   - then() runs on the worker when chained early, inline when chained late
+ *   - An exception skips the continuations and is rethrown by get()
+ *   - A cancelled task and a dropped promise break their futures instead of hanging
+ */
+bool TEST5_futures() {
+    log("TEST 5", "Testing futures...", CYAN);
+
+    Scheduler scheduler;
+    const WorkerHandle w = scheduler.createWorker("control");
+    CancelToken token = CancelToken::create();
+    Future<void> cancelled = scheduler.submitToWithFuture(w, token, [] {});
+    token.cancel();
+    scheduler.start();
+
+    const uint64_t before = tAllocations;
+    Future<int> sum = scheduler.submitToWithFuture(w, [](int a, int b) { return a + b; }, 40, 2);
+    const uint64_t submitAllocations = tAllocations - before;
+    const bool value = sum.get() == 42;
+
+    // Chained while the worker is still busy: the continuation runs on the worker
+    std::atomic<bool> release{false};
+    Future<std::thread::id> slow = scheduler.submitToWithFuture("control", [&release] {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+        return std::this_thread::get_id();
+    });
+    Future<bool> onWorker = std::move(slow).then([](std::thread::id producer) {
+        return producer == std::this_thread::get_id();
+    });
+    release.store(true);
+    const bool early = onWorker.get();
+
+    // Chained once ready: the continuation runs right away, on the caller
+    Future<int> ready = scheduler.submitToWithFuture(w, [] { return 7; });
+    ready.wait();
+    bool inlineRun = false;
+    Future<std::string> late = std::move(ready).then([&inlineRun](int v) {
+        inlineRun = true;
+        return std::to_string(v);
+    });
+    const bool lateOk = inlineRun && late.get() == "7";
+
+    bool skipped = true;
+    Future<void> failing = scheduler.submitToWithFuture(w, []() -> int { throw std::runtime_error("boom"); })
+        .then([&skipped](int) { skipped = false; });
+    bool rethrown = false;
+    try {
+        failing.get();
+    }
+    catch (const std::runtime_error& e) {
+        rethrown = std::string(e.what()) == "boom";
+    }
+
+    auto broken = [](auto& future) {
+        try {
+            future.get();
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    Future<int> dropped;
+    {
+        Promise<int> promise;
+        dropped = promise.getFuture();
+    }
+    const bool cancelledBroken = broken(cancelled);
+    const bool droppedBroken = broken(dropped);
+    scheduler.shutdown();
+
+    if (!value || submitAllocations != 1 || !early || !lateOk || !skipped || !rethrown || !cancelledBroken || !droppedBroken) {
+        log("TEST 5", std::string("FAILED - value=") + (value ? "ok" : "wrong") + " allocations="
+            + std::to_string(submitAllocations) + " early=" + (early ? "ok" : "wrong") + " late=" + (lateOk ? "ok" : "wrong")
+            + " skipped=" + (skipped ? "yes" : "no") + " rethrown=" + (rethrown ? "yes" : "no")
+            + " cancelled=" + (cancelledBroken ? "broken" : "hangs") + " dropped=" + (droppedBroken ? "broken" : "hangs"), RED);
+        return false;
+    }
+
+    log("TEST 5", "PASSED - 1 allocation per submission, continuations and errors propagated", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 6: Coroutines on workers
+ *
+ * GIVEN: Two started workers "session" and "recovery"
+ * WHEN:  A coroutine is spawned on "session" which awaits 1000 child coroutines,
+ *        sleeps 5 ms, waits for a message polled from a source filled later by the
+ *        main thread, catches a child's exception and moves to "recovery"
+ * THEN:
+ *   - The children's results come back; after the first one their frames are
+ *     recycled by the FramePool without heap allocation
+ *   - The sleep lasts at least 5 ms and other tasks run on the worker meanwhile
+ *   - The message is received once published, the exception is caught
+ *   - The coroutine ends on the "recovery" thread, and sleeping outside a worker throws
+ */
+static Co<int> square(int v) {
+    co_return v * v;
+}
+
+static Co<int> failing() {
+    throw std::runtime_error("resend failed");
+    co_return 0;
+}
+
+struct FakeSource {
+    std::atomic<bool> published{false};
+    uint32_t read(void* buffer, uint32_t size) {
+        if (!published.load() || size < 5) {
+            return 0;
+        }
+        std::memcpy(buffer, "LOGON", 5);
+        published.store(false);
+        return 5;
+    }
+};
+
+struct SessionResult {
+    long sum{0};
+    uint64_t childAllocations{~0ULL};
+    uint64_t sleptNs{0};
+    bool ranWhileSleeping{false};
+    std::string message;
+    bool caught{false};
+    std::thread::id sessionThread;
+    std::thread::id endThread;
+    std::atomic<bool> done{false};
+};
+
+static Co<void> session(Scheduler* scheduler, WorkerHandle recovery, FakeSource* source, SessionResult* r,
+                        std::atomic<bool>* otherTask) {
+    r->sessionThread = std::this_thread::get_id();
+
+    r->sum += co_await square(1);
+    const uint64_t before = tAllocations;
+    for (int i = 2; i <= 1000; ++i) {
+        r->sum += co_await square(i);
+    }
+    r->childAllocations = tAllocations - before;
+
+    const uint64_t start = Exchange::Core::TscClock::now();
+    co_await sleepFor(std::chrono::milliseconds(5));
+    r->sleptNs = Exchange::Core::TscClock::now() - start;
+    r->ranWhileSleeping = otherTask->load();
+
+    char buffer[16];
+    const uint32_t bytes = co_await nextMessage(*source, buffer, sizeof(buffer));
+    r->message.assign(buffer, bytes);
+
+    try {
+        co_await failing();
+    }
+    catch (const std::runtime_error&) {
+        r->caught = true;
+    }
+
+    co_await scheduler->schedule(recovery);
+    r->endThread = std::this_thread::get_id();
+    r->done.store(true);
+}
+
+static Co<void> sleepOutsideWorker() {
+    co_await sleepFor(std::chrono::milliseconds(1));
+}
+
+bool TEST6_coroutines() {
+    log("TEST 6", "Testing coroutines...", CYAN);
+
+    Scheduler scheduler;
+    const WorkerHandle sessionWorker = scheduler.createWorker("session");
+    const WorkerHandle recoveryWorker = scheduler.createWorker("recovery");
+    scheduler.start();
+
+    FakeSource source;
+    SessionResult r;
+    std::atomic<bool> otherTask{false};
+    scheduler.spawn(sessionWorker, session(&scheduler, recoveryWorker, &source, &r, &otherTask));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    scheduler.submitTo(sessionWorker, [&otherTask](const CancelToken&) { otherTask.store(true); }, "other");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    source.published.store(true);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!r.done.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    scheduler.shutdown();
+
+    bool outsideThrows = false;
+    {
+        Co<void> outer = []() -> Co<void> {
+            co_await sleepOutsideWorker();
+        }();
+        auto h = outer.release();
+        h.resume();
+        outsideThrows = h.done() && h.promise().error != nullptr;
+        h.destroy();
+    }
+
+    long expected = 0;
+    for (long i = 1; i <= 1000; ++i) {
+        expected += i * i;
+    }
+    const bool moved = r.endThread != r.sessionThread && r.endThread != std::thread::id();
+    if (!r.done.load() || r.sum != expected || r.childAllocations != 0 || r.sleptNs < 5'000'000 || !r.ranWhileSleeping
+        || r.message != "LOGON" || !r.caught || !moved || !outsideThrows) {
+        log("TEST 6", "FAILED - done=" + std::string(r.done.load() ? "yes" : "no") + " sum=" + std::to_string(r.sum)
+            + " allocations=" + std::to_string(r.childAllocations) + " slept=" + std::to_string(r.sleptNs)
+            + " other=" + (r.ranWhileSleeping ? "yes" : "no") + " message=" + r.message
+            + " caught=" + (r.caught ? "yes" : "no") + " moved=" + (moved ? "yes" : "no")
+            + " outside=" + (outsideThrows ? "throws" : "wrong"), RED);
+        return false;
+    }
+
+    log("TEST 6", "PASSED - 1000 awaited children with 0 allocations, slept "
+        + std::to_string(r.sleptNs / 1000) + " us without blocking the worker", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 7: Hierarchical timer wheel
+ *
+ * GIVEN: A wheel with 1 ms ticks driven by synthetic time, and a started worker
+ * WHEN:  20000 timers due over the next 100 s (cascading through three wheels) and
+ *        one due in 60 days are scheduled, half of them cancelled, and time advances
+ *        in irregular steps; a periodic timer cancels itself from its 50th call; then a
+ *        task arms a 3 ms timer on the worker's own wheel
+ * THEN:
+ *   - Every remaining timer fires once, never early and at most one step late,
+ *     cancelled ones never; stale ids cannot cancel
+ *   - Re-arming 20000 timers after the first round performs no allocation
+ *   - The periodic timer fires exactly 50 times
+ *   - The worker fires its timer on time, from its own thread
+ */
+bool TEST7_timerWheel() {
+    log("TEST 7", "Testing timer wheel...", CYAN);
+
+    constexpr uint64_t MS = 1'000'000;
+    const uint64_t t0 = 1'700'000'000'000'000'000ULL;
+    TimerWheel wheel(MS, t0);
+
+    constexpr int N = 20000;
+    std::vector<uint64_t> deadline(N);
+    std::vector<uint64_t> firedAt(N, 0);
+    std::vector<int> fired(N, 0);
+    std::vector<TimerId> ids(N);
+    uint64_t now = t0;
+    uint64_t x = 88172645463325252ULL;
+    auto rnd = [&x]() { x ^= x << 13; x ^= x >> 7; x ^= x << 17; return x; };
+
+    uint64_t rearmAllocations = 0;
+    bool exact = true;
+    bool stale = true;
+    for (int round = 0; round < 2 && exact; ++round) {
+        std::fill(fired.begin(), fired.end(), 0);
+        const uint64_t before = tAllocations;
+        for (int i = 0; i < N; ++i) {
+            deadline[i] = now + rnd() % (100'000 * MS);
+            ids[i] = wheel.schedule(deadline[i], [&fired, &firedAt, &now, i] { ++fired[i]; firedAt[i] = now; });
+        }
+        for (int i = 0; i < N; i += 2) {
+            wheel.cancel(ids[i]);
+        }
+        if (round == 1) {
+            rearmAllocations = tAllocations - before;
+        }
+        const uint64_t end = now + 101'000 * MS;
+        uint64_t maxStep = 0;
+        while (now < end) {
+            const uint64_t step = 1 + rnd() % (300 * MS);
+            maxStep = std::max(maxStep, step);
+            now += step;
+            wheel.advance(now);
+        }
+        for (int i = 0; i < N; ++i) {
+            const bool expected = (i % 2) == 1;
+            exact = exact && fired[i] == (expected ? 1 : 0);
+            exact = exact && (!expected || (firedAt[i] >= deadline[i] && firedAt[i] - deadline[i] <= maxStep + MS));
+        }
+        stale = stale && !wheel.cancel(ids[1]) && !wheel.cancel(ids[0]);
+    }
+
+    bool farFired = false;
+    wheel.schedule(now + 60ULL * 86'400'000 * MS, [&farFired] { farFired = true; });
+    int periodic = 0;
+    TimerId self = 0;
+    self = wheel.scheduleEvery(now + 10 * MS, 10 * MS, [&] {
+        if (++periodic == 50) {
+            wheel.cancel(self);
+        }
+    });
+    for (int i = 0; i < 2000; ++i) {
+        now += MS;
+        wheel.advance(now);
+    }
+    const bool farPending = !farFired && wheel.size() == 1;
+    now += 61ULL * 86'400'000 * MS;
+    wheel.advance(now);
+
+    Scheduler scheduler;
+    const WorkerHandle w = scheduler.createWorker("timers");
+    scheduler.start();
+    std::atomic<uint64_t> workerLate{0};
+    std::atomic<bool> workerFired{false};
+    std::atomic<bool> onWorker{false};
+    const uint64_t armedAt = Exchange::Core::TscClock::now();
+    scheduler.submitTo(w, [&](const CancelToken&) {
+        Worker* self = Worker::current();
+        self->timers().schedule(armedAt + 3 * MS, [&, self] {
+            workerLate = Exchange::Core::TscClock::now() - armedAt;
+            onWorker = Worker::current() == self;
+            workerFired = true;
+        });
+    }, "arm");
+    const auto waitUntil = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!workerFired.load() && std::chrono::steady_clock::now() < waitUntil) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    scheduler.shutdown();
+
+    if (!exact || !stale || rearmAllocations != 0 || !farPending || !farFired || periodic != 50 || !wheel.empty()
+        || !workerFired.load() || !onWorker.load() || workerLate.load() < 3 * MS) {
+        log("TEST 7", std::string("FAILED - exact=") + (exact ? "yes" : "no") + " stale=" + (stale ? "ok" : "wrong")
+            + " allocations=" + std::to_string(rearmAllocations) + " far=" + (farPending && farFired ? "ok" : "wrong")
+            + " periodic=" + std::to_string(periodic) + " left=" + std::to_string(wheel.size())
+            + " worker=" + (workerFired.load() && onWorker.load() ? "ok" : "wrong"), RED);
+        return false;
+    }
+
+    log("TEST 7", "PASSED - " + std::to_string(N) + " timers x2 exact, 0 allocations re-arming, worker timer after "
+        + std::to_string(workerLate.load() / 1000) + " us", GREEN);
+    return true;
+}
+
+int main() {
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "            Scheduler Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 7;
+
+    if (TEST1_workerSpec()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_mpscSubmission()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_allocationFree()) passed++;
+    std::cout << std::endl;
+
+    if (TEST4_workStealingPool()) passed++;
+    std::cout << std::endl;
+
+    if (TEST5_futures()) passed++;
+    std::cout << std::endl;
+
+    if (TEST6_coroutines()) passed++;
+    std::cout << std::endl;
+
+    if (TEST7_timerWheel()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Logger.h"
+#include "String.h"
+#include "Network/FIX.h"
+
+#include "AllocationCounter.h"
+
+using namespace Exchange;
+using namespace Exchange::Core;
+using Gateway::Network::Fix;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+/**
+ * @brief Test 1: Small-string boundary
+ *
+ * GIVEN: Strings of 0, 23 and 24 characters
+ * WHEN:  They are built, copied and grown
+ * THEN:
+ *   - Up to 23 characters no allocation happens and the capacity is the inline one
+ *   - 24 characters take exactly one allocation
+ *   - Every string stays null-terminated with the right size
+ */
+bool TEST1_smallStringBoundary() {
+    log("TEST 1", "Testing the inline buffer boundary...", CYAN);
+
+    const std::string s23(23, 'a');
+    const std::string s24(24, 'b');
+
+    size_t before = tAllocations;
+    String empty;
+    String small(s23.c_str());
+    String copy(small);
+    copy.clear();
+    copy.append("xyz");
+    if (tAllocations != before) {
+        log("TEST 1", "FAILED - allocation for an inline string", RED);
+        return false;
+    }
+    if (!empty.empty() || empty.get()[0] != '\0' || empty != "" || small.size() != 23 ||
+        small.capacity() != String::INLINE_CAPACITY || small.get()[23] != '\0' || small.view() != s23 ||
+        copy != "xyz") {
+        log("TEST 1", "FAILED - wrong inline content", RED);
+        return false;
+    }
+
+    before = tAllocations;
+    String large(s24);
+    if (tAllocations != before + 1 || large.size() != 24 || large.get()[24] != '\0' || large.toString() != s24) {
+        log("TEST 1", "FAILED - heap string needs exactly one allocation", RED);
+        return false;
+    }
+
+    small.append('c');
+    if (small.size() != 24 || small.capacity() < 46 || small.view() != s23 + "c") {
+        log("TEST 1", "FAILED - growth past the inline buffer", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - 23 characters inline, 24 on the heap", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Value semantics
+ *
+ * GIVEN: Inline and heap strings
+ * WHEN:  They are moved, assigned, swapped, appended to themselves and compared
+ * THEN:
+ *   - Moves never allocate and leave the source empty
+ *   - Assignment reuses a large enough buffer
+ *   - Self-append, find, compare and at() behave like std::string
+ */
+bool TEST2_valueSemantics() {
+    log("TEST 2", "Testing copy, move, append and compare...", CYAN);
+
+    String heap("a string well past the inline capacity");
+    String inl("short");
+
+    size_t before = tAllocations;
+    String moved(std::move(heap));
+    heap = std::move(inl);
+    moved.swap(heap);
+    if (tAllocations != before || heap.size() != 38 || moved != "short" || !inl.empty()) {
+        log("TEST 2", "FAILED - move or swap", RED);
+        return false;
+    }
+
+    before = tAllocations;
+    heap = "reused buffer";
+    heap = moved;
+    if (tAllocations != before || heap != "short") {
+        log("TEST 2", "FAILED - assignment should reuse the buffer", RED);
+        return false;
+    }
+
+    String twice("0123456789abcdef");
+    twice.append(twice);
+    twice += twice.get();
+    if (twice.view() != "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef") {
+        log("TEST 2", "FAILED - self-append", RED);
+        return false;
+    }
+
+    const String joined = String("BUY ") + "100 " + std::string("AAPL") + '@' + String(3, '9');
+    if (joined != "BUY 100 AAPL@999" || joined.find("AAPL") != 8 || joined.find('@') != 12 ||
+        joined.find('x') != String::npos || joined.find("BUY", 1) != String::npos) {
+        log("TEST 2", "FAILED - concatenation or find", RED);
+        return false;
+    }
+
+    if (String("abc").compare("abd") >= 0 || String("abc").compare("ab") <= 0 ||
+        String().compare(static_cast<const char*>(nullptr)) != 0 || String("b").compare(std::string("a")) <= 0) {
+        log("TEST 2", "FAILED - compare", RED);
+        return false;
+    }
+
+    bool threw = false;
+    try {
+        (void)joined.at(joined.size());
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    if (!threw || joined.at(0) != 'B' || joined.back() != '9' || String().back() != '\0') {
+        log("TEST 2", "FAILED - element access", RED);
+        return false;
+    }
+
+    log("TEST 2", "PASSED - moves and reused assignments do not allocate", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 3: Arena strings
+ *
+ * GIVEN: ArenaStrings above the inline capacity, built and dropped on one thread
+ * WHEN:  The same sizes are built again once the arena is warm
+ * THEN:
+ *   - No further heap allocation happens
+ *   - Content converts to and from String and std::string_view
+ */
+bool TEST3_arenaString() {
+    log("TEST 3", "Testing ArenaString block reuse...", CYAN);
+
+    const std::string filler(200, 'x');
+    auto churn = [&filler] {
+        for (int i = 0; i < 1000; ++i) {
+            ArenaString s("Execution report for order ");
+            s += std::string_view("ORD-0000000001");
+            s.append(' ');
+            s += filler;
+            if (s.size() != 242) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    churn();  // Warm-up
+    const size_t before = tAllocations;
+    const bool ok = churn();
+    if (!ok || tAllocations != before) {
+        log("TEST 3", "FAILED - " + std::to_string(tAllocations - before) + " allocations after warm-up", RED);
+        return false;
+    }
+
+    const ArenaString arena("converted between allocators, past the inline size");
+    const String heap(arena);
+    const std::string_view view = heap;
+    if (view != arena.view() || ArenaString(heap) != arena) {
+        log("TEST 3", "FAILED - conversion", RED);
+        return false;
+    }
+
+    log("TEST 3", "PASSED - 1000 arena strings without allocation", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 4: FIX parsing in place
+ *
+ * GIVEN: A New Order Single and a message with a malformed price
+ * WHEN:  They are parsed
+ * THEN:
+ *   - The order is parsed without any allocation
+ *   - The malformed price marks the message invalid
+ */
+bool TEST4_fixParseNoAllocation() {
+    log("TEST 4", "Testing FIX parsing without allocation...", CYAN);
+
+    const std::string order = "8=FIX.4.4\x01" "9=120\x01" "35=D\x01" "11=CLORD-000000017\x01" "55=AAPL\x01"
+                              "54=1\x01" "38=250\x01" "44=187.25\x01" "40=2\x01" "59=3\x01" "10=042\x01";
+
+    const size_t before = tAllocations;
+    const Fix::FixMsg msg = Fix::parseFix(order);
+    if (tAllocations != before) {
+        log("TEST 4", "FAILED - parseFix() allocated", RED);
+        return false;
+    }
+    if (!msg.isValid || msg.msgType != "D" || msg.clOrdId != "CLORD-000000017" || msg.symbol != "AAPL" ||
+        msg.side != "1" || msg.quantity != 250 || msg.price != 187.25 || msg.ordType != Order::Type::LIMIT ||
+        msg.tif != Order::TIF::IMMEDIATE_OR_CANCEL) {
+        log("TEST 4", "FAILED - wrong fields", RED);
+        return false;
+    }
+
+    if (Fix::parseFix("35=D\x01" "55=AAPL\x01" "44=12.5x\x01" "38=10\x01").isValid ||
+        Fix::parseFix("35=D\x01" "38=\x01").isValid) {
+        log("TEST 4", "FAILED - malformed numbers accepted", RED);
+        return false;
+    }
+
+    log("TEST 4", "PASSED - order parsed in place", GREEN);
+    return true;
+}
+
+int main() {
+    // TRACE output of parseFix() would allocate in debug builds
+    Logger::setLevel(LogModule::GATEWAY, LogLevel::INFO);
+
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "            String Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 4;
+
+    if (TEST1_smallStringBoundary()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_valueSemantics()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_arenaString()) passed++;
+    std::cout << std::endl;
+
+    if (TEST4_fixParseNoAllocation()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/mman.h>
+
+#include "SymbolTable.h"
+#include "Exception.h"
+
+using namespace Exchange;
+using Ipc::SymbolTable;
+
+// ANSI color codes for better visibility
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define MAGENTA "\033[35m"
+#define CYAN    "\033[36m"
+
+void log(const std::string& prefix, const std::string& msg, const std::string& color = RESET) {
+    std::cout << color << "[" << prefix << "] " << msg << RESET << std::endl;
+}
+
+static std::vector<std::string> makeSymbols(size_t n) {
+    std::vector<std::string> symbols;
+    for (size_t i = 0; i < n; ++i) {
+        std::string s;
+        for (size_t v = i; ; v /= 26) {
+            s += static_cast<char>('A' + v % 26);
+            if (v < 26) break;
+        }
+        symbols.push_back(s + ".X");
+    }
+    return symbols;
+}
+
+/**
+ * @brief Test 1: Perfect hash lookups
+ *
+ * GIVEN: A table of 5000 generated tickers
+ * WHEN:  Every ticker, and close variants of them, are looked up
+ * THEN:
+ *   - Every ticker resolves to its position in the list, and name() returns it back
+ *   - Variants (prefix, suffix, other case, too long) resolve to NONE
+ */
+bool TEST1_perfectHash() {
+    log("TEST 1", "Testing ticker -> id lookups...", CYAN);
+
+    const std::vector<std::string> symbols = makeSymbols(5000);
+    const SymbolTable table(symbols);
+    if (table.size() != symbols.size()) {
+        log("TEST 1", "FAILED - size " + std::to_string(table.size()), RED);
+        return false;
+    }
+    for (uint32_t id = 0; id < symbols.size(); ++id) {
+        const std::string& s = symbols[id];
+        if (table.find(s) != id || table.name(id) != s) {
+            log("TEST 1", "FAILED - wrong id for " + s, RED);
+            return false;
+        }
+        if (table.find(s.substr(0, s.size() - 1)) != SymbolTable::NONE || table.find(s + "Y") != SymbolTable::NONE
+            || table.find("x" + s.substr(1)) != SymbolTable::NONE) {
+            log("TEST 1", "FAILED - variant of " + s + " resolved", RED);
+            return false;
+        }
+    }
+    if (table.find("") != SymbolTable::NONE || table.find(std::string(40, 'A')) != SymbolTable::NONE
+        || SymbolTable().find("AAPL") != SymbolTable::NONE) {
+        log("TEST 1", "FAILED - empty, long or empty-table lookup resolved", RED);
+        return false;
+    }
+
+    log("TEST 1", "PASSED - 5000 tickers resolved, variants rejected", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 2: Invalid configurations
+ *
+ * GIVEN: Lists with a duplicate, an empty and a 17 character ticker
+ * WHEN:  Tables are built from them
+ * THEN:  Each build throws
+ */
+bool TEST2_invalidSymbols() {
+    log("TEST 2", "Testing rejected symbol lists...", CYAN);
+
+    const std::vector<std::vector<std::string>> invalid = {
+        {"AAPL", "MSFT", "AAPL"},
+        {"AAPL", ""},
+        {"AAPL", std::string(17, 'Z')},
+    };
+    for (const auto& symbols : invalid) {
+        bool threw = false;
+        try {
+            SymbolTable table(symbols);
+        } catch (const Engine::EngException&) {
+            threw = true;
+        }
+        if (!threw) {
+            log("TEST 2", "FAILED - invalid list accepted", RED);
+            return false;
+        }
+    }
+
+    log("TEST 2", "PASSED - duplicates, empty and long tickers rejected", GREEN);
+    return true;
+}
+
+/**
+ * @brief Test 3: Shared memory publication
+ *
+ * GIVEN: A table published in a shared memory segment
+ * WHEN:  The segment is opened read-only, as another process would
+ * THEN:
+ *   - The opened table gives the same ids as a table built in process memory
+ *   - Opening a segment which was never published throws
+ */
+bool TEST3_publishAndOpen() {
+    log("TEST 3", "Testing publish() / open()...", CYAN);
+
+    const std::vector<std::string> symbols = {"AAPL", "MSFT", "GOOG", "AMZN", "TSLA", "BRK.B"};
+    const Core::String name = "EXCHANGE_SYMBOLS_TEST";
+    const SymbolTable local(symbols);
+    {
+        const SymbolTable published = SymbolTable::publish(name, symbols);
+        SymbolTable opened = SymbolTable::open(name);
+        for (const std::string& s : symbols) {
+            if (opened.find(s) != local.find(s) || published.find(s) != local.find(s)) {
+                log("TEST 3", "FAILED - ids differ for " + s, RED);
+                return false;
+            }
+        }
+        SymbolTable moved(std::move(opened));
+        if (moved.find("BRK.B") != 5 || !opened.empty()) {
+            log("TEST 3", "FAILED - move", RED);
+            return false;
+        }
+    }
+    ::shm_unlink(name.get());
+
+    bool threw = false;
+    try {
+        SymbolTable::open("EXCHANGE_SYMBOLS_MISSING");
+    } catch (const Engine::EngException&) {
+        threw = true;
+    }
+    if (!threw) {
+        log("TEST 3", "FAILED - missing segment opened", RED);
+        return false;
+    }
+
+    log("TEST 3", "PASSED - published table readable with identical ids", GREEN);
+    return true;
+}
+
+int main() {
+    std::cout << "\n" << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << MAGENTA << "          Symbol Table Tests" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << "\n" << std::endl;
+
+    int passed = 0;
+    int total = 3;
+
+    if (TEST1_perfectHash()) passed++;
+    std::cout << std::endl;
+
+    if (TEST2_invalidSymbols()) passed++;
+    std::cout << std::endl;
+
+    if (TEST3_publishAndOpen()) passed++;
+    std::cout << std::endl;
+
+    // Summary
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+    std::cout << "Test Results: " << (passed == total ? GREEN : RED)
+              << passed << "/" << total << " passed" << RESET << std::endl;
+    std::cout << MAGENTA << "========================================" << RESET << std::endl;
+
+    return (passed == total) ? 0 : 1;
+}
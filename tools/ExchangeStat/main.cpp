@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "Metrics/Metrics.h"
+
+using namespace Exchange::Core;
+
+/**
+ * @brief Prints the live metrics of an exchange process (see MetricsRegistry): counters
+ * with their rate over the refresh interval, gauges, and histogram percentiles.
+ * The segment is mapped read-only, the observed process is never slowed down.
+ *
+ * Usage: exchange-stat <process> [interval-ms] [refreshes]
+ *   process:     Gateway, Sequencer, MatchingEngine (the config.xml node name)
+ *   interval-ms: refresh period, default 1000
+ *   refreshes:   number of refreshes, default 0 = until interrupted
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 4) {
+        std::fprintf(stderr, "Usage: %s <process> [interval-ms] [refreshes]\n", argv[0]);
+        return 2;
+    }
+    const long intervalMs = argc > 2 ? std::atol(argv[2]) : 1000;
+    const long refreshes = argc > 3 ? std::atol(argv[3]) : 0;
+    if (intervalMs <= 0 || refreshes < 0) {
+        std::fprintf(stderr, "Invalid interval or refresh count\n");
+        return 2;
+    }
+
+    try {
+        MetricsReader reader(argv[1]);
+        const MetricsSegment& seg = reader.segment();
+        std::vector<uint64_t> previous(MetricsSegment::MAX_COUNTERS, 0);
+        auto last = std::chrono::steady_clock::now();
+
+        for (long i = 0; refreshes == 0 || i < refreshes; ++i) {
+            if (i > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            }
+            const auto now = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(now - last).count();
+            last = now;
+
+            const double uptime = static_cast<double>(TscClock::now() - seg.startNs) / 1e9;
+            std::printf("== %s (pid %lu, up %.1fs) ==\n", seg.process, static_cast<unsigned long>(seg.pid), uptime);
+            const uint32_t n = reader.size();
+            for (uint32_t m = 0; m < n; ++m) {
+                const MetricDesc& d = reader.desc(m);
+                switch (d.kind) {
+                case MetricKind::COUNTER: {
+                    const uint64_t value = reader.counter(d.index);
+                    const double rate = (i > 0 && seconds > 0) ? static_cast<double>(value - previous[d.index]) / seconds : 0.0;
+                    previous[d.index] = value;
+                    std::printf("counter  %-28s %14lu %12.1f/s\n", d.name, static_cast<unsigned long>(value), rate);
+                    break;
+                }
+                case MetricKind::GAUGE:
+                    std::printf("gauge    %-28s %14ld\n", d.name, static_cast<long>(reader.gauge(d.index)));
+                    break;
+                case MetricKind::HISTOGRAM: {
+                    const HdrHistogram h = reader.histogram(d.index);
+                    std::printf("hist     %-28s n=%lu p50=%luns p90=%luns p99=%luns p99.9=%luns max=%luns\n", d.name,
+                        static_cast<unsigned long>(h.count()), static_cast<unsigned long>(h.percentile(50.0)),
+                        static_cast<unsigned long>(h.percentile(90.0)), static_cast<unsigned long>(h.percentile(99.0)),
+                        static_cast<unsigned long>(h.percentile(99.9)), static_cast<unsigned long>(h.max()));
+                    break;
+                }
+                }
+            }
+            std::fflush(stdout);
+        }
+    }
+    catch (const Engine::EngException& ex) {
+        std::fprintf(stderr, "Cannot read metrics of '%s': %s\n", argv[1], ex.what());
+        return 1;
+    }
+    return 0;
+}
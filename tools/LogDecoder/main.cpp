@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <cstring>
+
+#include "BinaryLog.h"
+
+using namespace Exchange::Core;
+
+/**
+ * @brief Renders a binary log file (see BinaryLogWriter) as the text the logger would
+ * have written: one "[date][LEVEL][func]file:line - message" line per record.
+ *
+ * Usage: log_decoder <file.blog> [min-level]
+ *   min-level: TRACE, DEBUG, INFO, WARNING, ERROR or FATAL (default TRACE)
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "Usage: %s <file.blog> [TRACE|DEBUG|INFO|WARNING|ERROR|FATAL]\n", argv[0]);
+        return 2;
+    }
+
+    LogLevel minLevel = LogLevel::TRACE;
+    if (argc == 3) {
+        bool found = false;
+        for (LogLevel l : {LogLevel::TRACE, LogLevel::DEBUG, LogLevel::INFO,
+                           LogLevel::WARNING, LogLevel::ERROR, LogLevel::FATAL}) {
+            if (std::strcmp(argv[2], LogFormatter::levelName(l)) == 0) {
+                minLevel = l;
+                found = true;
+            }
+        }
+        if (!found) {
+            std::fprintf(stderr, "Unknown level '%s'\n", argv[2]);
+            return 2;
+        }
+    }
+
+    BinaryLogReader reader;
+    if (const char* error = reader.open(argv[1])) {
+        std::fprintf(stderr, "Cannot read '%s': %s\n", argv[1], error);
+        return 1;
+    }
+
+    LogRecord r{};
+    char line[1024];
+    DateCache dates;
+    while (reader.next(r)) {
+        if (r.site->level < minLevel) {
+            continue;
+        }
+        size_t n = LogFormatter::line(r, line, sizeof(line), dates);
+        std::fwrite(line, 1, n, stdout);
+    }
+    return 0;
+}